@@ -78,9 +78,30 @@ THE SOFTWARE.
  * \param [in] cpu_thread_count number of cpu threads
  * \param [in] prefetch_queue_depth The depth of the prefetch queue.
  * \param [in] output_tensor_data_type RocalTensorOutputType: Defines whether the output of rocal tensor is FP32 or FP16.
+ * \param [in] deterministic_loader_order If true the batches of the internal shards of a loader are returned round robin, otherwise the first batch completed by any of them is returned.
+ * \param [in] cpu_affinity CPUs the CPU stages of the pipeline run on, the decode workers are pinned one per CPU. Pipelines with the same CPUs share their workers. Empty for no restriction.
+ * \param [in] numa_node Restricts the pipeline to the CPUs of this NUMA node if cpu_affinity is empty, -1 for no restriction.
  * \return A \ref RocalContext - The context for the pipeline
  */
-extern "C" RocalContext ROCAL_API_CALL rocalCreate(size_t batch_size, RocalProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1, size_t prefetch_queue_depth = 3, RocalTensorOutputType output_tensor_data_type = RocalTensorOutputType::ROCAL_FP32);
+extern "C" RocalContext ROCAL_API_CALL rocalCreate(size_t batch_size, RocalProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1, size_t prefetch_queue_depth = 3, RocalTensorOutputType output_tensor_data_type = RocalTensorOutputType::ROCAL_FP32, bool deterministic_loader_order = false,
+                                                   std::vector<unsigned> cpu_affinity = {}, int numa_node = -1);
+
+/*!
+ * \brief  rocalSetCpuCoreBudget sets the number of CPU worker threads shared by the pipelines running on the same CPUs
+ * \ingroup group_rocal
+ * \param [in] core_budget The number of worker threads, 0 selects the number of physical cores. Applies to the pipelines created afterwards on CPUs no other pipeline uses.
+ * The budget is enforced per CPU set: the pipelines created with the same cpu_affinity (or none) share one pool of core_budget workers,
+ * pipelines pinned to different CPU sets each get their own pool, so the process may run more than core_budget workers in total.
+ */
+extern "C" void ROCAL_API_CALL rocalSetCpuCoreBudget(size_t core_budget);
+
+/*!
+ * \brief  rocalSetIoDepth sets the number of file reads kept in flight by the image loaders of the pipeline
+ * \ingroup group_rocal
+ * \param [in] context Rocal context
+ * \param [in] io_depth The number of concurrent file reads per loader shard, 0 selects twice the cpu thread count and 1 reads the files serially. Applies to the loaders created afterwards.
+ */
+extern "C" void ROCAL_API_CALL rocalSetIoDepth(RocalContext context, size_t io_depth);
 
 /*!
  * \brief  rocalVerify function to verify the graph for all the inputs and outputs
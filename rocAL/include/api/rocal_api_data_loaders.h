@@ -46,6 +46,7 @@ THE SOFTWARE.
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegFileSource(RocalContext context,
@@ -57,7 +58,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegFileSource(RocalContext context,
                                                           bool loop = false,
                                                           RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                           unsigned max_width = 0, unsigned max_height = 0, RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                          RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                          RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                          RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder. It allocates the resources and objects required to read and decode Jpeg images stored on the file systems. It accepts external sharding information to load a singe shard. only
  * \ingroup group_rocal_data_loaders
@@ -75,6 +77,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegFileSource(RocalContext context,
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
 
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegFileSourceSingleShard(RocalContext context,
@@ -87,7 +90,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegFileSourceSingleShard(RocalContex
                                                                      bool loop = false,
                                                                      RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                      unsigned max_width = 0, unsigned max_height = 0, RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                     RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder. Reads [Frames] sequences from a directory representing a collection of streams.
  * \ingroup group_rocal_data_loaders
@@ -158,6 +162,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalSequenceReaderSingleShard(RocalContex
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSource(RocalContext context,
@@ -171,7 +176,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSource(RocalContext conte
                                                               RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                               unsigned max_width = 0, unsigned max_height = 0,
                                                               RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                              RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                              RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                              RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief JPEG image reader and partial decoder. It allocates the resources and objects required to read and decode COCO Jpeg images stored on the file systems. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -188,6 +194,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSource(RocalContext conte
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartial(RocalContext p_context,
@@ -203,7 +210,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartial(RocalContex
                                                                      bool loop = false,
                                                                      RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                      unsigned max_width = 0, unsigned max_height = 0,
-                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                     RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and partial decoder. It allocates the resources and objects required to read and decode COCO Jpeg images stored on the file systems. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -220,6 +228,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartial(RocalContex
  * \param [in] area_factor Determines how much area to be cropped. Ranges from from 0.08 - 1.
  * \param [in] aspect_ratio Determines the aspect ration of crop. Ranges from 0.75 to 1.33.
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartialSingleShard(RocalContext p_context,
@@ -236,7 +245,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartialSingleShard(
                                                                                 bool loop = false,
                                                                                 RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                                 unsigned max_width = 0, unsigned max_height = 0,
-                                                                                RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                                RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                                RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader. It allocates the resources and objects required to read and decode COCO Jpeg images stored on the file systems. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -252,6 +262,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourcePartialSingleShard(
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourceSingleShard(RocalContext context,
@@ -266,7 +277,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourceSingleShard(RocalCo
                                                                          RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                          unsigned max_width = 0, unsigned max_height = 0,
                                                                          RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                         RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder for Caffe LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored in Caffe LMDB Records. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -281,6 +293,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCOCOFileSourceSingleShard(RocalCo
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSource(RocalContext context,
@@ -293,7 +306,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSource(RocalContex
                                                                      RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                      unsigned max_width = 0, unsigned max_height = 0,
                                                                      RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                     RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                     RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder for Caffe LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored in Caffe2 LMDB Records. It has internal sharding capability to load/decode in parallel is user wants.
  * \ingroup group_rocal_data_loaders
@@ -310,6 +324,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSource(RocalContex
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourceSingleShard(RocalContext p_context,
@@ -323,7 +338,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourceSingleShard(
                                                                                 RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                                 unsigned max_width = 0, unsigned max_height = 0,
                                                                                 RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                                RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                                RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                                RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder for Caffe2 LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored in Caffe2 LMDB Records. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -339,6 +355,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourceSingleShard(
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSource(RocalContext context,
@@ -351,7 +368,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSource(RocalConte
                                                                       RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                       unsigned max_width = 0, unsigned max_height = 0,
                                                                       RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                      RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                      RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                      RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder for Caffe2 LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored on the Caffe2 LMDB Records. It accepts external sharding information to load a singe shard. only
  * \ingroup group_rocal_data_loaders
@@ -368,6 +386,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSource(RocalConte
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSourceSingleShard(RocalContext p_context,
@@ -381,7 +400,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSourceSingleShard
                                                                                  RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                                  unsigned max_width = 0, unsigned max_height = 0,
                                                                                  RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                                 RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                                 RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                                 RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and decoder for MXNet records. It allocates the resources and objects required to read and decode Jpeg images stored in MXNet Records. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -457,6 +477,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalMXNetRecordSourceSingleShard(RocalCon
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCrop(RocalContext context,
@@ -471,7 +492,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCrop(RocalContext context,
                                                          bool loop = false,
                                                          RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                          unsigned max_width = 0, unsigned max_height = 0,
-                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                         RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and partial decoder. It allocates the resources and objects required to read and decode Jpeg images stored on the file systems. It accepts external sharding information to load a singe shard. only
  * \ingroup group_rocal_data_loaders
@@ -488,6 +510,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCrop(RocalContext context,
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCropSingleShard(RocalContext context,
@@ -503,7 +526,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCropSingleShard(RocalContext
                                                                     bool loop = false,
                                                                     RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                     unsigned max_width = 0, unsigned max_height = 0,
-                                                                    RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                    RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                    RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates TensorFlow records JPEG image reader and decoder. It allocates the resources and objects required to read and decode Jpeg images stored on the file systems. It has internal sharding capability to load/decode in parallel is user wants. If images are not Jpeg compressed they will be ignored.
  * \ingroup group_rocal_data_loaders
@@ -519,6 +543,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalFusedJpegCropSingleShard(RocalContext
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output image
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegTFRecordSource(RocalContext context,
@@ -533,7 +558,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegTFRecordSource(RocalContext conte
                                                               RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                               unsigned max_width = 0, unsigned max_height = 0,
                                                               RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                              RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                              RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                              RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates TensorFlow records JPEG image reader and decoder. It allocates the resources and objects required to read and decode Jpeg images stored on the file systems. It accepts external sharding information to load a singe shard. only
  * \ingroup group_rocal_data_loaders
@@ -550,6 +576,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegTFRecordSource(RocalContext conte
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type, tjpeg or hwdec
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegTFRecordSourceSingleShard(RocalContext context,
@@ -565,7 +592,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegTFRecordSourceSingleShard(RocalCo
                                                                          RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                          unsigned max_width = 0, unsigned max_height = 0,
                                                                          RocalDecoderType rocal_decoder_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                         RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                         RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates Raw image loader. It allocates the resources and objects required to load images stored on the file systems.
  * \ingroup group_rocal_data_loaders
@@ -631,6 +659,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalRawTFRecordSourceSingleShard(RocalCon
  * \param [in] loop Determines if the user wants to indefinitely loop through images or not.
  * \param [in] seed Determines the seed used by RNG for shuffling data between shards.
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] roi_start First element of the region of interest read from every array, one value per dimension. Empty reads from the start of the arrays.
+ * \param [in] roi_shape Extent of the region of interest read from every array, one value per dimension, 0 reads up to the end of the dimension. Empty reads the whole arrays. The region is clamped to the bounds of each array and only its rows are read from the disk. One region is shared by all the samples of the pipeline, the files of a batch are picked by the loader so a region per sample is not supported.
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalNumpyFileSource(RocalContext context,
@@ -642,7 +672,9 @@ extern "C" RocalTensor ROCAL_API_CALL rocalNumpyFileSource(RocalContext context,
                                                            bool shuffle = false,
                                                            bool loop = false,
                                                            unsigned seed = 0,
-                                                           RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                           RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                           std::vector<unsigned> roi_start = {},
+                                                           std::vector<unsigned> roi_shape = {});
 
 /*! \brief Creates Numpy raw data reader and loader. It allocates the resources and objects required to read raw data stored on the numpy arrays.
  * \ingroup group_rocal_data_loaders
@@ -657,6 +689,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalNumpyFileSource(RocalContext context,
  * \param [in] shard_count Total shard count
  * \param [in] seed Determines the seed used by RNG for shuffling data between shards.
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] roi_start First element of the region of interest read from every array, one value per dimension. Empty reads from the start of the arrays.
+ * \param [in] roi_shape Extent of the region of interest read from every array, one value per dimension, 0 reads up to the end of the dimension. Empty reads the whole arrays. The region is clamped to the bounds of each array and only its rows are read from the disk. One region is shared by all the samples of the pipeline, the files of a batch are picked by the loader so a region per sample is not supported.
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor rocalNumpyFileSourceSingleShard(RocalContext context,
@@ -669,7 +703,9 @@ extern "C" RocalTensor rocalNumpyFileSourceSingleShard(RocalContext context,
                                                        unsigned shard_id = 0,
                                                        unsigned shard_count = 1,
                                                        unsigned seed = 0,
-                                                       RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                       RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                       std::vector<unsigned> roi_start = {},
+                                                       std::vector<unsigned> roi_shape = {});
 
 /*!
  * \brief Creates a video reader and decoder as a source. It allocates the resources and objects required to read and decode mp4 videos stored on the file systems.
@@ -896,6 +932,7 @@ extern "C" RocalStatus ROCAL_API_CALL rocalResetLoaders(RocalContext context);
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourcePartialSingleShard(RocalContext p_context,
@@ -911,7 +948,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourcePartialSingl
                                                                                        bool loop = false,
                                                                                        RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                                        unsigned max_width = 0, unsigned max_height = 0,
-                                                                                       RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                                       RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                                       RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 
 /*! \brief Creates JPEG image reader and partial decoder for Caffe2 LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored in Caffe22 LMDB Records. It has internal sharding capability to load/decode in parallel is user wants.
  * \ingroup group_rocal_data_loaders
@@ -927,6 +965,7 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffeLMDBRecordSourcePartialSingl
  * \param [in] max_width The maximum width of the decoded images, larger or smaller will be resized to closest
  * \param [in] max_height The maximum height of the decoded images, larger or smaller will be resized to closest
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] decode_quality Determines the IDCT and upsampling accuracy of the TurboJPEG decoders, ROCAL_DECODE_QUALITY_FAST_SCALED also lets them decode in the DCT domain down to the output size of the resize augmentations fed by this loader
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSourcePartialSingleShard(RocalContext p_context,
@@ -942,7 +981,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalJpegCaffe2LMDBRecordSourcePartialSing
                                                                                         bool loop = false,
                                                                                         RocalImageSizeEvaluationPolicy decode_size_policy = ROCAL_USE_MOST_FREQUENT_SIZE,
                                                                                         unsigned max_width = 0, unsigned max_height = 0,
-                                                                                        RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                                        RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                                        RocalDecodeQuality decode_quality = ROCAL_DECODE_QUALITY_ACCURATE);
 /*! \brief Creates JPEG external source image reader.
  * \ingroup group_rocal_data_loaders
  * \param [in] rocal_context Rocal context
@@ -1044,6 +1084,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalAudioFileSourceSingleShard(RocalConte
  * \param [in] max_height The maximum height of the decoded image files, larger or smaller will be resized to closest
  * \param [in] rocal_decoder_type Determines the decoder_type - image / video / audio
  * \param [in] rocal_sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
+ * \param [in] shuffle_buffer_size 0 reads every sample at its offset in the tar files. A positive value streams the tar files sequentially with read-ahead, and when shuffle is set the samples are shuffled within a window of this many samples instead of over the whole shard.
+ * \param [in] max_open_files Number of tar files kept open at once, the least recently used one is closed beyond it. 0 keeps up to 256 open.
  * \return Reference to the output tensor
  */
 extern "C" RocalTensor ROCAL_API_CALL rocalWebDatasetSourceSingleShard(RocalContext p_context,
@@ -1059,6 +1101,8 @@ extern "C" RocalTensor ROCAL_API_CALL rocalWebDatasetSourceSingleShard(RocalCont
                                                                         unsigned max_width = 0,
                                                                         unsigned max_height = 0,
                                                                         RocalDecoderType dec_type = RocalDecoderType::ROCAL_DECODER_TJPEG,
-                                                                        RocalShardingInfo rocal_sharding_info = RocalShardingInfo());
+                                                                        RocalShardingInfo rocal_sharding_info = RocalShardingInfo(),
+                                                                        unsigned shuffle_buffer_size = 0,
+                                                                        unsigned max_open_files = 0);
                                                  
 #endif  // MIVISIONX_ROCAL_API_DATA_LOADERS_H
@@ -82,6 +82,26 @@ extern "C" void ROCAL_API_CALL rocalSetOutputs(RocalContext p_context, unsigned
  */
 extern "C" RocalTensorList ROCAL_API_CALL rocalGetOutputTensors(RocalContext p_context);
 
+/*!
+ * \brief Registers user owned buffers the pipeline writes one of its outputs into, removing the copy of rocalToTensor / rocalCopyToOutput
+ * \ingroup group_rocal_data_transfer
+ * \param [in] p_context Rocal context
+ * \param [in] output_index index of the output in the list passed to rocalSetOutputs
+ * \param [in] buffers one buffer per prefetch queue slot, in host memory for CPU pipelines and device memory for GPU pipelines
+ * \param [in] buffer_size size in bytes of each buffer, at least the size of the output tensor
+ * \return Rocal status indicating success or failure
+ * \note Has to be called after rocalSetOutputs and before rocalVerify. The buffers are written in the layout and data type of the output tensor and must stay allocated until rocalRelease
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetOutputBuffers(RocalContext p_context, unsigned int output_index, const std::vector<void *> &buffers, size_t buffer_size);
+
+/*!
+ * \brief Gives the index of the registered output buffer holding the batch of the last rocalRun
+ * \ingroup group_rocal_data_transfer
+ * \param [in] p_context Rocal context
+ * \return Index in the buffers passed to rocalSetOutputBuffers, -1 if no batch is ready. The buffer is rewritten once the next rocalRun is called
+ */
+extern "C" int ROCAL_API_CALL rocalGetOutputBufferIndex(RocalContext p_context);
+
 /*!
  * \brief Creates ExternalSourceFeedInput for data transfer
  * \ingroup group_rocal_data_transfer
@@ -113,4 +113,12 @@ extern "C" TimingInfo ROCAL_API_CALL rocalGetTimingInfo(RocalContext rocal_conte
  */
 extern "C" size_t ROCAL_API_CALL rocalGetLastBatchPaddedSize(RocalContext rocal_context);
 
+/*!
+ * \brief Retrieves the instruction set level of the SIMD kernels used on the CPU.
+ * \ingroup group_rocal_info
+ * \param [in] rocal_context The RocalContext, can be null as the level is shared by the whole process
+ * \return The highest level supported by the CPU, or the lower level requested with the ROCAL_CPU_ISA environment variable (scalar, sse4.2, avx2 or avx512).
+ */
+extern "C" RocalCpuIsa ROCAL_API_CALL rocalGetCpuIsa(RocalContext rocal_context);
+
 #endif  // MIVISIONX_ROCAL_API_INFO_H
@@ -210,6 +210,15 @@ extern "C" RocalTensorList ROCAL_API_CALL rocalGetBoundingBoxLabel(RocalContext
  */
 extern "C" RocalTensorList ROCAL_API_CALL rocalGetBoundingBoxCords(RocalContext rocal_context);
 
+/*! \brief Gives one metadata buffer of the batch with the samples collated in it, instead of one tensor per sample
+ * \ingroup group_rocal_meta_data
+ * \param [in] rocal_context rocal context
+ * \param [in] meta_data_buffer a \ref RocalMetaDataBuffer, or the component index for the WebDataset reader
+ * \param [out] collated_meta_data the buffer and the offsets of the samples in it, counted in labels, boxes, mask coordinates or bytes
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalGetCollatedMetaData(RocalContext rocal_context, unsigned meta_data_buffer, RocalCollatedMetaData* collated_meta_data);
+
 /*! \brief get image sizes
  * \ingroup group_rocal_meta_data
  * \param [in] rocal_context rocal context
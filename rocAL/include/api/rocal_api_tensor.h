@@ -22,6 +22,8 @@ THE SOFTWARE.
 
 #ifndef MIVISIONX_ROCAL_API_TENSOR_H
 #define MIVISIONX_ROCAL_API_TENSOR_H
+#include <memory>
+
 #include "rocal_api_types.h"
 
 /*!
@@ -58,6 +60,16 @@ class rocalTensor {
     virtual void set_mem_handle(void* buffer) = 0;
     virtual void set_tensor_layout(RocalTensorLayout layout) = 0;
     virtual uint64_t data_type_size() = 0;
+    //! Packed image tensors are copied out with the ROI of each sample stored back to back instead of in a max sized slot, only NHWC and NCHW image tensors can be packed
+    //! Packing is a layout of the copy_data() destination only, the memory held by the pipeline is unchanged: the loader and ring buffer slots, buffer(), rocalToTensor
+    //! and the buffers registered with rocalSetOutputBuffers keep the max shape slots, the DLPack export of a packed tensor is refused and the OpenCL queue copy throws
+    virtual void set_packed(bool packed) = 0;
+    virtual bool is_packed() = 0;
+    //! Byte offset of each sample in the buffer filled by copy_data(), followed by the total number of bytes of the batch
+    virtual std::vector<size_t> sample_offsets() = 0;
+    //! Keeps the pipeline from overwriting buffer() until the returned handle is released, so that it can be used without a copy after the next rocalRun()
+    //! Null if the tensor is not a pipeline output. The pipeline blocks instead of overwriting a leased buffer, the leases held at once have to stay below the prefetch queue depth
+    virtual std::shared_ptr<void> lease() = 0;
 };
 
 /*!
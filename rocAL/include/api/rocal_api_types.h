@@ -81,6 +81,15 @@ struct TimingInfo {
     long long unsigned decode_time;
     long long unsigned process_time;
     long long unsigned transfer_time;
+    long long unsigned compressed_buffer_size;  //!< Bytes held by the loaders for the compressed files of a batch
+    long long unsigned peak_rss;                //!< Peak resident set size of the process in bytes
+    long long unsigned file_read_time;          //!< Time the I/O workers of the image loaders spent reading files, overlaps with decode_time
+    long long unsigned read_wait_time;          //!< Time the decode threads of the image loaders waited for a file read to complete
+    long long unsigned box_encode_stall_time;   //!< Time the processing thread was blocked because the CPU box encode stage was full
+    long long unsigned box_encode_idle_time;    //!< Time the CPU box encode stage waited for a processed batch
+    long long unsigned box_encode_max_occupancy;  //!< Highest number of batches queued for the CPU box encode stage
+    long long unsigned box_encode_occupancy_sum;  //!< Sum of the number of batches queued for the CPU box encode stage, sampled once per batch
+    long long unsigned box_encode_batches;        //!< Number of batches that went through the CPU box encode stage, box_encode_occupancy_sum / box_encode_batches is the average occupancy
 };
 
 // HRNet training expects meta data (joints_data) in below format, so added here as a type for exposing to user
@@ -294,6 +303,46 @@ enum RocalDecoderType {
     ROCAL_DECODER_ROCJPEG = 5
 };
 
+/*! \brief rocAL CPU instruction set level enum, each level includes the previous ones
+ * \ingroup group_rocal_types
+ */
+enum RocalCpuIsa {
+    /*! \brief AMD ROCAL_CPU_ISA_SCALAR
+     * Scalar code only
+     */
+    ROCAL_CPU_ISA_SCALAR = 0,
+    /*! \brief AMD ROCAL_CPU_ISA_SSE42
+     * SSE4.2 kernels
+     */
+    ROCAL_CPU_ISA_SSE42 = 1,
+    /*! \brief AMD ROCAL_CPU_ISA_AVX2
+     * AVX2, FMA and F16C kernels
+     */
+    ROCAL_CPU_ISA_AVX2 = 2,
+    /*! \brief AMD ROCAL_CPU_ISA_AVX512
+     * AVX-512 kernels
+     */
+    ROCAL_CPU_ISA_AVX512 = 3
+};
+
+/*! \brief rocAL JPEG decode quality enum, applies to the TurboJPEG decoders
+ * \ingroup group_rocal_types
+ */
+enum RocalDecodeQuality {
+    /*! \brief AMD ROCAL_DECODE_QUALITY_ACCURATE
+     * Accurate integer IDCT and chroma upsampling
+     */
+    ROCAL_DECODE_QUALITY_ACCURATE = 0,
+    /*! \brief AMD ROCAL_DECODE_QUALITY_FAST
+     * Fast integer IDCT and chroma upsampling, at a small loss of accuracy
+     */
+    ROCAL_DECODE_QUALITY_FAST = 1,
+    /*! \brief AMD ROCAL_DECODE_QUALITY_FAST_SCALED
+     * Fast decoding, the images feeding resize augmentations only are also downscaled in the DCT domain as long as they stay larger than the resize output
+     */
+    ROCAL_DECODE_QUALITY_FAST_SCALED = 2
+};
+
 enum RocalOutputMemType {
     /*! \brief AMD ROCAL_MEMCPY_HOST
      */
@@ -509,6 +558,30 @@ enum RocalMissingComponentsBehaviour {
     ROCAL_MISSING_COMPONENT_EMPTY = 2
 };
 
+/*! \brief Metadata buffers of a batch, the WebDataset reader has one buffer per component instead
+ *  \ingroup group_rocal_types
+ */
+enum RocalMetaDataBuffer {
+    /*! \brief ROCAL_META_DATA_LABELS - int labels, one per object for the detection readers
+     */
+    ROCAL_META_DATA_LABELS = 0,
+    /*! \brief ROCAL_META_DATA_BOUNDING_BOXES - float boxes, four coordinates per object
+     */
+    ROCAL_META_DATA_BOUNDING_BOXES = 1,
+    /*! \brief ROCAL_META_DATA_MASKS - float polygon coordinates of the masks
+     */
+    ROCAL_META_DATA_MASKS = 2
+};
+
+/*! \brief Metadata of all the samples of a batch back to back in one buffer
+ *  \ingroup group_rocal_types
+ */
+struct RocalCollatedMetaData {
+    void *data;             //!< Entries of the samples back to back, valid until the next rocalRun
+    const size_t *offsets;  //!< batch_size + 1 offsets, sample i holds the entries [offsets[i], offsets[i + 1]) of data
+    size_t batch_size;
+};
+
 struct CameraMatrix {
     float fx;
     float cx;
@@ -50,6 +50,12 @@ enum class DecoderType {
     ROCJPEG_DEC = 7             //!< rocJpeg hardware decoder for decoding jpeg files
 };
 
+enum class DecodeQuality {
+    ACCURATE = 0,     //!< Accurate IDCT and chroma upsampling
+    FAST = 1,         //!< Fast IDCT and chroma upsampling
+    FAST_SCALED = 2   //!< Fast decoding, downscaled in the DCT domain down to the size hint of the decoder config
+};
+
 class DecoderConfig {
    public:
     DecoderConfig() {}
@@ -64,6 +70,15 @@ class DecoderConfig {
     unsigned get_num_attempts() { return _num_attempts; }
     void set_seed(int seed) { _seed = seed; }
     int get_seed() { return _seed; }
+    void set_decode_quality(DecodeQuality decode_quality) { _decode_quality = decode_quality; }
+    DecodeQuality get_decode_quality() { return _decode_quality; }
+    //! Smallest size the decoded images are used at, DecodeQuality::FAST_SCALED does not scale them below it. 0 disables the scaling
+    void set_decode_size_hint(size_t width, size_t height) {
+        _decode_width_hint = width;
+        _decode_height_hint = height;
+    }
+    size_t get_decode_width_hint() { return _decode_width_hint; }
+    size_t get_decode_height_hint() { return _decode_height_hint; }
 #if ENABLE_HIP
     hipStream_t &get_hip_stream() { return _hip_stream; }
     void set_hip_stream(hipStream_t &stream) { _hip_stream = stream; }
@@ -73,6 +88,8 @@ class DecoderConfig {
     std::vector<float> _random_area, _random_aspect_ratio;
     unsigned _num_attempts = 10;
     int _seed = std::time(0);  // seed for decoder random crop
+    DecodeQuality _decode_quality = DecodeQuality::ACCURATE;
+    size_t _decode_width_hint = 0, _decode_height_hint = 0;
 #if ENABLE_HIP
     hipStream_t _hip_stream;
 #endif
@@ -63,6 +63,9 @@ class TJDecoder : public Decoder {
     std::vector<float> get_bbox_coords() override { return _bbox_coord; }
 
    private:
+    //! Picks the smallest DCT scaling factor keeping the decoded image at least as large as the hint, or the default size if smaller
+    void dct_scaled_size(size_t original_width, size_t original_height, size_t max_width, size_t max_height,
+                         size_t hint_width, size_t hint_height, size_t &decode_width, size_t &decode_height);
     tjhandle m_jpegDecompressor;
     tjscalingfactor *_scaling_factors = nullptr;
     int _num_scaling_factors = 0;
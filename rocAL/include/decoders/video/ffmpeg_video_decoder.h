@@ -36,6 +36,10 @@ class FFmpegVideoDecoder : public VideoDecoder {
     ~FFmpegVideoDecoder() override;
 
    private:
+    //! Collects the timestamps of the keyframes of the video stream from the demuxer index, empty if the container has no index
+    void build_keyframe_index();
+    //! Returns true if the frames up to select_frame_pts are cheaper to reach by decoding on from the current position than by seeking
+    bool can_continue_to(int64_t select_frame_pts, size_t sequence_frames) const;
     const char *_src_filename = NULL;
     AVFormatContext *_fmt_ctx = NULL;
     AVCodecContext *_video_dec_ctx = NULL;
@@ -48,5 +52,11 @@ class FFmpegVideoDecoder : public VideoDecoder {
     int _video_stream_idx = -1;
     AVPixelFormat _dec_pix_fmt;
     int _codec_width, _codec_height;
+    SwsContext *_sws_ctx = nullptr;            // Conversion context kept across sequences, only rebuilt when the output format changes
+    AVFrame *_dec_frame = nullptr;
+    std::vector<int64_t> _keyframe_pts;        // Sorted timestamps of the keyframes of the video stream, from the demuxer index
+    int64_t _frame_duration = 1;               // Duration of a frame in the stream time base
+    int64_t _last_pts = AV_NOPTS_VALUE;        // Pts of the last frame received from the decoder
+    bool _decoder_positioned = false;          // True if the decoder can keep decoding from _last_pts without a seek and a flush
 };
 #endif
@@ -24,10 +24,12 @@ THE SOFTWARE.
 #include <fstream>
 #include <memory>
 #include <string>
-#include <libtar.h>
+#include <vector>
 
-constexpr size_t kBlockSize = T_BLOCKSIZE;
-// Refactor TarArchive to use std::ifstream
+#include "readers/image/image_reader.h"
+
+constexpr size_t kBlockSize = 512;
+// Reads the headers of a tar file from a std::ifstream, the ustar and GNU formats are parsed natively including the long name extensions
 class TarArchive {
 public:
     TarArchive() = default;
@@ -64,16 +66,26 @@ public:
 
 private:
     std::unique_ptr<std::ifstream> _stream; // Using std::ifstream directly
-    int _instance_handle = -1;
-    void* _handle = nullptr;
-    friend ssize_t read_tar_archive(int, void *, size_t);
     std::string _filename;
     size_t _filesize = 0;
     EntryType _filetype = ENTRY_NONE;
     size_t _readoffset = 0;
     int64_t _current_header = 0;
+    int64_t _data_offset = 0;  // Offset of the current entry data, past its header and the extension headers preceding it
     bool _eof = true;
     void mark_end_of_file();
     void parse_current_header();
+    bool read_block(int64_t offset, char *block);
+    std::string read_extension_data(int64_t offset, size_t size);
 };
+
+//! Lists the components of the tar file, the consecutive components sharing a base name form a sample
+void parse_tar_file(const std::string &tar_path,
+                    std::vector<SampleDescription> &samples_container,
+                    std::vector<ComponentDescription> &components_container);
+
+//! Reads the samples of a tar file from its index file, as written by tools/tar2idx.py
+void parse_index_file(const std::string &index_path,
+                      std::vector<SampleDescription> &samples_container,
+                      std::vector<ComponentDescription> &components_container);
 #endif
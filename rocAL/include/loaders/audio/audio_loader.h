@@ -49,6 +49,7 @@ class AudioLoader : public LoaderModule {
     std::vector<std::string> get_id() override;
     DecodedDataInfo get_decode_data_info() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
     void set_gpu_device_id(int device_id);
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char*>& input_buffer,
@@ -63,6 +64,7 @@ class AudioLoader : public LoaderModule {
     LoaderModuleStatus update_output_audio();
     LoaderModuleStatus load_routine();
     std::shared_ptr<AudioReadAndDecode> _audio_loader;
+    std::shared_ptr<ThreadPool> _decode_pool;
     Tensor* _output_tensor;
     std::vector<std::string> _output_names; // audio file name/ids that are stored in the _output_audio
     bool _internal_thread_running;
@@ -41,6 +41,7 @@ class AudioLoaderSharded : public LoaderModule {
     DecodedDataInfo get_decode_data_info() override;
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char*>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, 
@@ -57,5 +58,6 @@ class AudioLoaderSharded : public LoaderModule {
     size_t _shard_count = 1;
     size_t _prefetch_queue_depth = 0;
     Tensor* _output_tensor = nullptr;
+    std::shared_ptr<ThreadPool> _decode_pool;
 };
 #endif
@@ -65,6 +65,7 @@ class AudioReadAndDecode {
     // returns timing info or other status information
     Timing GetTiming();
     size_t last_batch_padded_size(); // The number of padded samples in the last batch
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) { _decode_pool = std::move(decode_pool); }  // Decodes the batches on the given pool instead of an OpenMP team
 
    private:
     std::vector<std::shared_ptr<AudioDecoder>> _decoder;
@@ -74,5 +75,6 @@ class AudioReadAndDecode {
     TimingDbg _file_load_time, _decode_time;
     size_t _batch_size, _num_threads;
     DecoderConfig _decoder_config;
+    std::shared_ptr<ThreadPool> _decode_pool;  // Pool shared with the other loaders, null when an OpenMP team of _num_threads decodes the batch
 };
 #endif
@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #pragma once
 #include <condition_variable>
+#include <functional>
 #include <vector>
 #if ENABLE_OPENCL
 #include <CL/cl.h>
@@ -54,7 +55,9 @@ class CircularBuffer {
     void release();         // release resources
     void sync();            // Syncs device buffers with host
     void unblock_reader();  // Unblocks the thread currently waiting on a call to get_read_buffer
-    void unblock_writer();  // Unblocks the thread currently waiting on get_write_buffer
+    void unblock_writer();  // Unblocks the thread currently waiting on get_write_buffer or wait_for_new_data
+    void wait_for_new_data();  // blocks the writer thread, when its source is out of data, until notify_new_data() or unblock_writer() is called
+    void notify_new_data();    // Wakes up the writer thread waiting in wait_for_new_data, called when the source has data to load again
     void push();            // The latest write goes through, effectively adds one element to the buffer
     void pop();             // The oldest write will be erased and overwritten in upcoming writes
     void set_decoded_data_info(const DecodedDataInfo& info) { _last_data_info = info; }
@@ -69,6 +72,7 @@ class CircularBuffer {
     void reset();                           // sets the buffer level to 0
     void block_if_empty();                  // blocks the caller if the buffer is empty
     void block_if_full();                   // blocks the caller if the buffer is full
+    void set_push_callback(std::function<void()> callback) { _push_callback = std::move(callback); }  // Called after every push and when the reader is unblocked, lets a consumer wait on several buffers at once
 
    private:
     void increment_read_ptr();
@@ -93,7 +97,10 @@ class CircularBuffer {
     std::vector<unsigned char*> _host_buffer_ptrs;
     std::condition_variable _wait_for_load;
     std::condition_variable _wait_for_unload;
+    std::condition_variable _wait_for_new_data;
+    std::function<void()> _push_callback;
     std::mutex _lock;
+    bool _new_data_available = false;
     RocalMemType _output_mem_type;
     size_t _output_mem_size;
     bool _initialized = false;
@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*! \brief Bump allocator for the compressed payloads of a batch
+ *
+ * The payloads of a batch are allocated back to back and released all at once by reset() when the next batch starts,
+ * so batch slots substituted for a failed decode simply point at the payload of another slot.
+ * Chunks are only added while a batch outgrows the arena, reset() then merges them into one chunk sized to the bytes the batch needed,
+ * which keeps the memory held proportional to the actual file sizes instead of a fixed maximum per slot.
+ */
+class CompressedBufferArena {
+   public:
+    //! Returns a buffer of size bytes valid until the next reset(), can be called concurrently
+    unsigned char *allocate(size_t size);
+    //! Releases all the buffers handed out since the previous reset()
+    void reset();
+    //! Returns the number of bytes currently held by the arena
+    size_t capacity();
+
+   private:
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+    void add_chunk(size_t size);
+    std::mutex _lock;
+    std::vector<Chunk> _chunks;  // Allocations are served from the last chunk
+    size_t _offset = 0;          // First free byte of the last chunk
+    size_t _batch_bytes = 0;     // Bytes allocated since the last reset()
+    size_t _capacity = 0;
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+};
@@ -46,6 +46,12 @@ class ImageLoader : public LoaderModule {
     Timing timing() override;
     void start_loading() override;
     void set_gpu_device_id(int device_id);
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
+    void set_decode_quality(DecodeQuality decode_quality) override;
+    void set_io_depth(size_t io_depth) override;
+    void set_decode_size_hint(size_t width, size_t height) override;
+    void set_ready_callback(std::function<void()> callback);        // callback is invoked whenever load_next() may have become non-blocking
+    bool is_ready();                                                 // Returns true if load_next() would return without blocking
     std::vector<std::string> get_id() override;
     DecodedDataInfo get_decode_data_info() override;
     CropImageInfo get_crop_image_info() override;
@@ -60,6 +66,10 @@ class ImageLoader : public LoaderModule {
     void de_init();
     void stop_internal_thread();
     std::shared_ptr<ImageReadAndDecode> _image_loader;
+    std::shared_ptr<ThreadPool> _decode_pool;
+    DecodeQuality _decode_quality = DecodeQuality::ACCURATE;
+    size_t _io_depth = 0;
+    size_t _decode_width_hint = 0, _decode_height_hint = 0;
     LoaderModuleStatus update_output_image();
     LoaderModuleStatus load_routine();
 
@@ -21,12 +21,16 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 #include "image_loader.h"
 //
 // ImageLoaderSharded Can be used to run load and decode in multiple shards, each shard by a single loader instance,
 // It improves load and decode performance since each loader loads the images in parallel using an internal thread
+// By default load_next() returns the first batch any of the loaders completes, deterministic ordering visits the loaders round robin instead
+// The loaders decode on one pool shared between them, the one of the pipeline or if none is set one sized to the threads all of them would otherwise run
 //
 class ImageLoaderSharded : public LoaderModule {
    public:
@@ -44,6 +48,11 @@ class ImageLoaderSharded : public LoaderModule {
     CropImageInfo get_crop_image_info() override;
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_deterministic_order(bool deterministic_order) override;
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
+    void set_decode_quality(DecodeQuality decode_quality) override;
+    void set_io_depth(size_t io_depth) override;
+    void set_decode_size_hint(size_t width, size_t height) override;
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos) override;
@@ -57,7 +66,17 @@ class ImageLoaderSharded : public LoaderModule {
     size_t _loader_idx;
     size_t _shard_count = 1;
     void fast_forward_through_empty_loaders();
+    //! Blocks until one of the loaders holding data has a batch ready, and makes it the current loader
+    void wait_for_ready_loader();
+    void notify_ready();
     size_t _prefetch_queue_depth;
+    bool _deterministic_order = false;  // If true the batches are returned round robin from the loaders, regardless of which one completes first
+    bool _stopped = false;
+    std::mutex _ready_lock;
+    std::condition_variable _ready_cv;  // Signalled whenever one of the loaders pushes a batch
+    std::shared_ptr<ThreadPool> _decode_pool;
+    DecodeQuality _decode_quality = DecodeQuality::ACCURATE;
+    size_t _io_depth = 0;
 
     Tensor *_output_tensor;
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
@@ -23,14 +23,18 @@ THE SOFTWARE.
 #pragma once
 #include <dirent.h>
 
+#include <atomic>
+#include <future>
 #include <memory>
 #include <vector>
 
 #include "pipeline/commons.h"
+#include "loaders/compressed_buffer_arena.h"
 #include "loaders/loader_module.h"
 #include "parameters/parameter_random_crop_decoder.h"
 #include "readers/image/reader_factory.h"
 #include "pipeline/timing_debug.h"
+#include "pipeline/thread_pool.h"
 #include "decoders/image/turbo_jpeg_decoder.h"
 
 
@@ -45,6 +49,13 @@ class ImageReadAndDecode {
     void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader);
     std::vector<std::vector<float>> &get_batch_random_bbox_crop_coords();
     void set_batch_random_bbox_crop_coords(std::vector<std::vector<float>> batch_crop_coords);
+    //! Decodes the samples of a batch on the given pool instead of an OpenMP team of its own, used to share the workers between loaders and pipelines
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) { _decode_pool = std::move(decode_pool); }
+    //! Size the decoded images are used at, can be changed while loading and applies from the next batch on
+    void set_decode_size_hint(size_t width, size_t height) {
+        _decode_width_hint = width;
+        _decode_height_hint = height;
+    }
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos);
     //! Loads a decompressed batch of images into the buffer indicated by buff
@@ -72,10 +83,15 @@ class ImageReadAndDecode {
     size_t last_batch_padded_size();
 
    private:
+    //! Reads the whole file into a compressed buffer of the batch slot idx, called from the I/O workers
+    void read_file(const std::string &file_path, size_t idx);
+    //! Blocks the caller until the read of the batch slot idx issued on the I/O workers is complete
+    void wait_for_read(size_t idx);
     std::vector<std::shared_ptr<Decoder>> _decoder;
     std::shared_ptr<Decoder> _rocjpeg_decoder;
     std::shared_ptr<Reader> _reader;
-    std::vector<std::vector<unsigned char>> _compressed_buff;
+    CompressedBufferArena _compressed_arena;        // Holds the compressed files of the batch being loaded
+    std::vector<unsigned char *> _compressed_data;  // Compressed data of each batch slot, either in _compressed_arena or a pointer into the reader mapping
     std::vector<size_t> _actual_read_size;
     std::vector<std::string> _image_names;
     std::vector<size_t> _compressed_image_size;
@@ -84,7 +100,6 @@ class ImageReadAndDecode {
     std::vector<size_t> _actual_decoded_height;
     std::vector<size_t> _original_width;
     std::vector<size_t> _original_height;
-    static const size_t MAX_COMPRESSED_SIZE = 1 * 1024 * 1024;  // 1 Meg
     TimingDbg _file_load_time, _decode_time;
     size_t _batch_size, _num_threads;
     DecoderConfig _decoder_config;
@@ -95,4 +110,9 @@ class ImageReadAndDecode {
     bool _is_external_source = false;
     int _device_id = 0;
     bool _set_device_id = false;
+    std::shared_ptr<ThreadPool> _decode_pool;          // Pool shared with the other loaders, null when an OpenMP team of _num_threads decodes the batch
+    std::unique_ptr<ThreadPool> _io_pool;              // Keeps the file reads of a batch in flight, null when files are read serially
+    std::vector<std::shared_future<void>> _read_done;  // Signalled once the read of the corresponding batch slot completes
+    std::atomic<unsigned long long> _file_read_time_us{0}, _read_wait_time_us{0};
+    std::atomic<size_t> _decode_width_hint{0}, _decode_height_hint{0};
 };
@@ -31,6 +31,7 @@ class NumpyLoaderNode : public Node {
     NumpyLoaderNode() = delete;
 
     /// \param internal_shard_count Defines the amount of parallelism user wants for the load and decode process to be handled internally.
+    /// \param cpu_num_threads Number of threads reading the arrays of a batch concurrently in each shard
     /// \param source_path Defines the path that includes the numpy files on disk
     /// \param files Contains a list of file paths to read the data from.
     /// \param storage_type Determines the storage type
@@ -41,8 +42,11 @@ class NumpyLoaderNode : public Node {
     /// \param mem_type Memory type, host or device
     /// \param seed Determines the seed used by RNG for shuffling data between shards.
     /// \param sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
-    void init(unsigned internal_shard_count, const std::string &source_path, const std::vector<std::string> &files, StorageType storage_type, DecoderType decoder_type, bool shuffle, bool loop,
-              size_t load_batch_count, RocalMemType mem_type, unsigned seed = 0, const ShardingInfo& sharding_info = ShardingInfo());
+    /// \param roi_start First element of the region read from every array, empty reads from the start of the arrays
+    /// \param roi_shape Extent of the region read from every array, empty or 0 reads up to the end of the dimension
+    void init(unsigned internal_shard_count, unsigned cpu_num_threads, const std::string &source_path, const std::vector<std::string> &files, StorageType storage_type, DecoderType decoder_type, bool shuffle, bool loop,
+              size_t load_batch_count, RocalMemType mem_type, unsigned seed = 0, const ShardingInfo& sharding_info = ShardingInfo(),
+              const std::vector<unsigned> &roi_start = {}, const std::vector<unsigned> &roi_shape = {});
     std::shared_ptr<LoaderModule> get_loader_module();
 
    protected:
@@ -31,6 +31,7 @@ class NumpyLoaderSingleShardNode : public Node {
 
     /// \param shard_id shard id from user
     /// \param shard_count shard count from user
+    /// \param cpu_num_threads Number of threads reading the arrays of a batch concurrently
     /// \param source_path Defines the path that includes the numpy dataset
     /// \param files Contains a list of file paths to read the data from.
     /// \param storage_type Determines the storage type
@@ -41,9 +42,12 @@ class NumpyLoaderSingleShardNode : public Node {
     /// \param mem_type Memory type, host or device
     /// \param seed Determines the seed used by RNG for shuffling data between shards.
     /// \param sharding_info The members of RocalShardingInfo determines how the data is distributed among the shards and how the last batch is processed by the pipeline.
-    void init(unsigned shard_id, unsigned shard_count, const std::string &source_path, const std::vector<std::string> &files,
+    /// \param roi_start First element of the region read from every array, empty reads from the start of the arrays
+    /// \param roi_shape Extent of the region read from every array, empty or 0 reads up to the end of the dimension
+    void init(unsigned shard_id, unsigned shard_count, unsigned cpu_num_threads, const std::string &source_path, const std::vector<std::string> &files,
               StorageType storage_type, DecoderType decoder_type, bool shuffle, bool loop,
-              size_t load_batch_count, RocalMemType mem_type, unsigned seed = 0, const ShardingInfo& sharding_info = ShardingInfo());
+              size_t load_batch_count, RocalMemType mem_type, unsigned seed = 0, const ShardingInfo& sharding_info = ShardingInfo(),
+              const std::vector<unsigned> &roi_start = {}, const std::vector<unsigned> &roi_shape = {});
     std::shared_ptr<LoaderModule> get_loader_module();
 
    protected:
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "image_read_and_decode.h"
 #include "loaders/circular_buffer.h"
 #include "pipeline/commons.h"
+#include "pipeline/thread_pool.h"
 
 // NumpyLoader runs an internal thread for loading numpy arrays asynchronously
 // it uses a circular buffer to store decoded numpy arrays for the user
@@ -47,6 +48,7 @@ class NumpyLoader : public LoaderModule {
     std::vector<std::string> get_id() override;
     DecodedDataInfo get_decode_data_info() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char*>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos) override {
@@ -81,4 +83,10 @@ class NumpyLoader : public LoaderModule {
     size_t _remaining_file_count;  //!< How many numpy files are there yet to be loaded
     int _device_id;
     std::vector<std::vector<unsigned>> _tensor_roi;
+    std::vector<unsigned> _roi_start, _roi_shape;           //!< Region read from every array, empty reads the whole arrays
+    std::vector<std::string> _sample_path;                  //!< File path of each batch slot
+    std::vector<NumpyHeaderData> _sample_header;            //!< Numpy header of each batch slot
+    std::vector<std::vector<unsigned>> _sample_start, _sample_extent;  //!< Region of each batch slot clamped to its array
+    std::shared_ptr<ThreadPool> _read_pool;                 //!< Pool shared with the other loaders the arrays of a batch are read on, null when they are read serially
+    size_t _read_threads = 1;                               //!< Number of arrays of a batch read concurrently
 };
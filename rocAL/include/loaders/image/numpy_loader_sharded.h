@@ -42,6 +42,7 @@ class NumpyLoaderSharded : public LoaderModule {
     DecodedDataInfo get_decode_data_info() override;
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) override;
     void shut_down() override;
     void feed_external_input(const std::vector<std::string> &input_images_names, const std::vector<unsigned char *> &input_buffer,
                              const std::vector<ROIxywh> &roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos) override {
@@ -58,5 +59,6 @@ class NumpyLoaderSharded : public LoaderModule {
     size_t _shard_count = 1;
     void fast_forward_through_empty_loaders();
     size_t _prefetch_queue_depth;
+    std::shared_ptr<ThreadPool> _decode_pool;
     Tensor *_output_tensor;
 };
@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*! \brief Persistent index of the image dimensions found in a dataset
+ *
+ * Stores the (width, height) of every image keyed by its path. Each entry also records the modification time and size
+ * of the file at the time it was scanned, so a later run only needs to rescan the files which changed since.
+ */
+class ImageDimensionIndex {
+   public:
+    struct FileStamp {
+        int64_t mtime_ns = 0;
+        uint64_t size = 0;
+        bool operator==(const FileStamp &other) const { return mtime_ns == other.mtime_ns && size == other.size; }
+    };
+
+    //! Constructor, loads the index stored at index_path if it exists and is valid
+    /*!
+    \param index_path Path of the index file, an empty path keeps the index in memory only
+    */
+    explicit ImageDimensionIndex(const std::string &index_path);
+
+    //! Returns the stamp of the file at file_path, false if the file cannot be accessed
+    static bool stamp(const std::string &file_path, FileStamp &file_stamp);
+
+    //! Looks up the dimensions of file_path, succeeds only if the file has not changed since it was indexed
+    /*! Safe to call concurrently as long as no insert() is running */
+    bool lookup(const std::string &file_path, const FileStamp &file_stamp, unsigned &width, unsigned &height) const;
+
+    void insert(const std::string &file_path, const FileStamp &file_stamp, unsigned width, unsigned height);
+
+    //! Removes the entries of the files not in file_paths
+    void retain(const std::vector<std::string> &file_paths);
+
+    //! Writes the index back to index_path if any entry was inserted or removed since it was loaded
+    void save();
+
+    size_t size() const { return _entries.size(); }
+
+   private:
+    struct Entry {
+        FileStamp file_stamp;
+        uint32_t width = 0, height = 0;
+    };
+    void load();
+    std::string _index_path;
+    std::unordered_map<std::string, Entry> _entries;
+    bool _modified = false;
+    static constexpr char INDEX_MAGIC[8] = {'R', 'O', 'C', 'A', 'L', 'I', 'D', 'X'};
+    static const uint32_t INDEX_VERSION = 1;
+};
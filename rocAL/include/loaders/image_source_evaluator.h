@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <memory>
 
 #include "loader_module.h"
+#include "loaders/image_dimension_index.h"
 #include "readers/image/reader_factory.h"
 #include "pipeline/timing_debug.h"
 #include "decoders/image/turbo_jpeg_decoder.h"
@@ -43,10 +44,13 @@ class ImageSourceEvaluator {
     ImageSourceEvaluatorStatus create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg);
     void find_max_dimension();
     void set_size_evaluation_policy(MaxSizeEvaluationPolicy arg);
+    void set_scan_pool(std::shared_ptr<ThreadPool> scan_pool) { _scan_pool = std::move(scan_pool); }  // Pool the image headers are read on, has to be set before create()
     size_t max_width();
     size_t max_height();
 
    private:
+    //! Scans only the headers of the files in parallel, reusing the dimensions stored in the dataset's index for unchanged files
+    void find_max_dimension_from_headers();
     class FindMaxSize {
        public:
         void set_policy(MaxSizeEvaluationPolicy arg) { _policy = arg; }
@@ -62,9 +66,13 @@ class ImageSourceEvaluator {
     FindMaxSize _width_max;
     FindMaxSize _height_max;
     DecoderConfig _decoder_cfg_cv;
+    DecoderConfig _decoder_cfg = DecoderConfig(DecoderType::TURBO_JPEG);
     std::shared_ptr<Decoder> _decoder;
     std::shared_ptr<Reader> _reader;
     std::shared_ptr<MetaDataReader> _meta_data_reader;
     std::vector<unsigned char> _header_buff;
+    std::shared_ptr<ThreadPool> _scan_pool;  // Null when a single thread reads the headers
+    std::string _index_path;  // Path of the image dimension index kept next to the dataset, empty if it cannot be persisted
     static const size_t COMPRESSED_SIZE = 1024 * 1024;  // 1 MB
+    static const size_t HEADER_READ_SIZE = 64 * 1024;   // Bytes read to decode the header, the whole file is read if the header does not fit
 };
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "meta_data/meta_data_graph.h"
 #include "meta_data/meta_data_reader.h"
 #include "pipeline/tensor.h"
+#include "pipeline/thread_pool.h"
 
 enum class LoaderModuleStatus {
     OK = 0,
@@ -56,6 +57,11 @@ class LoaderModule {
     virtual DecodedDataInfo get_decode_data_info() = 0;
     virtual CropImageInfo get_crop_image_info() { return {}; }
     virtual void set_prefetch_queue_depth(size_t prefetch_queue_depth) = 0;
+    virtual void set_deterministic_order(bool deterministic_order) {}  // Loaders running several shards return the batches in a fixed order if set, instead of the first one completed
+    virtual void set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {}  // Pool the batches are decoded on, has to be set before initialize()
+    virtual void set_decode_quality(DecodeQuality decode_quality) {}          // Has to be set before initialize(), ignored by the decoders not supporting it
+    virtual void set_io_depth(size_t io_depth) {}                             // Number of file reads kept in flight, has to be set before initialize(), 0 keeps the one of the ReaderConfig
+    virtual void set_decode_size_hint(size_t width, size_t height) {}         // Smallest size the decoded images are used at, see DecodeQuality::FAST_SCALED
     // introduce meta data reader
     virtual void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader) { THROW("set_random_bbox_data_reader is not compatible with this implementation") }
     virtual void shut_down() = 0;
@@ -26,8 +26,10 @@ THE SOFTWARE.
 #include <memory>
 #include <iterator>
 #include <cstring>
+#include <list>
 #include <map>
 #include <tuple>
+#include <unordered_map>
 #include "pipeline/commons.h"
 #include "decoders/video/video_decoder.h"
 #include "readers/video/video_reader_factory.h"
@@ -36,6 +38,7 @@ THE SOFTWARE.
 #include "readers/video/video_properties.h"
 #include "readers/video/video_reader.h"
 #include "pipeline/filesystem.h"
+#include "pipeline/thread_pool.h"
 
 #ifdef ROCAL_VIDEO
 extern "C" {
@@ -53,7 +56,6 @@ class VideoReadAndDecode {
         _video_process_count = (video_count <= _max_video_count) ? video_count : _max_video_count;
     }
     float convert_framenum_to_timestamp(size_t frame_number);
-    void decode_sequence(size_t sequence_index);
 
     //! Loads a decompressed batch of sequence of frames into the buffer indicated by buff
     /// \param buff User's buffer provided to be filled with decoded sequence samples
@@ -82,23 +84,31 @@ class VideoReadAndDecode {
     Timing timing();
 
    private:
-    struct video_map {
-        int _video_map_idx;
-        bool _is_decoder_instance;
-    };
+    //! Decodes the sequences in order with the decoder of the slot, runs on the decode workers
+    void decode_sequences(size_t slot, const std::vector<size_t> &sequence_indices);
+    //! Returns the decoder slot which has the video open, the least recently used slot not pinned by the current batch is reopened on a miss
+    /*! \return NO_FREE_DECODER if all the slots are pinned, DECODER_OPEN_FAILED if the video cannot be opened */
+    int acquire_decoder(const std::string &video_name);
+    void touch_decoder(size_t slot);
+    static constexpr int NO_FREE_DECODER = -1;
+    static constexpr int DECODER_OPEN_FAILED = -2;
     std::vector<std::shared_ptr<VideoDecoder>> _video_decoder;
     std::shared_ptr<VideoReader> _video_reader;
     size_t _max_video_count = 50;
     size_t _video_process_count;
     VideoProperties _video_prop;
     std::vector<std::string> _video_names;
-    std::map<std::string, video_map> _video_file_name_map;
+    std::unordered_map<std::string, size_t> _video_decoder_slot;   // Video name to the decoder slot which has it open
+    std::vector<std::string> _slot_video_name;                      // Video opened by each decoder slot, empty if none
+    std::list<size_t> _lru_slots;                                   // Decoder slots, most recently used first
+    std::vector<std::list<size_t>::iterator> _lru_position;         // Position of each slot in _lru_slots
+    std::vector<char> _slot_pinned;                                 // Slots holding a video of the batch being decoded
+    std::unique_ptr<ThreadPool> _decode_pool;                       // Long lived decode workers, one job per decoder slot and batch
     std::vector<unsigned char *> _decompressed_buff_ptrs;
     std::vector<size_t> _actual_decoded_width;
     std::vector<size_t> _actual_decoded_height;
     std::vector<size_t> _sequence_start_frame_num;
     std::vector<std::string> _sequence_video_path;
-    std::vector<int> _sequence_video_idx;
     TimingDbg _file_load_time, _decode_time;
     size_t _batch_size;
     size_t _sequence_length;
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <vector>
+
+#include "meta_data/meta_data.h"
+
+/*! \brief Anchor boxes of the box encoder / IoU matcher kept in a structure-of-arrays layout
+ *
+ * The anchors are grouped in blocks of BLOCK_SIZE consecutive anchors and the extent of every block is kept,
+ * the SSD and RetinaNet anchors are generated location by location so a block covers a small area of the image.
+ * compute_ious() only evaluates the blocks overlapping the box, every other anchor gets an IoU of 0.
+ * The store is built once when the pipeline is created and is read only afterwards.
+ */
+class AnchorBoxStore {
+   public:
+    static constexpr unsigned BLOCK_SIZE = 64;  // Multiple of the widest SIMD width used (16 floats)
+    AnchorBoxStore() = default;
+    //! Builds the store from the anchors in ltrb format, 4 floats per anchor
+    explicit AnchorBoxStore(const std::vector<float> &anchors);
+    void init(const std::vector<float> &anchors);
+    //! Number of anchors
+    unsigned size() const { return _count; }
+    //! Number of IoU values written by compute_ious(), size() rounded up to a multiple of BLOCK_SIZE
+    unsigned stride() const { return _padded_count; }
+    //! Anchors in the original array-of-structs layout
+    const BoundingBoxCord *ltrb() const { return _ltrb.data(); }
+    //! Computes the IoU of box against every anchor
+    /*!
+    \param box Box in ltrb format
+    \param ious Output of stride() values, the values after size() are padding and must be ignored
+    \return Index of the anchor with the highest IoU, the first one if several anchors have the same value
+    */
+    unsigned compute_ious(const BoundingBoxCord &box, float *ious) const;
+
+   private:
+    void compute_block_ious(const BoundingBoxCord &box, float box_area, unsigned start, float *ious) const;
+    unsigned _count = 0;
+    unsigned _padded_count = 0;
+    std::vector<BoundingBoxCord> _ltrb;
+    std::vector<float> _l, _t, _r, _b, _area;       //!< SoA anchor coordinates and areas, padded to stride() by repeating the last anchor
+    std::vector<BoundingBoxCord> _block_extent;     //!< Union of the anchors of each block
+};
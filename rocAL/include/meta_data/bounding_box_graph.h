@@ -33,6 +33,17 @@ class BoundingBoxGraph : public MetaDataGraph {
     void process(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data) override;
     void update_meta_data(pMetaDataBatch meta_data, DecodedDataInfo decode_image_info) override;
     void update_random_bbox_meta_data(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data, DecodedDataInfo decoded_image_info, CropImageInfo crop_image_info) override;
-    void update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) override;
+    void update_box_encoder_meta_data(const AnchorBoxStore &anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) override;
     void update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) override;
+
+   private:
+    struct IouScratch {
+        std::vector<float> ious;
+        std::vector<float> matched_vals;
+        std::vector<int> low_quality_preds;
+    };
+    //! Calls body(i, slot) for the samples in parallel, slot indexes the scratch of the executing thread
+    void parallel_for(size_t count, const std::function<void(size_t, size_t)> &body);
+    void reserve_scratch(size_t slot_count);
+    std::vector<IouScratch> _scratch;  //!< Per thread IoU buffers reused across batches
 };
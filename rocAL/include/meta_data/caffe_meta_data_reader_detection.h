@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <lmdb.h>
 #include "pipeline/commons.h"
 #include "lmdb.h"
+#include "meta_data/flat_meta_data_store.h"
 #include "meta_data/meta_data.h"
 #include "meta_data/meta_data_reader.h"
 #include "readers/image/image_reader.h"
@@ -44,17 +45,16 @@ class CaffeMetaDataReaderDetection : public MetaDataReader {
     void release() override;
     bool set_timestamp_mode() override { return false; }
     void print_map_contents();
-    std::map<std::string, std::shared_ptr<MetaData>>& get_map_content() override { return _map_content; }
+    const std::map<std::string, std::shared_ptr<MetaData>>& get_map_content() override;
     CaffeMetaDataReaderDetection();
 
    private:
     void read_files(const std::string& _path);
     bool exists(const std::string& image_name) override;
-    void add(std::string image_name, BoundingBoxCords bbox, Labels labels, ImgSize image_size);
     bool _last_rec;
     void read_lmdb_record(std::string file_name, uint file_size);
-    std::map<std::string, std::shared_ptr<MetaData>> _map_content;
-    std::map<std::string, std::shared_ptr<MetaData>>::iterator _itr;
+    FlatMetaDataStore _store;                                        //!< Boxes of all the images, lookup() copies from it
+    std::map<std::string, std::shared_ptr<MetaData>> _map_content;   //!< Per image objects, only built when get_map_content() is called
     std::string _path;
     pMetaDataBatch _output;
     DIR* _src_dir;
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include <map>
 
 #include "pipeline/commons.h"
+#include "meta_data/flat_meta_data_store.h"
 #include "meta_data/meta_data.h"
 #include "meta_data/meta_data_reader.h"
 #include "pipeline/timing_debug.h"
@@ -38,7 +39,7 @@ class COCOMetaDataReader : public MetaDataReader {
     void release() override;
     void print_map_contents();
     bool set_timestamp_mode() override { return false; }
-    const std::map<std::string, std::shared_ptr<MetaData>>& get_map_content() override { return _map_content; }
+    const std::map<std::string, std::shared_ptr<MetaData>>& get_map_content() override;
     void set_aspect_ratio_grouping(bool aspect_ratio_grouping) override { _aspect_ratio_grouping = aspect_ratio_grouping; }
     bool get_aspect_ratio_grouping() const override { return _aspect_ratio_grouping; }
     COCOMetaDataReader();
@@ -47,11 +48,9 @@ class COCOMetaDataReader : public MetaDataReader {
     pMetaDataBatch _output;
     std::string _path;
     bool _avoid_class_remapping;
-    void add(std::string image_name, BoundingBoxCords bbox, Labels labels, ImgSize image_size, int image_id = 0);
-    void add(std::string image_name, BoundingBoxCords bbox, Labels labels, ImgSize image_size, MaskCords mask_cords, std::vector<int> polygon_count, std::vector<std::vector<int>> vertices_count, int image_id = 0);  // To add Mask coordinates to Metadata struct
     bool exists(const std::string& image_name) override;
-    std::map<std::string, std::shared_ptr<MetaData>> _map_content;
-    std::map<std::string, std::shared_ptr<MetaData>>::iterator _itr;
+    FlatMetaDataStore _store;                                               //!< Annotations of all the images, lookup() copies from it
+    std::map<std::string, std::shared_ptr<MetaData>> _map_content;          //!< Per image objects, only built when get_map_content() is called
     std::map<std::string, ImgSize> _map_img_sizes;
     std::map<int, std::string> _map_image_names_to_id;  // Maps image names to their image IDs
     std::map<std::string, ImgSize>::iterator itr;
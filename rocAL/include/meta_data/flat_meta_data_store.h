@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "meta_data/meta_data.h"
+
+/*! \brief Read only view on a contiguous range of one column of the FlatMetaDataStore */
+template <typename T>
+struct MetaDataSpan {
+    const T *data = nullptr;
+    size_t size = 0;
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+    const T &operator[](size_t idx) const { return data[idx]; }
+};
+
+/*! \brief Columnar store of the bounding box and polygon mask annotations of a dataset
+ *
+ * Every field is kept in a single contiguous buffer for the whole dataset and every image only keeps the offset and count of its annotations.
+ * The images are found through a hash index on their name or id.
+ * The store is filled with add_annotation() while parsing and finalize() groups the annotations of each image, it is read only afterwards.
+ */
+class FlatMetaDataStore {
+   public:
+    struct Entry {
+        int image_id = 0;
+        ImgSize img_size = {};
+        unsigned box_offset = 0;        // Offset in the boxes, labels and polygon counts columns
+        unsigned box_count = 0;
+        unsigned mask_offset = 0;       // Offset in the mask coordinates column
+        unsigned mask_count = 0;
+        unsigned vertices_offset = 0;   // Offset in the vertices count column, one value per polygon
+        unsigned polygon_count = 0;     // Total number of polygons of the image
+    };
+
+    //! Appends one annotation of the image, the image is registered on its first annotation
+    /*!
+    \param mask_cords Polygon coordinates of the annotation, can be nullptr when masks are not used
+    \param vertices_count Number of coordinates of each polygon of the annotation
+    */
+    void add_annotation(const std::string &image_name, int image_id, const ImgSize &img_size, const BoundingBoxCord &box, int label,
+                        const float *mask_cords = nullptr, size_t mask_size = 0, const std::vector<int> &vertices_count = {});
+    //! Groups the annotations of every image into contiguous ranges, the order of the annotations of an image is kept
+    void finalize();
+    void clear();
+    //! Removes the image from the index, its annotations stay in the columns
+    void erase(const std::string &image_name);
+
+    //! Returns the entry of the image or nullptr if the image has no annotation
+    const Entry *find(const std::string &image_name) const;
+    const Entry *find(int image_id) const;
+    size_t size() const { return _index.size(); }
+    //! Calls func(name, entry) for every image in the store
+    template <typename Func>
+    void for_each(Func func) const {
+        for (auto &elem : _index)
+            func(elem.first, _view.entries[elem.second]);
+    }
+
+    MetaDataSpan<BoundingBoxCord> boxes(const Entry &entry) const { return {_view.boxes + entry.box_offset, entry.box_count}; }
+    MetaDataSpan<int> labels(const Entry &entry) const { return {_view.labels + entry.box_offset, entry.box_count}; }
+    MetaDataSpan<int> polygon_counts(const Entry &entry) const { return {_view.polygon_counts + entry.box_offset, entry.box_count}; }
+    MetaDataSpan<int> vertices_counts(const Entry &entry) const { return {_view.vertices_counts + entry.vertices_offset, entry.polygon_count}; }
+    MetaDataSpan<float> mask_cords(const Entry &entry) const { return {_view.mask_cords + entry.mask_offset, entry.mask_count}; }
+    //! Builds the per image MetaData objects, for the readers which walk all the annotations (random bbox crop)
+    /*! \param with_masks Builds PolygonMask objects instead of BoundingBox objects */
+    void build_map_content(std::map<std::string, std::shared_ptr<MetaData>> &map_content, bool with_masks) const;
+    //! Labels column of the whole dataset, used to remap the class ids once all the annotations are read
+    /*! Only valid for a store filled with add_annotation(), a store loaded from a cache has its labels already remapped */
+    std::vector<int> &labels_column() { return _labels; }
+
+    //! Writes the finalized store to a binary cache file which load() maps back without parsing the annotations again
+    /*!
+    \param source_key Key of the parsed annotation sources and reader options, see source_key()
+    \return false if the cache cannot be written, the store itself is not affected
+    */
+    bool save(const std::string &cache_path, uint64_t source_key) const;
+    //! Replaces the content of the store with the cache file at cache_path, the columns are used in place from the mapped file
+    /*! \return false if the cache does not exist, is invalid or was written for another source_key */
+    bool load(const std::string &cache_path, uint64_t source_key);
+    //! Key of the annotation sources, changes when any source file is modified or when the reader options differ
+    /*!
+    \param source_paths Annotation files the store is built from
+    \param options Reader settings which change the content of the store (metadata type, class remapping ...)
+    */
+    static uint64_t source_key(const std::vector<std::string> &source_paths, const std::string &options);
+    //! Default location of the cache of an annotation file or folder: a hidden file next to it
+    static std::string cache_path(const std::string &source_path);
+
+   private:
+    // One record per annotation while parsing, finalize() turns them into the per image ranges
+    struct PendingAnnotation {
+        unsigned entry_idx;
+        BoundingBoxCord box;
+        int label;
+        unsigned mask_offset, mask_count;
+        unsigned vertices_offset, polygon_count;
+    };
+    // Columns read by the accessors, they point either to the vectors below or into the mapped cache file
+    struct ColumnView {
+        const Entry *entries = nullptr;
+        const BoundingBoxCord *boxes = nullptr;
+        const int *labels = nullptr;
+        const int *polygon_counts = nullptr;
+        const int *vertices_counts = nullptr;
+        const float *mask_cords = nullptr;
+        size_t entry_count = 0, box_count = 0, vertices_count = 0, mask_count = 0;
+    };
+    void view_owned_columns();
+    ColumnView _view;
+    std::shared_ptr<void> _mapping;                       //!< Mapped cache file, unmapped when the store is cleared
+    std::vector<Entry> _entries;
+    std::unordered_map<std::string, unsigned> _index;     //!< Image name to entry index
+    std::unordered_map<int, unsigned> _id_index;          //!< Image id to entry index
+    std::vector<PendingAnnotation> _pending;
+    std::vector<BoundingBoxCord> _boxes;
+    std::vector<int> _labels;
+    std::vector<int> _polygon_counts;                     //!< Number of polygons of each box
+    std::vector<int> _vertices_counts;                    //!< Number of coordinates of each polygon
+    std::vector<float> _mask_cords;
+};
@@ -208,6 +208,34 @@ class KeyPoint : public BoundingBox {
     JointsData _joints_data = {};
 };
 
+/*! \brief Shares a value between copies until one of them modifies it
+ *
+ * Copying the holder only copies a reference, write() makes a private copy of the value first if it is still shared.
+ * Used for the per sample columns of the meta data batches so that MetaDataBatch::clone() does not deep copy them.
+ */
+template <typename T>
+class CopyOnWrite {
+   public:
+    CopyOnWrite() : _value(std::make_shared<T>()) {}
+    const T& read() const { return *_value; }
+    T& write() {
+        if (_value.use_count() > 1)
+            _value = std::make_shared<T>(*_value);
+        return *_value;
+    }
+    //! Returns the value resized for a rewrite of all its elements, a value still shared is replaced by a new one instead of being copied
+    T& overwrite(size_t size) {
+        if (_value.use_count() > 1)
+            _value = std::make_shared<T>(size);
+        else
+            _value->resize(size);
+        return *_value;
+    }
+
+   private:
+    std::shared_ptr<T> _value;
+};
+
 class MetaDataInfoBatch {
    public:
     std::vector<int> img_ids = {};
@@ -239,9 +267,13 @@ class MetaDataBatch {
     virtual ~MetaDataBatch() = default;
     virtual void clear() { THROW("Not Implemented") }
     virtual void resize(int batch_size) { THROW("Not Implemented") }
+    /// Resizes the batch for a lookup rewriting every sample, unlike resize() it does not copy the values still shared with a clone
+    virtual void prepare_overwrite(int batch_size) { resize(batch_size); }
     virtual int size() { THROW("Not Implemented") }
     virtual void copy_data(std::vector<void*> buffer) { THROW("Not Implemented") }
     virtual std::vector<size_t>& get_buffer_size() { THROW("Not Implemented") }
+    /// Where each sample starts in the buffer copy_data() fills at buffer_idx, counted in labels, boxes, mask coordinates or bytes, the last of the batch size + 1 offsets is the total
+    virtual const std::vector<size_t>& get_sample_offsets(unsigned buffer_idx) { THROW("Not Implemented") }
     virtual MetaDataBatch& operator+=(MetaDataBatch& other) { THROW("Not Implemented") }
     MetaDataBatch* concatenate(MetaDataBatch* other) {
         *this += *other;
@@ -250,6 +282,9 @@ class MetaDataBatch {
     virtual std::shared_ptr<MetaDataBatch> clone(bool copy_contents = true) { THROW("Not Implemented") }
     virtual int mask_size() { THROW("Not Implemented") }
     virtual std::vector<Labels>& get_labels_batch() { THROW("Not Implemented") }
+    // Read only accessors, unlike the get_ functions they never copy the data shared with a clone
+    virtual const std::vector<Labels>& read_labels_batch() { return get_labels_batch(); }
+    virtual const std::vector<BoundingBoxCords>& read_bb_cords_batch() { return get_bb_cords_batch(); }
     virtual std::vector<AsciiValues>& get_ascii_values_batch() { THROW("Not Implemented") }
     virtual std::vector<BoundingBoxCords>& get_bb_cords_batch() { THROW("Not Implemented") }
     virtual void set_xywh_bbox() { THROW("Not Implemented") }
@@ -266,8 +301,17 @@ class MetaDataBatch {
     MetaDataType get_metadata_type() { return _type; }
 
    protected:
+    template <typename T>
+    const std::vector<size_t>& fill_sample_offsets(const std::vector<T>& batch) {
+        _sample_offsets.resize(batch.size() + 1);
+        _sample_offsets[0] = 0;
+        for (unsigned i = 0; i < batch.size(); i++)
+            _sample_offsets[i + 1] = _sample_offsets[i] + batch[i].size();
+        return _sample_offsets;
+    }
     MetaDataInfoBatch _info_batch;
     MetaDataType _type;
+    std::vector<size_t> _sample_offsets;
 };
 
 class AsciiValueBatch : public MetaDataBatch {
@@ -336,6 +380,13 @@ class AsciiValueBatch : public MetaDataBatch {
         }
         return _buffer_size;
     }
+    const std::vector<size_t>& get_sample_offsets(unsigned buffer_idx) override {
+        _sample_offsets.resize(_ascii_values.size() + 1);
+        _sample_offsets[0] = 0;
+        for (unsigned i = 0; i < _ascii_values.size(); i++)
+            _sample_offsets[i + 1] = _sample_offsets[i] + (_ascii_values[i][buffer_idx] ? _ascii_values[i][buffer_idx]->size() : 0);
+        return _sample_offsets;
+    }
     std::vector<AsciiValues>& get_ascii_values_batch() override { return _ascii_values; }
 
    protected:
@@ -346,28 +397,30 @@ class AsciiValueBatch : public MetaDataBatch {
 class LabelBatch : public MetaDataBatch {
    public:
     void clear() override {
-        for (auto label : _label_ids) {
-            label.clear();
-        }
         _info_batch.clear();
-        _label_ids.clear();
+        _label_ids.overwrite(0);
         _buffer_size.clear();
     }
     MetaDataBatch& operator+=(MetaDataBatch& other) override {
-        _label_ids.insert(_label_ids.end(), other.get_labels_batch().begin(), other.get_labels_batch().end());
+        auto& other_labels = other.read_labels_batch();
+        _label_ids.write().insert(_label_ids.write().end(), other_labels.begin(), other_labels.end());
         _info_batch.insert(other.get_info_batch());
         return *this;
     }
     void resize(int batch_size) override {
-        _label_ids.resize(batch_size);
+        _label_ids.write().resize(batch_size);
+        _info_batch.resize(batch_size);
+    }
+    void prepare_overwrite(int batch_size) override {
+        _label_ids.overwrite(batch_size);
         _info_batch.resize(batch_size);
     }
     int size() override {
-        return _label_ids.size();
+        return _label_ids.read().size();
     }
     std::shared_ptr<MetaDataBatch> clone(bool copy_contents) override {
         if (copy_contents) {
-            return std::make_shared<LabelBatch>(*this);  // Copy the entire metadata batch with all the metadata values and info
+            return std::make_shared<LabelBatch>(*this);  // Shares the metadata values with the copy until one of them modifies them
         } else {
             std::shared_ptr<MetaDataBatch> label_batch_instance = std::make_shared<LabelBatch>();
             label_batch_instance->resize(this->size());
@@ -376,58 +429,71 @@ class LabelBatch : public MetaDataBatch {
         }
     }
     explicit LabelBatch(std::vector<Labels>& labels) {
-        _label_ids = std::move(labels);
+        _label_ids.write() = std::move(labels);
     }
     LabelBatch() = default;
     void copy_data(std::vector<void*> buffer) override {
         if (buffer.size() < 1)
             THROW("The buffers are insufficient")  // TODO -change
         auto labels_buffer = (int*)buffer[0];
-        for (unsigned i = 0; i < _label_ids.size(); i++) {
-            memcpy(labels_buffer, _label_ids[i].data(), _label_ids[i].size() * sizeof(int));
-            labels_buffer += _label_ids[i].size();
+        for (auto& labels : _label_ids.read()) {
+            memcpy(labels_buffer, labels.data(), labels.size() * sizeof(int));
+            labels_buffer += labels.size();
         }
     }
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids.read())
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         return _buffer_size;
     }
-    std::vector<Labels>& get_labels_batch() override { return _label_ids; }
+    const std::vector<size_t>& get_sample_offsets(unsigned buffer_idx) override {
+        if (buffer_idx != 0)
+            THROW("Label batch has no metadata buffer " + TOSTR(buffer_idx))
+        return fill_sample_offsets(_label_ids.read());
+    }
+    std::vector<Labels>& get_labels_batch() override { return _label_ids.write(); }
+    const std::vector<Labels>& read_labels_batch() override { return _label_ids.read(); }
 
    protected:
-    std::vector<Labels> _label_ids = {};
+    CopyOnWrite<std::vector<Labels>> _label_ids;
     std::vector<size_t> _buffer_size;
 };
 
 class BoundingBoxBatch : public LabelBatch {
    public:
     void clear() override {
-        _bb_cords.clear();
-        _label_ids.clear();
+        _bb_cords.overwrite(0);
+        _label_ids.overwrite(0);
         _info_batch.clear();
         _buffer_size.clear();
     }
     MetaDataBatch& operator+=(MetaDataBatch& other) override {
-        _bb_cords.insert(_bb_cords.end(), other.get_bb_cords_batch().begin(), other.get_bb_cords_batch().end());
-        _label_ids.insert(_label_ids.end(), other.get_labels_batch().begin(), other.get_labels_batch().end());
+        auto& other_bb_cords = other.read_bb_cords_batch();
+        auto& other_labels = other.read_labels_batch();
+        _bb_cords.write().insert(_bb_cords.write().end(), other_bb_cords.begin(), other_bb_cords.end());
+        _label_ids.write().insert(_label_ids.write().end(), other_labels.begin(), other_labels.end());
         _info_batch.insert(other.get_info_batch());
         return *this;
     }
     void resize(int batch_size) override {
-        _bb_cords.resize(batch_size);
-        _label_ids.resize(batch_size);
+        _bb_cords.write().resize(batch_size);
+        _label_ids.write().resize(batch_size);
+        _info_batch.resize(batch_size);
+    }
+    void prepare_overwrite(int batch_size) override {
+        _bb_cords.overwrite(batch_size);
+        _label_ids.overwrite(batch_size);
         _info_batch.resize(batch_size);
     }
     int size() override {
-        return _bb_cords.size();
+        return _bb_cords.read().size();
     }
     std::shared_ptr<MetaDataBatch> clone(bool copy_contents) override {
         if (copy_contents) {
-            return std::make_shared<BoundingBoxBatch>(*this);  // Copy the entire metadata batch with all the metadata values and info
+            return std::make_shared<BoundingBoxBatch>(*this);  // Shares the metadata values with the copy until one of them modifies them
         } else {
             std::shared_ptr<MetaDataBatch> bbox_batch_instance = std::make_shared<BoundingBoxBatch>();
             bbox_batch_instance->resize(this->size());
@@ -435,8 +501,8 @@ class BoundingBoxBatch : public LabelBatch {
             return bbox_batch_instance;
         }
     }
-    void convert_ltrb_to_xywh(BoundingBoxCords& ltrb_bbox_list) {
-        for (unsigned i = 0; i < ltrb_bbox_list.size(); i++) {
+    void convert_ltrb_to_xywh(BoundingBoxCord* ltrb_bbox_list, size_t count) {
+        for (unsigned i = 0; i < count; i++) {
             auto& bbox = ltrb_bbox_list[i];
             // Change the values in place
             bbox.r = bbox.r - bbox.l;
@@ -448,66 +514,86 @@ class BoundingBoxBatch : public LabelBatch {
             THROW("The buffers are insufficient")  // TODO -change
         int* labels_buffer = (int*)buffer[0];
         float* bbox_buffer = (float*)buffer[1];
-        for (unsigned i = 0; i < _label_ids.size(); i++) {
-            memcpy(labels_buffer, _label_ids[i].data(), _label_ids[i].size() * sizeof(int));
-            if (_bbox_output_type == BoundingBoxType::XYWH) convert_ltrb_to_xywh(_bb_cords[i]);
-            memcpy(bbox_buffer, _bb_cords[i].data(), _label_ids[i].size() * 4 * sizeof(float));
-            labels_buffer += _label_ids[i].size();
-            bbox_buffer += (_label_ids[i].size() * 4);
+        auto& label_ids = _label_ids.read();
+        auto& bb_cords = _bb_cords.read();
+        for (unsigned i = 0; i < label_ids.size(); i++) {
+            memcpy(labels_buffer, label_ids[i].data(), label_ids[i].size() * sizeof(int));
+            memcpy(bbox_buffer, bb_cords[i].data(), label_ids[i].size() * 4 * sizeof(float));
+            // The conversion is done on the output buffer, the batch may share its boxes with a clone
+            if (_bbox_output_type == BoundingBoxType::XYWH) convert_ltrb_to_xywh(reinterpret_cast<BoundingBoxCord*>(bbox_buffer), label_ids[i].size());
+            labels_buffer += label_ids[i].size();
+            bbox_buffer += (label_ids[i].size() * 4);
         }
     }
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids.read())
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         _buffer_size.emplace_back(size * 4 * sizeof(float));
         return _buffer_size;
     }
-    std::vector<BoundingBoxCords>& get_bb_cords_batch() override { return _bb_cords; }
+    const std::vector<size_t>& get_sample_offsets(unsigned buffer_idx) override {
+        // The labels and the boxes buffers hold one entry per object
+        if (buffer_idx > 1)
+            THROW("Bounding box batch has no metadata buffer " + TOSTR(buffer_idx))
+        return fill_sample_offsets(_label_ids.read());
+    }
+    std::vector<BoundingBoxCords>& get_bb_cords_batch() override { return _bb_cords.write(); }
+    const std::vector<BoundingBoxCords>& read_bb_cords_batch() override { return _bb_cords.read(); }
     void set_xywh_bbox() override { _bbox_output_type = BoundingBoxType::XYWH; }
 
    protected:
-    std::vector<BoundingBoxCords> _bb_cords = {};
+    CopyOnWrite<std::vector<BoundingBoxCords>> _bb_cords;
     BoundingBoxType _bbox_output_type = BoundingBoxType::LTRB;
 };
 
 struct PolygonMaskBatch : public BoundingBoxBatch {
    public:
     void clear() override {
-        _bb_cords.clear();
-        _label_ids.clear();
+        _bb_cords.overwrite(0);
+        _label_ids.overwrite(0);
         _info_batch.clear();
-        _mask_cords.clear();
-        _polygon_counts.clear();
-        _vertices_counts.clear();
+        _mask_cords.overwrite(0);
+        _polygon_counts.overwrite(0);
+        _vertices_counts.overwrite(0);
         _buffer_size.clear();
     }
     MetaDataBatch& operator+=(MetaDataBatch& other) override {
-        _bb_cords.insert(_bb_cords.end(), other.get_bb_cords_batch().begin(), other.get_bb_cords_batch().end());
-        _label_ids.insert(_label_ids.end(), other.get_labels_batch().begin(), other.get_labels_batch().end());
+        auto& other_bb_cords = other.read_bb_cords_batch();
+        auto& other_labels = other.read_labels_batch();
+        _bb_cords.write().insert(_bb_cords.write().end(), other_bb_cords.begin(), other_bb_cords.end());
+        _label_ids.write().insert(_label_ids.write().end(), other_labels.begin(), other_labels.end());
         _info_batch.insert(other.get_info_batch());
-        _mask_cords.insert(_mask_cords.end(), other.get_mask_cords_batch().begin(), other.get_mask_cords_batch().end());
-        _polygon_counts.insert(_polygon_counts.end(), other.get_mask_polygons_count_batch().begin(), other.get_mask_polygons_count_batch().end());
-        _vertices_counts.insert(_vertices_counts.end(), other.get_mask_vertices_count_batch().begin(), other.get_mask_vertices_count_batch().end());
+        _mask_cords.write().insert(_mask_cords.write().end(), other.get_mask_cords_batch().begin(), other.get_mask_cords_batch().end());
+        _polygon_counts.write().insert(_polygon_counts.write().end(), other.get_mask_polygons_count_batch().begin(), other.get_mask_polygons_count_batch().end());
+        _vertices_counts.write().insert(_vertices_counts.write().end(), other.get_mask_vertices_count_batch().begin(), other.get_mask_vertices_count_batch().end());
         return *this;
     }
     void resize(int batch_size) override {
-        _bb_cords.resize(batch_size);
-        _label_ids.resize(batch_size);
+        _bb_cords.write().resize(batch_size);
+        _label_ids.write().resize(batch_size);
         _info_batch.resize(batch_size);
-        _mask_cords.resize(batch_size);
-        _polygon_counts.resize(batch_size);
-        _vertices_counts.resize(batch_size);
-    }
-    std::vector<MaskCords>& get_mask_cords_batch() override { return _mask_cords; }
-    std::vector<std::vector<int>>& get_mask_polygons_count_batch() override { return _polygon_counts; }
-    std::vector<std::vector<std::vector<int>>>& get_mask_vertices_count_batch() override { return _vertices_counts; }
-    int mask_size() override { return _mask_cords.size(); }
+        _mask_cords.write().resize(batch_size);
+        _polygon_counts.write().resize(batch_size);
+        _vertices_counts.write().resize(batch_size);
+    }
+    void prepare_overwrite(int batch_size) override {
+        _bb_cords.overwrite(batch_size);
+        _label_ids.overwrite(batch_size);
+        _info_batch.resize(batch_size);
+        _mask_cords.overwrite(batch_size);
+        _polygon_counts.overwrite(batch_size);
+        _vertices_counts.overwrite(batch_size);
+    }
+    std::vector<MaskCords>& get_mask_cords_batch() override { return _mask_cords.write(); }
+    std::vector<std::vector<int>>& get_mask_polygons_count_batch() override { return _polygon_counts.write(); }
+    std::vector<std::vector<std::vector<int>>>& get_mask_vertices_count_batch() override { return _vertices_counts.write(); }
+    int mask_size() override { return _mask_cords.read().size(); }
     std::shared_ptr<MetaDataBatch> clone(bool copy_contents) override {
         if (copy_contents) {
-            return std::make_shared<PolygonMaskBatch>(*this);  // Copy the entire metadata batch with all the metadata values and info
+            return std::make_shared<PolygonMaskBatch>(*this);  // Shares the metadata values with the copy until one of them modifies them
         } else {
             std::shared_ptr<MetaDataBatch> mask_batch_instance = std::make_shared<PolygonMaskBatch>();
             mask_batch_instance->resize(this->size());
@@ -521,34 +607,42 @@ struct PolygonMaskBatch : public BoundingBoxBatch {
         int* labels_buffer = (int*)buffer[0];
         float* bbox_buffer = (float*)buffer[1];
         float* mask_buffer = (float*)buffer[2];
-        for (unsigned i = 0; i < _label_ids.size(); i++) {
-            mempcpy(labels_buffer, _label_ids[i].data(), _label_ids[i].size() * sizeof(int));
-            if (_bbox_output_type == BoundingBoxType::XYWH) convert_ltrb_to_xywh(_bb_cords[i]);
-            memcpy(bbox_buffer, _bb_cords[i].data(), _label_ids[i].size() * 4 * sizeof(float));
-            memcpy(mask_buffer, _mask_cords[i].data(), _mask_cords[i].size() * sizeof(float));
-            labels_buffer += _label_ids[i].size();
-            bbox_buffer += (_label_ids[i].size() * 4);
-            mask_buffer += _mask_cords[i].size();
+        auto& label_ids = _label_ids.read();
+        auto& bb_cords = _bb_cords.read();
+        auto& mask_cords = _mask_cords.read();
+        for (unsigned i = 0; i < label_ids.size(); i++) {
+            mempcpy(labels_buffer, label_ids[i].data(), label_ids[i].size() * sizeof(int));
+            memcpy(bbox_buffer, bb_cords[i].data(), label_ids[i].size() * 4 * sizeof(float));
+            if (_bbox_output_type == BoundingBoxType::XYWH) convert_ltrb_to_xywh(reinterpret_cast<BoundingBoxCord*>(bbox_buffer), label_ids[i].size());
+            memcpy(mask_buffer, mask_cords[i].data(), mask_cords[i].size() * sizeof(float));
+            labels_buffer += label_ids[i].size();
+            bbox_buffer += (label_ids[i].size() * 4);
+            mask_buffer += mask_cords[i].size();
         }
     }
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids.read())
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         _buffer_size.emplace_back(size * 4 * sizeof(float));
         size = 0;
-        for (auto mask : _mask_cords)
+        for (auto& mask : _mask_cords.read())
             size += mask.size();
         _buffer_size.emplace_back(size * sizeof(float));
         return _buffer_size;
     }
+    const std::vector<size_t>& get_sample_offsets(unsigned buffer_idx) override {
+        if (buffer_idx == 2)
+            return fill_sample_offsets(_mask_cords.read());
+        return BoundingBoxBatch::get_sample_offsets(buffer_idx);
+    }
 
    protected:
-    std::vector<MaskCords> _mask_cords = {};
-    std::vector<std::vector<int>> _polygon_counts = {};
-    std::vector<std::vector<std::vector<int>>> _vertices_counts = {};
+    CopyOnWrite<std::vector<MaskCords>> _mask_cords;
+    CopyOnWrite<std::vector<std::vector<int>>> _polygon_counts;
+    CopyOnWrite<std::vector<std::vector<std::vector<int>>>> _vertices_counts;
 };
 
 class KeyPointBatch : public BoundingBoxBatch {
@@ -556,8 +650,8 @@ class KeyPointBatch : public BoundingBoxBatch {
     void clear() override {
         _info_batch.clear();
         _joints_data = {};
-        _bb_cords.clear();
-        _label_ids.clear();
+        _bb_cords.overwrite(0);
+        _label_ids.overwrite(0);
     }
     MetaDataBatch& operator+=(MetaDataBatch& other) override {
         _joints_data.image_id_batch.insert(_joints_data.image_id_batch.end(), other.get_joints_data_batch().image_id_batch.begin(), other.get_joints_data_batch().image_id_batch.end());
@@ -581,9 +675,10 @@ class KeyPointBatch : public BoundingBoxBatch {
         _joints_data.score_batch.resize(batch_size);
         _joints_data.rotation_batch.resize(batch_size);
         _info_batch.resize(batch_size);
-        _bb_cords.resize(batch_size);
-        _label_ids.resize(batch_size);
+        _bb_cords.write().resize(batch_size);
+        _label_ids.write().resize(batch_size);
     }
+    void prepare_overwrite(int batch_size) override { resize(batch_size); }  // The joints data is not copy-on-write
     int size() override {
         return _joints_data.image_id_batch.size();
     }
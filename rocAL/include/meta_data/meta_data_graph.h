@@ -24,14 +24,16 @@ THE SOFTWARE.
 #include <list>
 
 #include "loaders/circular_buffer.h"
+#include "meta_data/anchor_box_store.h"
 #include "meta_data/meta_data.h"
 #include "meta_data/meta_node.h"
 #include "pipeline/node.h"
+#include "pipeline/thread_pool.h"
 #include "parameters/parameter_factory.h"
 #include "meta_data/randombboxcrop_meta_data_reader.h"
 
 typedef struct {
-    std::vector<float> *anchors;
+    const AnchorBoxStore *anchors;
     float high_threshold;
     float low_threshold;
     bool allow_low_quality_matches;
@@ -43,7 +45,11 @@ class MetaDataGraph {
     virtual void process(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data) = 0;
     virtual void update_meta_data(pMetaDataBatch meta_data, DecodedDataInfo decoded_data_info) = 0;
     virtual void update_random_bbox_meta_data(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data, DecodedDataInfo decoded_data_info, CropImageInfo crop_image_info) = 0;
-    virtual void update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) = 0;
+    virtual void update_box_encoder_meta_data(const AnchorBoxStore &anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) = 0;
     virtual void update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) = 0;
+    void set_cpu_pool(std::shared_ptr<ThreadPool> cpu_pool) { _cpu_pool = std::move(cpu_pool); }  // Pool the per sample processing runs on, OpenMP is used if not set
     std::list<std::shared_ptr<MetaNode>> _meta_nodes;
+
+   protected:
+    std::shared_ptr<ThreadPool> _cpu_pool;
 };
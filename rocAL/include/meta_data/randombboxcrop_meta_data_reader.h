@@ -82,6 +82,7 @@ class RandomBBoxCrop_MetaDataReader {
     virtual void read_all() = 0;                                                                                     // Reads all the meta data information
     virtual void lookup(const std::vector<std::string>& image_names) = 0;                                            // finds meta_data info associated with given names and fills the output
     virtual std::vector<std::vector<float>> get_batch_crop_coords(const std::vector<std::string>& image_names) = 0;  // returns the crop coords for a batch
+    virtual std::vector<float> get_crop_coords(const std::string& image_name) = 0;                                   // returns the crop coords of one image, deterministic per seed, epoch and image so it can be called from any thread
     virtual void release() = 0;                                                                                      // Deletes the loaded information
     virtual void set_meta_data(std::shared_ptr<MetaDataReader> meta_data_reader) = 0;
     virtual std::shared_ptr<CropCordBatch> get_output() = 0;
@@ -24,7 +24,9 @@ THE SOFTWARE.
 #include "pipeline/graph.h"
 #include <vx_ext_rpp.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <random>
 
 #include "meta_data/caffe2_meta_data_reader_detection.h"
@@ -37,45 +39,12 @@ THE SOFTWARE.
 #include "meta_data/randombboxcrop_meta_data_reader.h"
 #include "meta_data/tf_meta_data_reader_detection.h"
 
-// todo:: move this to common header
-template <typename T = std::mt19937, std::size_t state_size = T::state_size>
-class SeededRNG {
-    /*
-     * @param batch_size How many RNGs to store
-     * @param state_size How many seed are used to initialize one RNG. Used to lower probablity of
-     * collisions between seeds used to initialize RNGs in different operators.
-     */
-   public:
-    SeededRNG(int batch_size = 128) {
-        std::random_device source;
-        _batch_size = batch_size;
-        std::size_t _random_data_size = state_size * batch_size;
-        std::vector<std::random_device::result_type> random_data(_random_data_size);
-        std::generate(random_data.begin(), random_data.end(), std::ref(source));
-        _rngs.reserve(batch_size);
-        for (int i = 0; i < (int)(_batch_size * state_size); i += state_size) {
-            std::seed_seq seeds(std::begin(random_data) + i, std::begin(random_data) + i + state_size);
-            _rngs.emplace_back(T(seeds));
-        }
-    }
-
-    /**
-     * Returns engine corresponding to given sample ID
-     */
-    T &operator[](int sample) noexcept {
-        return _rngs[sample % _batch_size];
-    }
-
-   private:
-    std::vector<T> _rngs;
-    int _batch_size;
-};
-
 class RandomBBoxCropReader : public RandomBBoxCrop_MetaDataReader {
    public:
     void init(const RandomBBoxCrop_MetaDataConfig &cfg, std::shared_ptr<CropCordBatch> meta_data_batch) override;
     void lookup(const std::vector<std::string> &image_names) override;
     std::vector<std::vector<float>> get_batch_crop_coords(const std::vector<std::string> &image_names) override;
+    std::vector<float> get_crop_coords(const std::string &image_name) override;
     void read_all() override;
     void release() override;
     void print_map_contents();
@@ -88,7 +57,11 @@ class RandomBBoxCropReader : public RandomBBoxCrop_MetaDataReader {
 
    private:
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
-    std::map<std::string, std::shared_ptr<MetaData>> _meta_bbox_map_content;
+    const std::map<std::string, std::shared_ptr<MetaData>> *_meta_bbox_map = nullptr;
+    std::once_flag _meta_bbox_map_flag;
+    const std::map<std::string, std::shared_ptr<MetaData>> &meta_bbox_map();
+    //! Rejection samples a crop satisfying the IoU and box center constraints, img_width > 0 aligns its left edge for the partial jpeg decoder
+    BoundingBoxCord sample_crop(const BoundingBoxCords &bb_coords, int img_width, CounterRNG &rng) const;
     bool _all_boxes_overlap;
     bool _no_crop;
     bool _has_shape;
@@ -100,12 +73,10 @@ class RandomBBoxCropReader : public RandomBBoxCrop_MetaDataReader {
     int _user_batch_size;
     int64_t _seed;
     void add(std::string image_name, BoundingBoxCord bbox);
-    std::vector<std::vector<float>> _crop_coords;
     bool exists(const std::string &image_name);
     std::map<std::string, std::shared_ptr<CropCord>> _map_content;
     std::map<std::string, std::shared_ptr<CropCord>>::iterator _itr;
     std::shared_ptr<Graph> _graph = nullptr;
     std::shared_ptr<CropCordBatch> _output;
-    SeededRNG<std::mt19937, 4> _rngs;  // setting the state_size to 4 for 4 random parameters.
-    size_t _sample_cnt;
+    std::atomic<uint64_t> _epoch = {0};  // Incremented by release() on every reset, selects the crop streams of the epoch
 };
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <variant>
 
 #include "pipeline/commons.h"
+#include "meta_data/flat_meta_data_store.h"
 #include "meta_data/meta_data.h"
 #include "meta_data/meta_data_reader.h"
 
@@ -42,21 +43,19 @@ class TFMetaDataReaderDetection : public MetaDataReader {
     void print_map_contents();
     bool set_timestamp_mode() override { return false; }
 
-    const std::map<std::string, std::shared_ptr<MetaData>> &get_map_content() override { return _map_content; }
+    const std::map<std::string, std::shared_ptr<MetaData>> &get_map_content() override;
     TFMetaDataReaderDetection();
 
    private:
     void read_files(const std::string &_path);
     bool exists(const std::string &image_name) override;
-    // bbox add
-    void add(std::string image_name, BoundingBoxCords bbox, Labels labels, ImgSize image_size);
     bool _last_rec;
     void read_record(std::ifstream &file_contents, uint file_size, std::vector<std::string> &image_name,
                      std::string user_label_key, std::string user_text_key,
                      std::string user_xmin_key, std::string user_ymin_key, std::string user_xmax_key, std::string user_ymax_key,
                      std::string user_filename_key);  // std::map<std::string, std::shared_ptr<Label>> _map_content;
-    std::map<std::string, std::shared_ptr<MetaData>> _map_content;
-    std::map<std::string, std::shared_ptr<MetaData>>::iterator _itr;
+    FlatMetaDataStore _store;                                        //!< Boxes of all the images, lookup() copies from it
+    std::map<std::string, std::shared_ptr<MetaData>> _map_content;   //!< Per image objects, only built when get_map_content() is called
     std::string _path;
     pMetaDataBatch _output;
     DIR *_src_dir;
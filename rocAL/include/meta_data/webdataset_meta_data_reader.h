@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "pipeline/filesystem.h"
 #include "readers/image/image_reader.h"
 #include "helpers/tar_helper_functions.h"
+#include "pipeline/thread_pool.h"
 #include <unordered_map>
 
 class WebDataSetMetaDataReader : public MetaDataReader {
@@ -58,18 +59,6 @@ class WebDataSetMetaDataReader : public MetaDataReader {
     struct dirent *_entity = nullptr;
     std::vector<std::set<std::string>> _exts;
     std::unordered_map<std::string, uint> _ext_map;
-    void parse_tar_files(std::vector<SampleDescription> &samples_container,
-                         std::vector<ComponentDescription> &components_container,
-                         std::unique_ptr<std::ifstream> &tar_file);
-    void parse_index_files(std::vector<SampleDescription> &samples_container,
-                           std::vector<ComponentDescription> &components_container,
-                           const std::string &paths_to_index_files);
-    void parse_sample_description(
-        std::vector<SampleDescription> &samples_container,
-        std::vector<ComponentDescription> &components_container,
-        std::ifstream &index_file, const std::string &index_path, int64_t line,
-        int index_version);
     void add(std::string image_name, AsciiValues ascii_value);
-    std::vector<std::unique_ptr<std::ifstream>> _wds_shards;
 };
 #endif
@@ -22,9 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 #include <algorithm>  // std::remove_if
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <numeric>  // std::inner_product, std::accumulate
 #include <random>
 #include <stdexcept>
@@ -32,12 +35,17 @@ THE SOFTWARE.
 #include <variant>
 #include <vector>
 
+#include "pipeline/commons.h"
 #include "pipeline/log.h"
 #include "parameters/parameter.h"
+// Random parameters draw from counter based streams: value i of the n-th renewal only depends on (seed, n, i),
+// so a given seed reproduces the same values whatever the batch size or the order the parameters are renewed in
 template <typename T>
 class UniformRand : public Parameter<T> {
+    static_assert(sizeof(T) <= sizeof(uint32_t), "UniformRand packs its range in a single atomic word");
+
    public:
-    UniformRand(T start, T end, unsigned seed = 0) : _generator(seed) {
+    UniformRand(T start, T end, unsigned seed = 0) : _seed(seed) {
         update(start, end);
         renew();
     }
@@ -45,7 +53,8 @@ class UniformRand : public Parameter<T> {
     explicit UniformRand(T start, unsigned seed = 0) : UniformRand(start, start, seed) {}
 
     T default_value() const override {
-        return static_cast<T>((_start + _end) / static_cast<T>(2));
+        auto [start, end] = range();
+        return static_cast<T>((start + end) / static_cast<T>(2));
     }
 
     T get() override {
@@ -57,24 +66,25 @@ class UniformRand : public Parameter<T> {
     }
 
     void renew_value() {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto val = _generator();
-
-        if (single_value()) {
-            // If there is only a single value possible for the random variable
-            // don't waste time on calling the rand function , just return it.
-            _updated_val = _start;
-        } else {
-            _updated_val = static_cast<T>(
-                ((double)val / (double)_generator.max()) * ((double)_end - (double)_start) + (double)_start);
-        }
+        auto [start, end] = range();
+        auto key = CounterRNG::stream_key(_seed, _renew_count++);
+        // If there is only a single value possible for the random variable
+        // don't waste time on calling the rand function , just return it.
+        _updated_val = (start == end) ? start : scale(CounterRNG::at(key, 0), step(start, end), start);
     }
 
     void renew_array() {
-        for (uint i = 0; i < _size; i++) {
-            renew_value();
-            _param_values[i] = _updated_val;
+        auto [start, end] = range();
+        auto key = CounterRNG::stream_key(_seed, _renew_count++);
+        T *values = _param_values.data();
+        if (start == end) {
+            std::fill_n(values, _size, start);
+            return;
         }
+        // Every value is computed independently of the others, the loop vectorizes
+        double value_step = step(start, end);
+        for (uint i = 0; i < _size; i++)
+            values[i] = scale(CounterRNG::at(key, i), value_step, start);
     }
 
     void renew() override {
@@ -85,12 +95,10 @@ class UniformRand : public Parameter<T> {
         }
     }
     int update(T start, T end) {
-        std::unique_lock<std::mutex> lock(_lock);
         if (end < start)
             end = start;
-
-        _start = start;
-        _end = end;
+        // Both ends are published at once, a concurrent renew sees either the old or the new range
+        _range.store(pack(start, end), std::memory_order_release);
         return 0;
     }
 
@@ -102,17 +110,34 @@ class UniformRand : public Parameter<T> {
     }
 
     bool single_value() const override {
-        return (_start == _end);
+        auto [start, end] = range();
+        return (start == end);
     }
 
    private:
-    T _start;
-    T _end;
+    // Maps the 32 bit random numbers uniformly onto [start, end]
+    static double step(T start, T end) { return ((double)end - (double)start) / (double)UINT32_MAX; }
+    static T scale(uint32_t val, double step, T start) { return static_cast<T>((double)val * step + (double)start); }
+    static uint64_t pack(T start, T end) {
+        uint32_t words[2] = {0, 0};
+        memcpy(&words[0], &start, sizeof(T));
+        memcpy(&words[1], &end, sizeof(T));
+        return (static_cast<uint64_t>(words[1]) << 32) | words[0];
+    }
+    std::pair<T, T> range() const {
+        uint64_t packed = _range.load(std::memory_order_acquire);
+        uint32_t words[2] = {static_cast<uint32_t>(packed), static_cast<uint32_t>(packed >> 32)};
+        T start, end;
+        memcpy(&start, &words[0], sizeof(T));
+        memcpy(&end, &words[1], sizeof(T));
+        return {start, end};
+    }
+    std::atomic<uint64_t> _range;          // start and end of the range packed in one word
     T _updated_val;
     std::vector<T> _param_values;
-    std::mt19937 _generator;
-    std::mutex _lock;
-    unsigned _size;
+    uint64_t _seed;
+    std::atomic<uint64_t> _renew_count = {0};  // Selects the stream of the next renewal
+    unsigned _size = 0;
 };
 
 template <typename T>
@@ -120,7 +145,7 @@ struct CustomRand : public Parameter<T> {
     CustomRand(
         const T values[],
         const double frequencies[],
-        size_t size, unsigned seed = 0) : _generator(seed) {
+        size_t size, unsigned seed = 0) : _seed(seed) {
         update(values, frequencies, size);
         renew();
     }
@@ -175,29 +200,15 @@ struct CustomRand : public Parameter<T> {
 
     void renew_value() {
         std::unique_lock<std::mutex> lock(_lock);
-        if (single_value()) {
-            // If there is only a single value possible for the random variable
-            // don't waste time on calling the rand function , just return it.
-            _updated_val = _values[0];
-        } else {
-            // Generate a value between [0 1]
-            double rand_val = (double)_generator() / (double)_generator.max();
-
-            // Find the iterators pointing to the first element bigger than idx
-            auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
-
-            // Get the index and return the associated value
-            unsigned idx = std::distance(_comltv_dist.begin(), it);
-
-            _updated_val = _values[idx];
-        }
+        _updated_val = draw(CounterRNG::stream_key(_seed, _renew_count++), 0);
     }
 
     void renew_array() {
-        for (uint i = 0; i < _size; i++) {
-            renew_value();
-            _param_values[i] = _updated_val;
-        }
+        // The values can only change through update(), a single lock covers the whole array
+        std::unique_lock<std::mutex> lock(_lock);
+        auto key = CounterRNG::stream_key(_seed, _renew_count++);
+        for (uint i = 0; i < _size; i++)
+            _param_values[i] = draw(key, i);
     }
 
     void renew() override {
@@ -227,13 +238,29 @@ struct CustomRand : public Parameter<T> {
     }
 
    private:
+    T draw(uint64_t key, uint64_t idx) const {
+        // If there is only a single value possible for the random variable
+        // don't waste time on calling the rand function , just return it.
+        if (single_value())
+            return _values[0];
+        // Generate a value between [0 1]
+        double rand_val = (double)CounterRNG::at(key, idx) / (double)UINT32_MAX;
+
+        // Find the iterators pointing to the first element bigger than idx
+        auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
+
+        // Get the index and return the associated value
+        unsigned value_idx = std::min<size_t>(std::distance(_comltv_dist.begin(), it), _values.size() - 1);
+        return _values[value_idx];
+    }
     std::vector<T> _values;            //!< Values
     std::vector<double> _frequencies;  //!< Probabilities
     std::vector<double> _comltv_dist;  //!< commulative probabilities
     double _mean;
     T _updated_val;
     std::vector<T> _param_values;  //!< The values will be used in parameter_vx.h file after renewing
-    std::mt19937 _generator;
+    uint64_t _seed;
+    uint64_t _renew_count = 0;     //!< Selects the stream of the next renewal
     std::mutex _lock;
-    unsigned _size;
+    unsigned _size = 0;
 };
\ No newline at end of file
@@ -28,7 +28,9 @@ THE SOFTWARE.
  */
 
 #pragma once
+#include <cstdint>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "pipeline/exception.h"
@@ -148,11 +150,20 @@ struct Timing {
     // The following timings are accumulated timing not just the most recent activity
     long long unsigned read_time = 0;
     long long unsigned decode_time = 0;
+    long long unsigned file_read_time = 0;  // Time spent by the I/O workers reading files, overlaps with decode_time
+    long long unsigned read_wait_time = 0;  // Time the decode threads were blocked waiting for a file read to complete
+    long long unsigned compressed_buffer_size = 0;  // Bytes currently held by the loaders for the compressed files of a batch
+    long long unsigned peak_rss = 0;                // Peak resident set size of the process in bytes
     long long unsigned to_device_xfer_time = 0;
     long long unsigned from_device_xfer_time = 0;
     long long unsigned copy_to_output = 0;
     long long unsigned process_time = 0;
     long long unsigned bb_process_time = 0;
+    long long unsigned bb_stage_stall_time = 0;  // Time the processing thread was blocked because the box encode stage queue was full
+    long long unsigned bb_stage_idle_time = 0;   // Time the box encode stage waited for a processed batch
+    long long unsigned bb_stage_max_occupancy = 0;  // Highest number of batches seen queued for the box encode stage
+    long long unsigned bb_stage_occupancy_sum = 0;  // Sum of the number of batches queued for the box encode stage, sampled once per batch
+    long long unsigned bb_stage_batches = 0;        // Number of batches that went through the box encode stage
     long long unsigned mask_process_time = 0;
     long long unsigned label_load_time = 0;
     long long unsigned bb_load_time = 0;
@@ -208,6 +219,52 @@ class BatchRNG {
     std::vector<RNG> _rngs;
 };
 
+/**
+ * @brief Counter based generator, the n-th number of a stream is a hash of (key, n)
+ *
+ * Streams are identified by up to three values, e.g. seed, epoch and sample, and do not depend on the
+ * order in which they are created or consumed, so samples can draw their numbers from any thread.
+ * Satisfies UniformRandomBitGenerator and can be used with the standard distributions.
+ */
+class CounterRNG {
+   public:
+    using result_type = uint32_t;
+    CounterRNG(uint64_t seed, uint64_t stream = 0, uint64_t substream = 0)
+        : _key(stream_key(seed, stream, substream)) {}
+
+    result_type operator()() noexcept { return at(_key, _counter++); }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    //! Key of the stream, lets callers draw numbers directly with at() without keeping a generator
+    static uint64_t stream_key(uint64_t seed, uint64_t stream = 0, uint64_t substream = 0) noexcept {
+        return mix(mix(mix(seed) ^ stream) ^ substream);
+    }
+
+    //! n-th number of the stream, independent of the other numbers so whole arrays can be filled in one vectorizable loop
+    static result_type at(uint64_t key, uint64_t n) noexcept { return static_cast<result_type>(mix(key + GOLDEN_GAMMA * (n + 1)) >> 32); }
+
+    //! splitmix64 finalizer
+    static uint64_t mix(uint64_t x) noexcept {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    //! FNV-1a hash of a string, stable across platforms unlike std::hash
+    static uint64_t hash(const std::string &str) noexcept {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : str)
+            h = (h ^ c) * 0x100000001b3ULL;
+        return h;
+    }
+
+   private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+    uint64_t _key;
+    uint64_t _counter = 0;
+};
+
 /*! \brief MissingComponentsBehaviour for Webdataset
  *
  */
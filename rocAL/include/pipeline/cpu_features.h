@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+/*! \brief Instruction set levels the SIMD kernels are built for, every level includes the previous ones
+ *
+ * The library is built for the x86-64 baseline, the kernels of the higher levels are compiled with the SIMD_TARGET_*
+ * function attributes and picked at runtime with cpu_isa_level().
+ */
+enum class CpuIsaLevel {
+    SCALAR = 0,
+    SSE42,   // SSE4.2, with SSSE3 and SSE4.1
+    AVX2,    // AVX2, FMA and F16C
+    AVX512   // AVX-512F
+};
+
+//! Level of the SIMD kernels used by the process
+/*!
+The highest level supported by the CPU, detected with cpuid on first use. The ROCAL_CPU_ISA environment variable
+(scalar, sse4.2, avx2 or avx512) lowers it to compare the kernels, a level the CPU does not support is ignored.
+*/
+CpuIsaLevel cpu_isa_level();
+//! Highest level supported by the CPU
+CpuIsaLevel cpu_detected_isa_level();
+const char *cpu_isa_name(CpuIsaLevel level);
+
+#if ENABLE_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#define SIMD_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma,f16c")))
+#else
+#define SIMD_X86 0
+#endif
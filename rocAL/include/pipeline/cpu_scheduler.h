@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "pipeline/thread_pool.h"
+
+/*! \brief Process wide owner of the CPU worker threads
+ *
+ * All the pipelines of the process run their CPU stages (decoding, meta data processing) on pools handed out by the scheduler.
+ * Pipelines restricted to the same CPUs share one pool, a pool is created on first use and destroyed with its last pipeline.
+ * The core budget bounds the workers of each pool, not of the process: the pipelines of one CPU set stay within the budget
+ * however many of them are created, while pipelines pinned to different CPU sets (e.g. one per NUMA node) each get a pool of their own.
+ */
+class CpuScheduler {
+   public:
+    static CpuScheduler &instance();
+
+    //! Sets the number of worker threads of each pool created afterwards, 0 selects the number of physical cores
+    void set_core_budget(size_t core_budget);
+    size_t core_budget();
+
+    //! Registers a pipeline running on the given CPUs and returns the pool it shares with the other pipelines on them
+    /*!
+    \param cpu_ids CPUs the workers are pinned to, one worker per CPU up to the core budget. The workers are not pinned if empty
+    */
+    std::shared_ptr<ThreadPool> acquire_pool(const std::vector<unsigned> &cpu_ids);
+    //! Unregisters a pipeline added with acquire_pool()
+    void release_pool(const std::vector<unsigned> &cpu_ids);
+    //! Returns the number of threads a pipeline on the given CPUs gets when the workers are split evenly between the pipelines sharing them
+    size_t pipeline_thread_share(const std::vector<unsigned> &cpu_ids);
+
+    //! Returns the CPUs of the NUMA node, empty if the node does not exist
+    static std::vector<unsigned> numa_node_cpus(int numa_node);
+
+   private:
+    CpuScheduler() = default;
+    size_t default_core_count();
+    struct SharedPool {
+        std::shared_ptr<ThreadPool> pool;
+        size_t pipelines = 0;
+    };
+    std::mutex _lock;
+    size_t _core_budget = 0;
+    std::map<std::vector<unsigned>, SharedPool> _pools;  // Pool of each CPU set in use, keyed by the sorted CPU ids
+};
@@ -21,11 +21,14 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <condition_variable>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <variant>
 
+#include "pipeline/cpu_scheduler.h"
 #include "pipeline/graph.h"
 #include "meta_data/meta_data_graph.h"
 #include "meta_data/meta_data_reader.h"
@@ -44,6 +47,7 @@ THE SOFTWARE.
 #include "loaders/audio/node_audio_loader.h"
 #include "loaders/audio/node_audio_loader_single_shard.h"
 #endif
+#include "pipeline/pipeline_stage.h"
 #include "pipeline/ring_buffer.h"
 #include "pipeline/timing_debug.h"
 #if ENABLE_HIP
@@ -60,25 +64,6 @@ THE SOFTWARE.
 #define MAX_RETINANET_ANCHORS 120087  // Num of bbox achors used in Retinanet training
 #define MAX_ASCII_BUFFER 200        // Max Number of ASCII characters that can be present in any particular extension file for webdataset reader
 
-#if ENABLE_SIMD
-#if _WIN32
-#include <intrin.h>
-#else
-#include <immintrin.h>
-#include <smmintrin.h>
-#include <x86intrin.h>
-#endif
-#endif
-
-#if (ENABLE_SIMD && __AVX2__)
-const __m256i avx_pkdMaskR = _mm256_setr_epi32(0x80808000, 0x80808003, 0x80808006, 0x80808009, 0x80808000,
-                                               0x80808003, 0x80808006, 0x80808009);
-const __m256i avx_pkdMaskG = _mm256_setr_epi32(0x80808001, 0x80808004, 0x80808007, 0x8080800A, 0x80808001,
-                                               0x80808004, 0x80808007, 0x8080800A);
-const __m256i avx_pkdMaskB = _mm256_setr_epi32(0x80808002, 0x80808005, 0x80808008, 0x8080800B, 0x80808002,
-                                               0x80808005, 0x80808008, 0x8080800B);
-#endif
-
 class MasterGraph {
    public:
     enum class Status { OK = 0,
@@ -86,7 +71,7 @@ class MasterGraph {
                         NO_MORE_DATA = 2,
                         NOT_IMPLEMENTED = 3,
                         INVALID_ARGUMENTS };
-    MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type);
+    MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type, bool deterministic_loader_order = false, const std::vector<unsigned> &cpu_affinity = {});
     ~MasterGraph();
     Status reset();
     size_t remaining_count();
@@ -96,6 +81,10 @@ class MasterGraph {
     Status copy_out_tensor_planar(void *out_ptr, RocalTensorlayout format, float multiplier0, float multiplier1, float multiplier2,
                                   float offset0, float offset1, float offset2, bool reverse_channels, RocalTensorDataType output_data_type);
     TensorList *get_output_tensors();
+    /// Makes the pipeline write the output straight into the given user owned buffers, one per prefetch queue slot, instead of its own ring buffer
+    void set_output_buffers(unsigned output_idx, const std::vector<void *> &buffers, size_t buffer_size);
+    /// Index of the buffer registered with set_output_buffers() that holds the batch of the last run(), -1 before the first run()
+    int output_buffer_index();
     size_t output_width();
     size_t output_height();
     void sequence_start_frame_number(std::vector<size_t> &sequence_start_framenum);             // Returns the starting frame number of the sequences
@@ -134,7 +123,10 @@ class MasterGraph {
     TensorList *mask_meta_data();
     TensorList *matched_index_meta_data();
     TensorListVector * ascii_values_meta_data(); // Gets the pointer to a batch of ASCII values of all samples in the batch
+    std::pair<void *, const std::vector<size_t> *> collated_meta_data(unsigned buffer_idx);  // Gets a metadata buffer of the batch and the offsets of the samples in it
     void set_loop(bool val) { _loop = val; }
+    void set_io_depth(size_t io_depth) { _io_depth = io_depth; }  // Number of file reads kept in flight by the image loaders added afterwards, 0 derives it from the cpu thread count
+    std::shared_ptr<ThreadPool> cpu_pool() { return _cpu_pool; }  // Pool of the CPU workers of the pipeline, shared with the pipelines on the same CPUs
     void set_output(Tensor *output_tensor);
     size_t calculate_cpu_num_threads(size_t shard_count);
     bool empty() { return (remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)); }
@@ -160,6 +152,7 @@ class MasterGraph {
     void create_multiple_graphs();
     void start_processing();
     void stop_processing();
+    void set_decode_size_hints();
     void output_routine();
     void output_routine_multiple_loaders();
     void decrease_image_count();
@@ -167,12 +160,30 @@ class MasterGraph {
     void notify_user_thread();
     /// no_more_processed_data() is logically linked to the notify_user_thread() and is used to tell the user they've already consumed all the processed tensors
     bool no_more_processed_data();
+    /// wait_for_loader_data() blocks the internal processing thread, once the loaders are out of data, until wake_output_routine() is called
+    void wait_for_loader_data();
+    /// wake_output_routine() is called on reset, stop or when new data is fed, so the internal processing thread reacts immediately
+    void wake_output_routine();
     // is_out_of_data() is called to check the remaining batch count from each loader module, if any of the loader module has consumed all the batches it returns true.
     bool is_out_of_data();
+    /// A batch processed by the graph whose box encoding / IoU matching and ring buffer push is left to the box encode stage
+    struct BoxEncodeJob {
+        size_t slot;  // ring buffer write slot reserved for the batch
+        ImageNameBatch names;
+        pMetaDataBatch meta_data;
+    };
+    /// box_encode_and_push() runs the box encoder / IoU matcher on the batch's meta data and publishes the batch in the ring buffer
+    void box_encode_and_push(BoxEncodeJob &job);
+    /// box_encode_routine() is the box encode stage, it finishes batch N while output_routine() loads and processes batch N+1
+    void box_encode_routine();
+    void stop_box_encode_stage();
     RingBuffer _ring_buffer;                                                      //!< The queue that keeps the tensors that have benn processed by the internal thread (_output_thread) asynchronous to the user's thread
     pMetaDataBatch _augmented_meta_data = nullptr;                                //!< The output of the meta_data_graph,
     std::shared_ptr<CropCordBatch> _random_bbox_crop_cords_data = nullptr;
     std::thread _output_thread;
+    std::thread _box_encode_thread;                                               //!< Runs box_encode_routine(), only started for CPU box encoder / IoU matcher pipelines
+    std::unique_ptr<PipelineStageQueue<BoxEncodeJob>> _box_encode_queue;          //!< Bounded queue of the batches waiting for the box encode stage
+    const static size_t BOX_ENCODE_STAGE_DEPTH = 2;
     TensorList _internal_tensor_list;                                             //!< Keeps a list of ovx tensors that are used to store the augmented outputs (there is an augmentation output batch per element in the list)
     TensorList _output_tensor_list;                                               //!< Keeps a list of ovx tensors(augmented outputs) that are to be passed to the user (there is an augmentation output batch per element in the list)
     std::list<Tensor *> _internal_tensors;                                        //!< Keeps all the ovx tensors (virtual/non-virtual) either intermediate tensors, or input tensors that feed the graph
@@ -199,6 +210,8 @@ class MasterGraph {
     std::vector<std::shared_ptr<Graph>> _graphs;                                  //!< Keeps a list of the Graph instances, a graph is created for each loader
     RocalAffinity _affinity;
     size_t _cpu_num_threads;                                                      //!< Defines the number of CPU threads used for processing
+    std::vector<unsigned> _cpu_affinity;                                          //!< CPUs the CPU stages of the pipeline are restricted to, any CPU if empty
+    std::shared_ptr<ThreadPool> _cpu_pool;                                        //!< Process wide pool of the CPUs in _cpu_affinity, runs the decoding and meta data processing
     const int _gpu_id;                                                            //!< Defines the device id used for processing
     pLoaderModule _loader_module;                                                 //!< Keeps the loader module used to feed the input the tensors of the graph
     std::vector<pLoaderModule> _loader_modules;                                   //!< Keeps the list of loader modules used to feed the input tensors of the graph
@@ -216,7 +229,12 @@ class MasterGraph {
     int _remaining_count;                                                         //!< Keeps the count of remaining tensors yet to be processed for the user,
     bool _loop;                                                                   //!< Indicates if user wants to indefinitely loops through tensors or not
     size_t _prefetch_queue_depth;
+    size_t _io_depth = 0;                                                         //!< Number of file reads kept in flight by each image loader shard, 0 lets the reader config derive it
+    bool _deterministic_loader_order;                                             //!< If true the loaders running several shards return the batches of the shards round robin instead of the first one completed
     bool _output_routine_finished_processing = false;
+    std::mutex _output_routine_lock;
+    std::condition_variable _output_routine_wakeup;                               //!< Signals the internal processing thread that the loaders may have data again or it has to stop
+    bool _output_routine_woken = false;
     bool _is_random_bbox_crop = false;
     std::vector<std::vector<size_t>> _sequence_start_framenum_vec;                //!< Stores the starting frame number of the sequences.
     std::vector<std::vector<std::vector<float>>> _sequence_frame_timestamps_vec;  //!< Stores the timestamps of the frames in a sequences.
@@ -225,6 +243,7 @@ class MasterGraph {
     // box encoder variables
     bool _is_box_encoder = false;                                                 // bool variable to set the box encoder
     std::vector<float> _anchors;                                                  // Anchors to be used for encoding, as the array of floats is in the ltrb format of size 8732x4
+    AnchorBoxStore _anchor_store;                                                 // SoA copy of _anchors used by the CPU box encoder and IoU matcher
     size_t _num_anchors;                                                          // number of bbox anchors
     float _criteria = 0.5;                                                        // Threshold IoU for matching bounding boxes with anchors. The value needs to be between 0 and 1.
     float _scale;                                                                 // Rescales the box and anchor values before the offset is calculated (for example, to return to the absolute values).
@@ -284,6 +303,9 @@ inline std::shared_ptr<ImageLoaderNode> MasterGraph::add_node(const std::vector<
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
+    loader_module->set_io_depth(_io_depth);
+    loader_module->set_deterministic_order(_deterministic_loader_order);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
@@ -302,6 +324,8 @@ inline std::shared_ptr<ImageLoaderSingleShardNode> MasterGraph::add_node(const s
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
+    loader_module->set_io_depth(_io_depth);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
@@ -320,6 +344,9 @@ inline std::shared_ptr<FusedJpegCropNode> MasterGraph::add_node(const std::vecto
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
+    loader_module->set_io_depth(_io_depth);
+    loader_module->set_deterministic_order(_deterministic_loader_order);
     loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
@@ -339,6 +366,8 @@ inline std::shared_ptr<FusedJpegCropSingleShardNode> MasterGraph::add_node(const
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
+    loader_module->set_io_depth(_io_depth);
     loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
@@ -442,6 +471,7 @@ template<> inline std::shared_ptr<AudioLoaderNode> MasterGraph::add_node(const s
 #endif
     auto loader_module = node->GetLoaderModule();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
@@ -459,6 +489,7 @@ template<> inline std::shared_ptr<AudioLoaderSingleShardNode> MasterGraph::add_n
 #endif
     auto loader_module = node->GetLoaderModule();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
@@ -481,6 +512,7 @@ inline std::shared_ptr<NumpyLoaderNode> MasterGraph::add_node(const std::vector<
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
@@ -499,6 +531,7 @@ inline std::shared_ptr<NumpyLoaderSingleShardNode> MasterGraph::add_node(const s
 #endif
     auto loader_module = node->get_loader_module();
     loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    loader_module->set_decode_pool(_cpu_pool);
     _loader_modules.emplace_back(loader_module);
     node->set_graph_id(_loaders_count++);
     _root_nodes.push_back(node);
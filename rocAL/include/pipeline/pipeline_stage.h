@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+
+/*! \brief Occupancy and stall counters of one stage of the processing pipeline
+ *
+ * Times are accumulated in microseconds since the stage was created.
+ */
+struct PipelineStageStats {
+    std::string name;
+    size_t capacity = 0;                             // Maximum number of batches queued for the stage
+    size_t max_occupancy = 0;                        // Highest number of batches seen queued for the stage
+    unsigned long long batches = 0;                  // Number of batches handed to the stage
+    unsigned long long occupancy_sum = 0;            // Queue level sampled after each hand-off, occupancy_sum / batches is the average occupancy
+    unsigned long long producer_stall_time = 0;      // Time the upstream stage was blocked because the queue was full
+    unsigned long long consumer_stall_time = 0;      // Time the stage was idle waiting for a batch
+};
+
+/*! \brief Bounded FIFO connecting two stages of the processing pipeline
+ *
+ * push() blocks the upstream stage while the queue is full and pop() blocks the stage while it is empty,
+ * both record the blocked time in the stage stats. close() releases every blocked call and drops the queued batches.
+ */
+template <typename T>
+class PipelineStageQueue {
+   public:
+    PipelineStageQueue(std::string name, size_t capacity) {
+        _stats.name = std::move(name);
+        _stats.capacity = capacity > 0 ? capacity : 1;
+    }
+
+    //! Blocks while the queue is full, returns false if the queue was closed and the item is dropped
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(_lock);
+        if (_items.size() >= _stats.capacity && !_closed) {
+            auto t_start = std::chrono::high_resolution_clock::now();
+            _not_full.wait(lock, [this] { return _items.size() < _stats.capacity || _closed; });
+            _stats.producer_stall_time += elapsed_us(t_start);
+        }
+        if (_closed)
+            return false;
+        _items.push(std::move(item));
+        _pending++;
+        _stats.batches++;
+        _stats.occupancy_sum += _items.size();
+        _stats.max_occupancy = std::max(_stats.max_occupancy, _items.size());
+        lock.unlock();
+        _not_empty.notify_one();
+        return true;
+    }
+
+    //! Blocks while the queue is empty, returns false once the queue is closed
+    bool pop(T &item) {
+        std::unique_lock<std::mutex> lock(_lock);
+        if (_items.empty() && !_closed) {
+            auto t_start = std::chrono::high_resolution_clock::now();
+            _not_empty.wait(lock, [this] { return !_items.empty() || _closed; });
+            _stats.consumer_stall_time += elapsed_us(t_start);
+        }
+        if (_closed)
+            return false;
+        item = std::move(_items.front());
+        _items.pop();
+        lock.unlock();
+        _not_full.notify_one();
+        return true;
+    }
+
+    //! Called by the stage once it is completely done with a batch returned by pop()
+    void task_done() {
+        std::unique_lock<std::mutex> lock(_lock);
+        if (_pending > 0)
+            _pending--;
+        if (_pending == 0) {
+            lock.unlock();
+            _drained.notify_all();
+        }
+    }
+
+    //! Blocks until every pushed batch is done or the queue is closed
+    void wait_until_drained() {
+        std::unique_lock<std::mutex> lock(_lock);
+        _drained.wait(lock, [this] { return _pending == 0 || _closed; });
+    }
+
+    void close() {
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _closed = true;
+            std::queue<T>().swap(_items);
+            _pending = 0;
+        }
+        _not_empty.notify_all();
+        _not_full.notify_all();
+        _drained.notify_all();
+    }
+
+    //! Makes a closed queue usable again, the stats are kept
+    void reopen() {
+        std::unique_lock<std::mutex> lock(_lock);
+        _closed = false;
+    }
+
+    PipelineStageStats stats() {
+        std::unique_lock<std::mutex> lock(_lock);
+        return _stats;
+    }
+
+   private:
+    static unsigned long long elapsed_us(std::chrono::high_resolution_clock::time_point t_start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t_start).count();
+    }
+    std::queue<T> _items;
+    std::mutex _lock;
+    std::condition_variable _not_empty, _not_full, _drained;
+    size_t _pending = 0;  //!< Batches pushed and not yet marked done by the stage
+    bool _closed = false;
+    PipelineStageStats _stats;
+};
@@ -21,7 +21,9 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <vector>
 
 #if ENABLE_OPENCL
@@ -35,6 +37,17 @@ THE SOFTWARE.
 #include "meta_data/meta_data.h"
 
 using MetaDataNamePair = std::pair<ImageNameBatch, pMetaDataBatch>;
+class RingBuffer;
+
+/// Leases taken on the slots of a RingBuffer, shared with the lease handles so that they can be released after the ring buffer is destroyed
+struct RingBufferLeases {
+    explicit RingBufferLeases(size_t depth) : count(depth), orphaned(depth) {}
+    std::mutex lock;                            //!< Guards owner and orphaned
+    RingBuffer *owner = nullptr;                //!< Null once the ring buffer is destroyed
+    std::vector<std::atomic<unsigned>> count;   //!< Outstanding leases of each slot
+    std::vector<std::vector<void *>> orphaned;  //!< Host buffers of the slots still leased when the ring buffer was destroyed, freed with the last lease
+};
+
 class RingBuffer {
    public:
     explicit RingBuffer(unsigned buffer_depth);
@@ -48,16 +61,32 @@ class RingBuffer {
     void init(RocalMemType mem_type, void *dev, std::vector<size_t> &sub_buffer_size, std::vector<size_t> &roi_buffer_size);
     void initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bbox_size, size_t encoded_labels_size);
     void init_metadata(RocalMemType mem_type, std::vector<size_t> &sub_buffer_size);
+    /// Makes init() use the given user owned buffers, one per slot, for the sub buffer instead of allocating them, has to be called before init()
+    /// The buffers have to be in the memory init() allocates for the mem type and are never freed by the ring buffer
+    void set_external_sub_buffers(size_t sub_buffer_idx, const std::vector<void *> &buffers);
     void release_gpu_res();
     std::pair<std::vector<void *>, std::vector<unsigned *>> get_read_buffers();
     std::pair<std::vector<void *>, std::vector<unsigned *>> get_write_buffers();
+    std::pair<std::vector<void *>, std::vector<unsigned *>> get_write_buffers(size_t slot);
     std::pair<void *, void *> get_box_encode_write_buffers();
+    std::pair<void *, void *> get_box_encode_write_buffers(size_t slot);
     std::pair<void *, void *> get_box_encode_read_buffers();
     MetaDataNamePair &get_meta_data();
     std::vector<void *> get_meta_read_buffers();
     std::vector<void *> get_meta_write_buffers();
+    std::vector<void *> get_meta_write_buffers(size_t slot);
     void set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data);
+    void set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data, size_t slot);
     void rellocate_meta_data_buffer(void *buffer, size_t buffer_size, unsigned buff_idx);
+    /// Reserves the next free write slot ahead of the push() that publishes it, blocks while every free slot is already reserved
+    /// Lets one stage of the processing thread fill slot N+1 while a later stage still completes slot N, push() always publishes the slots in reservation order
+    size_t reserve_write_slot();
+    /// Slot returned by get_read_buffers() until the next pop()
+    size_t read_slot() { return _read_ptr; }
+    unsigned depth() { return BUFF_DEPTH; }
+    /// Keeps the writer from overwriting the slot until the returned handle and all its copies are released, the writer blocks on it instead
+    /// Used to hand the output buffers to other frameworks without a copy, the leases held at once have to stay below the depth of the buffer
+    std::shared_ptr<void> lease(size_t slot);
     void reset();
     void pop();
     void push();
@@ -74,7 +103,12 @@ class RingBuffer {
     MetaDataNamePair _last_image_meta_data;
     void increment_read_ptr();
     void increment_write_ptr();
+    void rellocate_meta_data_buffer(void *buffer, size_t buffer_size, unsigned buff_idx, size_t slot);
     bool full();
+    /// Blocks the writer while there is no free slot or the slot it writes next is leased, returns early if unblock_writer() is called meanwhile
+    void wait_for_write_slot(std::unique_lock<std::mutex> &lock, size_t slot, size_t reserved);
+    void notify_lease_released();
+    bool is_external(size_t sub_buffer_idx) { return sub_buffer_idx < _external_sub_buffers.size() && !_external_sub_buffers[sub_buffer_idx].empty(); }
     const unsigned BUFF_DEPTH;
     std::vector<size_t> _sub_buffer_size;
     std::vector<std::vector<size_t>> _meta_data_sub_buffer_size;
@@ -84,6 +118,7 @@ class RingBuffer {
     std::condition_variable _wait_for_unload;
     std::vector<std::vector<void *>> _dev_sub_buffer;
     std::vector<std::vector<void *>> _host_sub_buffers;
+    std::vector<std::vector<void *>> _external_sub_buffers;  //!< User owned buffers of each sub buffer indexed by slot, empty for the sub buffers the ring buffer allocates
     std::vector<std::vector<unsigned *>> _dev_roi_buffers;
     std::vector<std::vector<unsigned *>> _host_roi_buffers;
     std::vector<std::vector<void *>> _host_meta_data_buffers;
@@ -95,6 +130,9 @@ class RingBuffer {
     size_t _write_ptr;
     size_t _read_ptr;
     size_t _level;
+    size_t _reserved;  //!< Number of slots handed out by reserve_write_slot() that are not pushed yet
+    size_t _writer_unblock_count = 0;  //!< Incremented by unblock_writer(), tells a waiting writer to return even if the slot is still unavailable
+    std::shared_ptr<RingBufferLeases> _leases;
     std::mutex _names_buff_lock;
     const size_t MEM_ALIGNMENT = 256;
     bool _box_encoder = false;
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include <array>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -284,6 +285,11 @@ class TensorInfo {
     void set_roi_ptr(unsigned* roi_ptr) { _roi.reset_ptr(roi_ptr); }
     void copy_roi(void* roi_buffer) { _roi.copy(roi_buffer); }
     std::shared_ptr<std::vector<float>> get_sample_rates() const { return _sample_rates; }  //!< The number of samples of audio carried per second
+    //! Packs the samples in the copy_data() destination, each one taking the bytes of its ROI only. The buffers of the pipeline keep the max shape slots
+    void set_packed(bool packed);
+    bool is_packed() const { return _is_packed; }
+    //! Offsets of the samples in the copied out batch derived from their ROI, the last entry is the size of the batch
+    std::vector<size_t> sample_offsets();
 
    private:
     Type _type = Type::UNKNOWN;                                  //!< tensor type, whether is virtual tensor, created from handle or is a regular tensor
@@ -304,6 +310,7 @@ class TensorInfo {
     void reallocate_tensor_sample_rate_buffers(); //!< Reallocating the sample_rate buffer
     bool _is_image = false;
     bool _is_metadata = false;
+    bool _is_packed = false;  //!< The samples are copied out back to back using their ROI size instead of the max shape
     size_t _channels = 3;  //!< stores the channel dimensions in the tensor
     std::shared_ptr<std::vector<float>> _sample_rates;  //!< Stores the sample rates for the audio
 };
@@ -378,13 +385,27 @@ class Tensor : public rocalTensor {
         return (_info.mem_type() == RocalMemType::HOST ? ROCAL_CPU : ROCAL_GPU);
     }
     uint64_t data_type_size() override { return _info.data_type_size(); }
+    void set_packed(bool packed) override { _info.set_packed(packed); }
+    bool is_packed() override { return _info.is_packed(); }
+    std::vector<size_t> sample_offsets() override { return _info.sample_offsets(); }
+    std::shared_ptr<void> lease() override { return _lease_provider ? _lease_provider() : nullptr; }
+    //! Set on the output tensors along with their buffer, leases the ring buffer slot the buffer belongs to
+    void set_lease_provider(std::function<std::shared_ptr<void>()> lease_provider) { _lease_provider = std::move(lease_provider); }
 
    private:
+    //! Copies the ROI of every sample to its packed offset in user_buffer
+#if ENABLE_HIP
+    //! The device copies are queued on stream if given, the caller synchronizes it
+    unsigned copy_packed_data(void* user_buffer, RocalOutputMemType external_mem_type, hipStream_t stream = nullptr);
+#else
+    unsigned copy_packed_data(void* user_buffer, RocalOutputMemType external_mem_type);
+#endif
     vx_tensor _vx_handle = nullptr;  //!< The OpenVX tensor
     void* _mem_handle = nullptr;     //!< Pointer to the tensor's internal buffer (opencl or host)
     TensorInfo _info;                //!< The structure holding the info related to the stored OpenVX tensor
     vx_context _context = nullptr;
     vx_tensor _vx_roi_handle = nullptr;  //!< The OpenVX tensor for ROI
+    std::function<std::shared_ptr<void>()> _lease_provider;
 };
 
 /*! \brief Contains a list of rocalTensors */
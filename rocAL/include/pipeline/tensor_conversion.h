@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "pipeline/commons.h"
+
+/*! \brief Conversion of the uint8 host images to the normalized FP32/FP16 tensors returned by rocalToTensor
+ *
+ * Every output value is in * multiplier[channel] + offset[channel], where channel is the index of the output channel.
+ * The kernels are built for the SSE4.2 (FP32 only), AVX2 and AVX-512 levels and picked with cpu_isa_level(), the
+ * scalar loops handle the remaining cases (channel counts other than 1 and 3, FP16 below AVX2, scalar level).
+ */
+struct TensorConversionParams {
+    RocalTensorlayout layout = RocalTensorlayout::NCHW;     // NHWC or NCHW
+    RocalTensorDataType data_type = RocalTensorDataType::FP32;  // FP32 or FP16
+    float multiplier[3] = {1, 1, 1};
+    float offset[3] = {0, 0, 0};
+    bool reverse_channels = false;  // Output channel k is taken from the input channel c - k - 1
+};
+
+//! Converts one interleaved (HWC) image to the packed output tensor of the image
+/*!
+\param in First pixel of the image
+\param row_stride Distance in bytes between two input rows, the output rows are packed
+\param height Number of rows converted
+\param width Number of pixels converted per row
+\param channels Number of channels of the image
+\param out First element of the output image, float or half depending on the data type of the params
+*/
+void convert_interleaved_image(const uint8_t *in, size_t row_stride, size_t height, size_t width, size_t channels,
+                               void *out, const TensorConversionParams &params);
+
+//! Converts one planar (CHW) image of packed planes to the packed output tensor of the image
+void convert_planar_image(const uint8_t *in, size_t height, size_t width, size_t channels, void *out,
+                          const TensorConversionParams &params);
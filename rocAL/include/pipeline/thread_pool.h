@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/*! \brief Fixed size pool of worker threads
+ *
+ * Jobs are executed in submission order by whichever worker becomes free first.
+ * The returned future is signalled once the job has run.
+ */
+class ThreadPool {
+   public:
+    //! Constructor
+    /*!
+    \param num_threads Number of worker threads, at least one worker is always created
+    \param cpu_ids CPUs the workers are pinned to, worker i runs on cpu_ids[i % cpu_ids.size()]. The workers are not pinned if empty
+    */
+    explicit ThreadPool(size_t num_threads, const std::vector<unsigned> &cpu_ids = {});
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    //! Queues the job for execution and returns a future signalled when it completes
+    std::shared_future<void> submit(std::function<void()> job);
+
+    //! Blocks the caller until all the queued jobs are executed
+    void wait_all();
+
+    //! Calls body(idx, slot) for every idx in [0, count) and returns once all the calls completed
+    /*!
+    The caller executes indices as well, so the loop progresses even when the workers are busy with the jobs of other users of the pool,
+    and a parallel_for issued from within a job cannot deadlock. Idle workers claim the next index one at a time.
+    \param slot Identifies the executing thread among the at most max_slots() concurrent ones, for per thread scratch buffers
+    \param max_parallelism Maximum number of threads executing the loop including the caller, 0 allows all the workers
+    The first exception thrown by body is rethrown once all the calls completed
+    */
+    void parallel_for(size_t count, const std::function<void(size_t idx, size_t slot)> &body, size_t max_parallelism = 0);
+
+    size_t num_threads() { return _workers.size(); }
+    size_t max_slots() { return _workers.size() + 1; }
+
+    //! Restricts the thread to the given CPUs, does nothing if cpu_ids is empty
+    static void set_thread_affinity(std::thread &thread, const std::vector<unsigned> &cpu_ids);
+
+   private:
+    void run();
+    std::vector<std::thread> _workers;
+    std::queue<std::packaged_task<void()>> _jobs;
+    std::mutex _lock;
+    std::condition_variable _job_available, _all_done;
+    size_t _jobs_in_flight = 0;
+    bool _stop = false;
+};
@@ -50,6 +50,14 @@ class FileSourceReader : public Reader {
     */
     size_t open() override;
 
+    //! Advances to the next file in the folder without opening it
+    /*!
+     \return The path of the next file
+    */
+    std::string next_file_path() override;
+
+    bool supports_path_read() override { return true; }
+
     //! Resets the object's state to read from the first file in the folder
     void reset() override;
 
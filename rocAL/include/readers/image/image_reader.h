@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <algorithm>
 #include <map>
 #include <string>
 #include <tuple>
@@ -110,9 +111,26 @@ struct ReaderConfig {
     }
     void set_files_list(const std::vector<std::string> &files) { _file_names = files; }
     void set_seed(unsigned seed) { _seed = seed; }
+    /// \param io_depth Number of file reads kept in flight by the loader, 0 picks twice the cpu_num_threads and 1 reads the files serially
+    void set_io_depth(size_t io_depth) { _io_depth = io_depth; }
+    /// \param shuffle_buffer_size WebDataset reader only, 0 reads every sample at its offset, otherwise the tar files are streamed sequentially and the samples shuffled within a window of this size
+    void set_shuffle_buffer_size(size_t shuffle_buffer_size) { _shuffle_buffer_size = shuffle_buffer_size; }
+    /// \param max_open_files WebDataset reader only, number of tar files kept open at once, 0 picks the reader's default
+    void set_max_open_files(size_t max_open_files) { _max_open_files = max_open_files; }
+    /// \param roi_start Numpy reader only, first element of the region read from every array, empty reads from the start of each dimension
+    /// \param roi_shape Numpy reader only, extent of the region read from every array, empty or 0 reads up to the end of the dimension
+    void set_numpy_roi(const std::vector<unsigned> &roi_start, const std::vector<unsigned> &roi_shape) {
+        _numpy_roi_start = roi_start;
+        _numpy_roi_shape = roi_shape;
+    }
     size_t get_shard_count() { return _shard_count; }
     size_t get_shard_id() { return _shard_id; }
     size_t get_cpu_num_threads() { return _cpu_num_threads; }
+    size_t get_io_depth() { return _io_depth ? _io_depth : 2 * _cpu_num_threads; }
+    size_t get_shuffle_buffer_size() { return _shuffle_buffer_size; }
+    size_t get_max_open_files() { return _max_open_files; }
+    const std::vector<unsigned> &get_numpy_roi_start() { return _numpy_roi_start; }
+    const std::vector<unsigned> &get_numpy_roi_shape() { return _numpy_roi_shape; }
     size_t get_batch_size() { return _batch_count; }
     size_t get_sequence_length() { return _sequence_length; }
     size_t get_frame_step() { return _sequence_frame_step; }
@@ -143,6 +161,10 @@ struct ReaderConfig {
     size_t _shard_count = 1;
     size_t _shard_id = 0;
     size_t _cpu_num_threads = 1;
+    size_t _io_depth = 0;         //!< Number of concurrent file reads issued by the loader, 0 means derived from _cpu_num_threads
+    size_t _shuffle_buffer_size = 0;  //!< Streaming window of the WebDataset reader, 0 disables streaming
+    size_t _max_open_files = 0;       //!< Cap on the tar files the WebDataset reader keeps open
+    std::vector<unsigned> _numpy_roi_start, _numpy_roi_shape;  //!< Region of the numpy arrays read by the numpy reader, empty reads the whole arrays
     size_t _batch_count = 1;      //!< The reader will repeat images if necessary to be able to have images in multiples of the _batch_count.
     size_t _sequence_length = 1;  // Video reader module sequence length
     size_t _sequence_frame_step;
@@ -195,6 +217,18 @@ struct NumpyHeaderData {
     
     // Returns the shape of the numpy array
     std::vector<unsigned> shape() const { return array_shape; }
+
+    // Clamps the region given by roi_start and roi_shape to the array, missing or 0 extents select up to the end of the dimension
+    void clamp_region(const std::vector<unsigned> &roi_start, const std::vector<unsigned> &roi_shape,
+                      std::vector<unsigned> &start, std::vector<unsigned> &extent) const {
+        start.resize(array_shape.size());
+        extent.resize(array_shape.size());
+        for (size_t d = 0; d < array_shape.size(); d++) {
+            start[d] = d < roi_start.size() ? std::min(roi_start[d], array_shape[d]) : 0;
+            unsigned available = array_shape[d] - start[d];
+            extent[d] = (d < roi_shape.size() && roi_shape[d]) ? std::min(roi_shape[d], available) : available;
+        }
+    }
 };
 
 // The VectorView Class - to refer to a portion of a vector and avoiding copies of the data.
@@ -274,12 +308,29 @@ class Reader {
     //! Copies the data of the opened item to the buf
     virtual size_t read_data(unsigned char *buf, size_t read_size) = 0;
 
+    //! Returns true if the items are plain files which can be read directly through their path from any thread
+    virtual bool supports_path_read() { return false; }
+
+    //! Advances to the next item without opening it and returns its path, id() returns the name of this item afterwards
+    virtual std::string next_file_path() { THROW("next_file_path is not supported by this reader") }
+
+    //! Returns true if the opened items can be accessed in place through mapped_data() instead of being copied by read_data()
+    virtual bool supports_mapped_read() { return false; }
+
+    //! Returns a pointer to the data of the opened item in place of read_data(), the data stays valid and private to the caller as long as the reader exists
+    virtual unsigned char *mapped_data(size_t &size) { THROW("mapped_data is not supported by this reader") }
+
     //! Returns the numpy header data information used containing shape, size and dtype
     virtual const NumpyHeaderData get_numpy_header_data() { return {}; }
 
     //! Reads the data present in numpy arrays to the buffer
     virtual size_t read_numpy_data(void *buf, size_t read_size, std::vector<unsigned>& strides_in_dims) { return 0; }
 
+    //! Reads the region of the numpy file at file_path given by start and extent (in elements) into buf laid out with strides_in_dims
+    //! Does not depend on the opened file, so several regions can be read at once from different threads
+    virtual size_t read_numpy_region(const std::string &file_path, const NumpyHeaderData &header, void *buf, const std::vector<unsigned> &strides_in_dims,
+                                     const std::vector<unsigned> &start, const std::vector<unsigned> &extent) { THROW("read_numpy_region is not supported by this reader") }
+
     //! Closes the opened item
     virtual int close() = 0;
 
@@ -323,6 +374,9 @@ class Reader {
     //! Modified the file idx, and sets the current file idx to be processed
     void increment_curr_file_idx(size_t dataset_size);
 
+    //! Returns the file idx processed after file_idx, follows the same order as increment_curr_file_idx
+    unsigned next_file_idx(unsigned file_idx, size_t dataset_size) const;
+
     //! Increments the shard id, to process data from next shard
     void increment_shard_id();
 
@@ -338,6 +392,7 @@ class Reader {
     //! Returns the maximum size of the current shard
     size_t get_max_size_of_shard(size_t batch_size, bool loop);
 
-    //! Modifies the file names vector with files to be padded
-    void update_filenames_with_padding(std::vector<std::string> &file_names, size_t batch_size);
+    //! Modifies the file names vector with files to be padded, readers keeping sample ids instead of names pad those the same way
+    template <typename T>
+    void update_filenames_with_padding(std::vector<T> &file_names, size_t batch_size);
 };
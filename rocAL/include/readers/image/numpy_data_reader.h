@@ -67,6 +67,19 @@ class NumpyDataReader : public Reader {
     */
     size_t read_numpy_data(void* buf, size_t read_size, std::vector<unsigned>& max_shape) override;
 
+    //! Reads a region of a numpy file, only the rows overlapping the region are read from the disk
+    /*!
+     \param file_path Path of the npy file
+     \param header Header of the npy file as returned by get_numpy_header_data()
+     \param buf User's provided buffer to receive the region
+     \param strides_in_dims Element strides of the buffer, strides_in_dims[d + 1] is the stride of dimension d
+     \param start First element of the region in each dimension
+     \param extent Number of elements of the region in each dimension
+     \return Size of the loaded region, 0 if it is empty or couldn't be read
+    */
+    size_t read_numpy_region(const std::string& file_path, const NumpyHeaderData& header, void* buf, const std::vector<unsigned>& strides_in_dims,
+                             const std::vector<unsigned>& start, const std::vector<unsigned>& extent) override;
+
     //! Resets the object's state to read from the first file in the folder
     void reset() override;
 
@@ -136,8 +149,9 @@ class NumpyDataReader : public Reader {
     std::string parse_string(const char*& input, char delim_start = '\'', char delim_end = '\'');
     //! Reads the npy file, parses the numpy header data and stores the metadata info
     void parse_header(NumpyHeaderData& parsed_header, std::string file_path);
-    //! Reads the numpy data present in the npy array and stores the data in the circular buffer
-    size_t parse_numpy_data(unsigned char* buf, std::vector<unsigned>& strides, std::vector<unsigned>& shapes, size_t dtype_size, unsigned dim = 0);
+    //! Reads size bytes at offset of the file, retrying on short reads
+    static bool pread_fully(int fd, unsigned char* buf, size_t size, size_t offset, const std::string& file_path);
+    static constexpr size_t STAGING_BUFFER_SIZE = 4 * 1024 * 1024;  // Largest read scattered into a padded buffer at once
     //! Fetches cached header data if its already parsed before
     bool get_header_from_cache(const std::string& file_name, NumpyHeaderData& target);
     //! Stores parsed header data for a specific npy file
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! Location of one record of a TFRecord file and of its encoded image inside the record
+struct TFRecordEntry {
+    uint64_t record_offset = 0;   //!< Offset of the record header (length + length crc) in the file
+    uint64_t data_length = 0;     //!< Size of the serialized tf.Example
+    uint64_t encoded_offset = 0;  //!< Offset of the encoded image bytes in the file
+    uint64_t encoded_size = 0;
+    std::string name;             //!< Value of the file name feature, empty when the reader has no file name key
+};
+
+//! Finds the first bytes value of the feature key in a serialized tf.Example without parsing the whole message
+/*!
+\param value Set to the start of the value inside example
+\return false if the example has no bytes feature with this key or is malformed
+*/
+bool tf_example_find_bytes_feature(const unsigned char *example, size_t example_size, const std::string &key,
+                                   const unsigned char *&value, size_t &value_size);
+
+//! Masked crc32c of data, the checksum format used by the TFRecord headers and footers
+uint32_t tf_record_masked_crc(const unsigned char *data, size_t size);
+
+/*! \brief Persistent index of the records of the TFRecord files of a folder
+ *
+ * Stores the TFRecordEntry list of every record file keyed by its path, together with the modification time and size
+ * of the file when it was scanned. A later run only rescans the record files which changed since.
+ */
+class TFRecordIndex {
+   public:
+    struct FileStamp {
+        int64_t mtime_ns = 0;
+        uint64_t size = 0;
+        bool operator==(const FileStamp &other) const { return mtime_ns == other.mtime_ns && size == other.size; }
+    };
+
+    //! Constructor, loads the index stored at index_path if it exists and was built with the same feature keys
+    /*!
+    \param index_path Path of the index file, an empty path keeps the index in memory only
+    \param feature_keys Encoded and file name feature keys, the entries depend on them
+    */
+    TFRecordIndex(const std::string &index_path, const std::string &feature_keys);
+
+    //! Returns the stamp of the file at file_path, false if the file cannot be accessed
+    static bool stamp(const std::string &file_path, FileStamp &file_stamp);
+
+    //! Returns the records of file_path if the file has not changed since it was indexed, nullptr otherwise
+    /*! Safe to call concurrently as long as no insert() is running */
+    const std::vector<TFRecordEntry> *lookup(const std::string &file_path, const FileStamp &file_stamp) const;
+
+    void insert(const std::string &file_path, const FileStamp &file_stamp, std::vector<TFRecordEntry> records);
+
+    //! Writes the index back to index_path if any file was inserted since it was loaded
+    void save();
+
+   private:
+    struct FileRecords {
+        FileStamp file_stamp;
+        std::vector<TFRecordEntry> records;
+    };
+    void load();
+    std::string _index_path;
+    std::string _feature_keys;
+    std::unordered_map<std::string, FileRecords> _files;
+    bool _modified = false;
+    static constexpr char INDEX_MAGIC[8] = {'R', 'O', 'C', 'A', 'L', 'T', 'F', 'I'};
+    static constexpr uint32_t INDEX_VERSION = 1;
+};
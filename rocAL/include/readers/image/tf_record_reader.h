@@ -22,18 +22,17 @@ THE SOFTWARE.
 
 #pragma once
 #include <dirent.h>
-#include <google/protobuf/message_lite.h>
 
 #include <algorithm>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "example.pb.h"
-#include "feature.pb.h"
 #include "readers/image/image_reader.h"
+#include "readers/image/tf_record_index.h"
 #include "pipeline/timing_debug.h"
 
 class TFRecordReader : public Reader {
@@ -60,6 +59,10 @@ class TFRecordReader : public Reader {
     //! Returns the id of the latest file opened
     std::string id() override { return _last_id; };
 
+    //! The record files are mapped, the encoded images are handed to the decoders in place
+    bool supports_mapped_read() override { return true; }
+    unsigned char *mapped_data(size_t &size) override;
+
     ~TFRecordReader() override;
 
     int close() override;
@@ -67,34 +70,43 @@ class TFRecordReader : public Reader {
     TFRecordReader();
 
    private:
+    //! A record file mapped in memory for the lifetime of the reader
+    struct MappedRecordFile {
+        std::string path;
+        unsigned char *data = nullptr;
+        size_t size = 0;
+    };
+    //! An indexed record, the encoded image is read straight from the mapping of its file
+    struct Record {
+        unsigned file_idx;
+        TFRecordEntry entry;
+        bool crc_checked = false;
+    };
     //! opens the folder containing the images
-    Reader::Status tf_record_reader();
     Reader::Status folder_reading();
+    //! Maps the record file and appends it to _record_files, false if it cannot be mapped
+    bool map_record_file(const std::string &file_path);
+    //! Walks all the records of a mapped file and locates their encoded image
+    std::vector<TFRecordEntry> scan_record_file(const MappedRecordFile &record_file);
+    //! Verifies the checksums of the record the first time it is read
+    void check_record_crc(Record &record);
+    Record &current_record();
     std::string _folder_path;
     std::string _path;
     std::map<std::string, std::string> _feature_key_map;
     std::string _encoded_key;
     std::string _filename_key;
-    DIR *_src_dir;
     DIR *_sub_dir;
     struct dirent *_entity;
     std::vector<std::string> _file_names;
-    std::map<std::string, unsigned int> _file_size;
-    unsigned _current_file_size;
     std::string _last_id;
-    std::string _last_file_name;
-    unsigned int _last_file_size;
-    bool _last_rec;
     size_t _file_id = 0;
+    size_t _num_threads = 1;  //!< Number of threads scanning the record files
     //!< _record_name_prefix tells the reader to read only files with the prefix
     std::string _record_name_prefix;
-    // protobuf message objects
-    rocal::tensorflow::Example _single_example;
-    rocal::tensorflow::Features _features;
-    rocal::tensorflow::Feature _single_feature;
     void incremenet_read_ptr();
     int release();
-    Reader::Status read_image(unsigned char *buff, std::string record_file_name, uint file_size);
-    Reader::Status read_image_names(std::ifstream &file_contents, uint file_size);
-    std::map<std::string, uint> _image_record_starting;
+    std::vector<MappedRecordFile> _record_files;
+    std::vector<Record> _records;
+    std::unordered_map<std::string, size_t> _record_idx;  //!< Image path (record file/name) to its index in _records
 };
@@ -22,6 +22,14 @@ THE SOFTWARE.
 
 #pragma once
 #ifdef ENABLE_WDS
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+
 #include "meta_data/webdataset_meta_data_reader.h"
 #include "pipeline/timing_debug.h"
 #include "readers/image/image_reader.h"
@@ -66,30 +74,60 @@ class WebDatasetSourceReader : public Reader {
     std::string _paths, _index_paths;
     DIR *_sub_dir = nullptr;
     struct dirent *_entity = nullptr;
-    std::vector<std::string> _file_names, _all_shard_file_names_padded;
-    std::map<std::string, unsigned int> _file_wds_shard_idx_mapping, _file_size, _file_offset;
+    //! Location of a sample image inside the tar files
+    struct SampleEntry {
+        std::string file_path;
+        unsigned wds_shard_index;
+        size_t offset;
+        size_t size;
+    };
+    //! Sample handed over by the streaming thread, its data lives in a chunk shared with the neighbouring samples
+    struct StreamedSample {
+        unsigned sample_id = 0;
+        std::shared_ptr<unsigned char[]> chunk;
+        size_t chunk_offset = 0;
+    };
+    std::vector<SampleEntry> _samples;            // Samples of all the tar files, indexed by the sample id
+    std::vector<unsigned> _sample_ids;            // Sample id of every read position, padded and shuffled per shard like the file names of the other readers
+    std::vector<std::string> _tar_file_paths;     // Tar file path of each wds_shard_index
     unsigned _current_file_size;
     std::string _last_id;
-    std::string _last_file_name;
     std::vector<std::string> _index_name_list;
     void incremenet_read_ptr();
     int release();
-    void parse_tar_files(std::vector<SampleDescription> &samples_container, std::vector<ComponentDescription> &components_container, std::unique_ptr<std::ifstream> &tar_file);
-    void parse_index_files(std::vector<SampleDescription> &samples_container,
-                      std::vector<ComponentDescription> &components_container,
-                      const std::string &index_path);
-    void parse_sample_description(
-        std::vector<SampleDescription> &samples_container,
-        std::vector<ComponentDescription> &components_container,
-        std::ifstream &index_file, const std::string &index_path, int64_t line,
-        int index_version);
     Reader::Status webdataset_record_reader_from_components(ComponentDescription component, unsigned wds_shard_index);
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
-    std::vector<std::unique_ptr<std::ifstream>> _wds_shards;
-    Reader::Status read_web_dataset_at_offset(unsigned char *buff,
-                                              std::string file_name,
-                                              uint file_size, uint offset,
-                                              uint wds_shard_index);
+    Reader::Status read_web_dataset_at_offset(unsigned char *buff, const SampleEntry &sample);
+    //! Returns the descriptor of the tar file, it is opened on first use and the least recently used one is closed when more than _max_open_files are open
+    int tar_file_descriptor(unsigned wds_shard_index);
+    //! Reads size bytes at offset of the tar file into buff
+    void read_tar_file(unsigned wds_shard_index, unsigned char *buff, size_t size, size_t offset);
+    size_t _num_threads = 1;           // Threads parsing the tar or index files
+    size_t _max_open_files = 0;        // Cap on the tar files kept open
+    std::vector<int> _tar_fds;         // Descriptor of each tar file, -1 while it is closed
+    std::list<unsigned> _open_tar_files;  // Open tar files, most recently used first
+    std::vector<std::list<unsigned>::iterator> _open_tar_position;
     void increment_shard_id();
+    //! Starts the thread streaming the tar files from the current read position, does nothing unless a shuffle buffer size is set
+    void start_streaming();
+    //! Stops the streaming thread and drops the samples read ahead
+    void stop_streaming();
+    //! Streaming thread body, reads the samples following file_idx in chunks of back to back samples and queues them
+    void stream_tar_files(unsigned file_idx);
+    //! Waits for the shuffle window to fill and removes a random sample of it from the queue
+    const SampleEntry &next_streamed_sample();
+    size_t _shuffle_buffer_size = 0;   // 0 reads each sample at its offset, otherwise the tar files are streamed and the samples shuffled within a window of this size
+    size_t _stream_capacity = 0;       // Maximum number of queued samples, the shuffle window plus the read-ahead
+    std::thread _stream_thread;
+    std::mutex _stream_mutex;
+    std::condition_variable _stream_filled, _stream_drained;
+    std::deque<StreamedSample> _stream_queue;
+    std::exception_ptr _stream_error;
+    bool _stop_stream = false;
+    StreamedSample _current_sample;
+    std::mt19937 _stream_rng;
+    static constexpr size_t STREAM_CHUNK_SIZE = 16 * 1024 * 1024;  // Largest single read of the streaming thread
+    static constexpr size_t STREAM_READ_AHEAD = 256;               // Samples queued beyond the shuffle window
+    static constexpr size_t DEFAULT_MAX_OPEN_FILES = 256;
 };
 #endif
@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #include "rocal_api.h"
 
+#include <algorithm>
 #include <exception>
 #include <string>
 
@@ -43,7 +44,10 @@ rocalCreate(
     int gpu_id,
     size_t cpu_thread_count,
     size_t prefetch_queue_depth,
-    RocalTensorOutputType output_tensor_data_type) {
+    RocalTensorOutputType output_tensor_data_type,
+    bool deterministic_loader_order,
+    std::vector<unsigned> cpu_affinity,
+    int numa_node) {
     RocalContext context = nullptr;
     try {
         auto translate_process_mode = [](RocalProcessMode process_mode) {
@@ -70,7 +74,15 @@ rocalCreate(
         };
         if (gpu_id < 0)
             ERR(STR("Negative GPU device ID passed to context creation. Setting GPU device ID to 0"));
-        context = new Context(batch_size, translate_process_mode(affinity), std::max(gpu_id, 0), cpu_thread_count, prefetch_queue_depth, translate_output_data_type(output_tensor_data_type));
+        if (cpu_affinity.empty() && numa_node >= 0) {
+            cpu_affinity = CpuScheduler::numa_node_cpus(numa_node);
+            if (cpu_affinity.empty())
+                WRN("NUMA node " + TOSTR(numa_node) + " not found, the pipeline is not restricted to it")
+        }
+        // Pipelines on the same CPUs share a pool, so the same set has to map to the same key
+        std::sort(cpu_affinity.begin(), cpu_affinity.end());
+        cpu_affinity.erase(std::unique(cpu_affinity.begin(), cpu_affinity.end()), cpu_affinity.end());
+        context = new Context(batch_size, translate_process_mode(affinity), std::max(gpu_id, 0), cpu_thread_count, prefetch_queue_depth, translate_output_data_type(output_tensor_data_type), deterministic_loader_order, cpu_affinity);
         // Reset seed in case it's being randomized during context creation
     } catch (const std::exception& e) {
         ERR(STR("Failed to init the Rocal context, ") + STR(e.what()))
@@ -78,6 +90,18 @@ rocalCreate(
     return context;
 }
 
+void ROCAL_API_CALL
+rocalSetCpuCoreBudget(size_t core_budget) {
+    CpuScheduler::instance().set_core_budget(core_budget);
+}
+
+void ROCAL_API_CALL
+rocalSetIoDepth(RocalContext p_context, size_t io_depth) {
+    ROCAL_INVALID_CONTEXT_EXCEPTION(p_context);
+    auto context = static_cast<Context*>(p_context);
+    context->master_graph->set_io_depth(io_depth);
+}
+
 RocalStatus ROCAL_API_CALL
 rocalRun(RocalContext p_context) {
     auto context = static_cast<Context*>(p_context);
@@ -107,6 +107,29 @@ rocalExternalSourceFeedInput(
     return ROCAL_OK;
 }
 
+RocalStatus ROCAL_API_CALL
+rocalSetOutputBuffers(RocalContext p_context, unsigned int output_index, const std::vector<void*>& buffers, size_t buffer_size) {
+    if (!p_context)
+        THROW("Invalid rocal context passed to rocalSetOutputBuffers")
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_output_buffers(output_index, buffers, buffer_size);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+int ROCAL_API_CALL
+rocalGetOutputBufferIndex(RocalContext p_context) {
+    if (!p_context)
+        THROW("Invalid rocal context passed to rocalGetOutputBufferIndex")
+    auto context = static_cast<Context*>(p_context);
+    return context->master_graph->output_buffer_index();
+}
+
 RocalTensorList ROCAL_API_CALL
 rocalGetOutputTensors(RocalContext p_context) {
     auto context = static_cast<Context*>(p_context);
@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #include "pipeline/commons.h"
 #include "pipeline/context.h"
+#include "pipeline/cpu_features.h"
 #include "rocal_api.h"
 
 int ROCAL_API_CALL rocalGetOutputWidth(RocalContext p_context) {
@@ -93,7 +94,8 @@ TimingInfo
     auto context = static_cast<Context *>(p_context);
     auto info = context->timing();
     // INFO("bbencode time "+ TOSTR(info.bb_process_time)); //to display time taken for bbox encoder
-    return {info.read_time, info.decode_time, info.process_time, info.copy_to_output};
+    return {info.read_time, info.decode_time, info.process_time, info.copy_to_output, info.compressed_buffer_size, info.peak_rss, info.file_read_time, info.read_wait_time,
+            info.bb_stage_stall_time, info.bb_stage_idle_time, info.bb_stage_max_occupancy, info.bb_stage_occupancy_sum, info.bb_stage_batches};
 }
 
 RocalMetaData
@@ -161,3 +163,17 @@ rocalGetLastBatchPaddedSize(RocalContext p_context) {
     }
     return count;
 }
+
+RocalCpuIsa ROCAL_API_CALL
+rocalGetCpuIsa(RocalContext p_context) {
+    switch (cpu_isa_level()) {
+        case CpuIsaLevel::AVX512:
+            return ROCAL_CPU_ISA_AVX512;
+        case CpuIsaLevel::AVX2:
+            return ROCAL_CPU_ISA_AVX2;
+        case CpuIsaLevel::SSE42:
+            return ROCAL_CPU_ISA_SSE42;
+        default:
+            return ROCAL_CPU_ISA_SCALAR;
+    }
+}
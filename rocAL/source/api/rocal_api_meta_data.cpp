@@ -272,6 +272,24 @@ RocalTensorList
     return context->master_graph->bbox_meta_data();
 }
 
+RocalStatus
+    ROCAL_API_CALL
+    rocalGetCollatedMetaData(RocalContext p_context, unsigned meta_data_buffer, RocalCollatedMetaData* collated_meta_data) {
+    ROCAL_INVALID_CONTEXT_EXCEPTION(p_context);
+    auto context = static_cast<Context*>(p_context);
+    try {
+        auto collated = context->master_graph->collated_meta_data(meta_data_buffer);
+        collated_meta_data->data = collated.first;
+        collated_meta_data->offsets = collated.second->data();
+        collated_meta_data->batch_size = collated.second->size() - 1;
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
 RocalMetaData
     ROCAL_API_CALL
     rocalGetAsciiDatas(RocalContext p_context) {
@@ -427,20 +445,22 @@ void
         WRN("No encoded labels and bounding boxes has been loaded for this output image")
         return;
     }
+    const auto& labels_batch = meta_data.second->read_labels_batch();
+    const auto& bb_cords_batch = meta_data.second->read_bb_cords_batch();
     unsigned sum = 0;
     std::vector<unsigned> bb_offset(meta_data_batch_size);
     for (unsigned i = 0; i < meta_data_batch_size; i++) {
         bb_offset[i] = sum;
-        sum += meta_data.second->get_labels_batch()[i].size();
+        sum += labels_batch[i].size();
     }
 // copy labels buffer & bboxes buffer parallely
 #pragma omp parallel for
     for (unsigned i = 0; i < meta_data_batch_size; i++) {
-        unsigned bb_count = meta_data.second->get_labels_batch()[i].size();
+        unsigned bb_count = labels_batch[i].size();
         int* temp_labels_buf = labels_buf + bb_offset[i];
         float* temp_bbox_buf = boxes_buf + (bb_offset[i] * 4);
-        memcpy(temp_labels_buf, meta_data.second->get_labels_batch()[i].data(), sizeof(int) * bb_count);
-        memcpy(temp_bbox_buf, meta_data.second->get_bb_cords_batch()[i].data(), sizeof(BoundingBoxCord) * bb_count);
+        memcpy(temp_labels_buf, labels_batch[i].data(), sizeof(int) * bb_count);
+        memcpy(temp_bbox_buf, bb_cords_batch[i].data(), sizeof(BoundingBoxCord) * bb_count);
     }
 }
 
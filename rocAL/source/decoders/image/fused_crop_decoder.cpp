@@ -67,6 +67,7 @@ Decoder::Status FusedCropTJDecoder::decode(unsigned char *input_buffer, size_t i
             planes = 3;
             break;
     };
+    int tj_flags = (decoder_config.get_decode_quality() == DecodeQuality::ACCURATE) ? TJFLAG_ACCURATEDCT : (TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE);
     actual_decoded_width = max_decoded_width;
     actual_decoded_height = max_decoded_height;
     // You need get the output of random bbox crop
@@ -92,7 +93,7 @@ Decoder::Status FusedCropTJDecoder::decode(unsigned char *input_buffer, size_t i
                               max_decoded_width * planes,
                               max_decoded_height,
                               tjpf,
-                              TJFLAG_ACCURATEDCT, &x1_diff, &crop_width_diff,
+                              tj_flags, &x1_diff, &crop_width_diff,
                               _crop_window.x, _crop_window.y, _crop_window.W, _crop_window.H) != 0) {
         WRN("Jpeg image decode failed " + STR(tjGetErrorStr2(m_jpegDecompressor)))
         return Status::CONTENT_DECODE_FAILED;
@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 
 #include <stdio.h>
+#include <algorithm>
 #include "pipeline/commons.h"
 #include "decoders/image/turbo_jpeg_decoder.h"
 #include "decoders/libjpeg/libjpeg_extra.h"
@@ -75,6 +76,7 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
             planes = 3;
             break;
     };
+    int tj_flags = (config.get_decode_quality() == DecodeQuality::ACCURATE) ? TJFLAG_ACCURATEDCT : (TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE);
 
     if (!keep_original_size) {
         actual_decoded_width = max_decoded_width;
@@ -104,7 +106,7 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
                                             max_decoded_width * planes,
                                             max_decoded_height,
                                             tjpf,
-                                            TJFLAG_ACCURATEDCT,
+                                            tj_flags,
                                             crop_width, crop_height) != 0)
 
             {
@@ -126,25 +128,29 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
         }
         // TODO : Turbo Jpeg supports multiple color packing and color formats, add more as an option to the API TJPF_RGB, TJPF_BGR, TJPF_RGBX, TJPF_BGRX, TJPF_RGBA, TJPF_GRAY, TJPF_CMYK , ...
         else {
+            size_t decode_width = max_decoded_width, decode_height = max_decoded_height;
+            if (config.get_decode_quality() == DecodeQuality::FAST_SCALED)
+                dct_scaled_size(original_image_width, original_image_height, max_decoded_width, max_decoded_height,
+                                config.get_decode_width_hint(), config.get_decode_height_hint(), decode_width, decode_height);
             if (tjDecompress2(m_jpegDecompressor,
                               input_buffer,
                               input_size,
                               output_buffer,
-                              max_decoded_width,
+                              decode_width,
                               max_decoded_width * planes,
-                              max_decoded_height,
+                              decode_height,
                               tjpf,
-                              TJFLAG_ACCURATEDCT) != 0) {
+                              tj_flags) != 0) {
                 // try decode to original dim and scale using OpenCV
                 WRN("Jpeg image decode failed " + STR(tjGetErrorStr2(m_jpegDecompressor)))
                 return Status::CONTENT_DECODE_FAILED;
             }
             // Find the decoded image size using the predefined scaling factors in the turbo jpeg decoder
-            uint scaledw = max_decoded_width, scaledh = max_decoded_height;
+            uint scaledw = decode_width, scaledh = decode_height;
             for (int j=0; j < _num_scaling_factors; j++) {
                 scaledw = TJSCALED(original_image_width, _scaling_factors[j]);
                 scaledh = TJSCALED(original_image_height, _scaling_factors[j]);
-                if (scaledw <= max_decoded_width && scaledh <= max_decoded_height)
+                if (scaledw <= decode_width && scaledh <= decode_height)
                     break;
             }
             actual_decoded_width = scaledw;
@@ -184,7 +190,7 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
                                             max_decoded_width * planes,
                                             max_decoded_height,
                                             tjpf,
-                                            TJFLAG_ACCURATEDCT,
+                                            tj_flags,
                                             crop_width, crop_height) != 0)
 
             {
@@ -213,7 +219,7 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
                               max_decoded_width * planes,
                               actual_decoded_height,
                               tjpf,
-                              TJFLAG_ACCURATEDCT) != 0) {
+                              tj_flags) != 0) {
                 WRN("KO::Jpeg image decode failed " + STR(tjGetErrorStr2(m_jpegDecompressor)))
                 return Status::CONTENT_DECODE_FAILED;
             }
@@ -234,6 +240,26 @@ Decoder::Status TJDecoder::decode(unsigned char* input_buffer, size_t input_size
     return Status::OK;
 }
 
+void TJDecoder::dct_scaled_size(size_t original_width, size_t original_height, size_t max_width, size_t max_height,
+                                size_t hint_width, size_t hint_height, size_t &decode_width, size_t &decode_height) {
+    if (!hint_width || !hint_height)
+        return;
+    // Scaling factors are sorted from the largest to the smallest, start from the one the decoder would use by default
+    int j = 0;
+    while (j < _num_scaling_factors && (TJSCALED(original_width, _scaling_factors[j]) > max_width || TJSCALED(original_height, _scaling_factors[j]) > max_height))
+        j++;
+    if (j == _num_scaling_factors)
+        return;
+    size_t min_width = std::min(hint_width, static_cast<size_t>(TJSCALED(original_width, _scaling_factors[j])));
+    size_t min_height = std::min(hint_height, static_cast<size_t>(TJSCALED(original_height, _scaling_factors[j])));
+    // Keep going down as long as the decoded image is not smaller than what it is used at
+    while (j + 1 < _num_scaling_factors && static_cast<size_t>(TJSCALED(original_width, _scaling_factors[j + 1])) >= min_width &&
+           static_cast<size_t>(TJSCALED(original_height, _scaling_factors[j + 1])) >= min_height)
+        j++;
+    decode_width = TJSCALED(original_width, _scaling_factors[j]);
+    decode_height = TJSCALED(original_height, _scaling_factors[j]);
+}
+
 TJDecoder::~TJDecoder() {
     tjDestroy(m_jpegDecompressor);
 }
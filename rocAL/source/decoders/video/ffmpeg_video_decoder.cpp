@@ -25,9 +25,30 @@ THE SOFTWARE.
 #include "pipeline/commons.h"
 #include <stdio.h>
 
+#include <algorithm>
+#include <iterator>
+
 #ifdef ROCAL_VIDEO
 FFmpegVideoDecoder::FFmpegVideoDecoder(){};
 
+void FFmpegVideoDecoder::build_keyframe_index() {
+    _keyframe_pts.clear();
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+    int entry_count = avformat_index_get_entries_count(_video_stream);
+    for (int i = 0; i < entry_count; i++) {
+        const AVIndexEntry *entry = avformat_index_get_entry(_video_stream, i);
+        if (entry && (entry->flags & AVINDEX_KEYFRAME))
+            _keyframe_pts.push_back(entry->timestamp);
+    }
+#else
+    for (int i = 0; i < _video_stream->nb_index_entries; i++) {
+        if (_video_stream->index_entries[i].flags & AVINDEX_KEYFRAME)
+            _keyframe_pts.push_back(_video_stream->index_entries[i].timestamp);
+    }
+#endif
+    std::sort(_keyframe_pts.begin(), _keyframe_pts.end());
+}
+
 int FFmpegVideoDecoder::SeekFrame(AVRational avg_frame_rate, AVRational time_base, unsigned frame_number) {
     auto seek_time = av_rescale_q((int64_t)frame_number, av_inv_q(avg_frame_rate), AV_TIME_BASE_Q);
     int64_t select_frame_pts = av_rescale_q((int64_t)frame_number, av_inv_q(avg_frame_rate), time_base);
@@ -39,24 +60,48 @@ int FFmpegVideoDecoder::SeekFrame(AVRational avg_frame_rate, AVRational time_bas
     return select_frame_pts;
 }
 
+bool FFmpegVideoDecoder::can_continue_to(int64_t select_frame_pts, size_t sequence_frames) const {
+    if (!_decoder_positioned || _last_pts == AV_NOPTS_VALUE || select_frame_pts <= _last_pts)
+        return false;
+    if (_keyframe_pts.empty()) {
+        // Without keyframe information only short gaps are decoded through, a seek would decode at least a GOP prefix as well
+        return (select_frame_pts - _last_pts) <= static_cast<int64_t>(sequence_frames) * _frame_duration;
+    }
+    // A seek lands on the last keyframe at or before the target, it only saves work if that keyframe is past the current position.
+    // The index holds decode timestamps for some containers, which only makes this estimate off by the reorder delay
+    auto keyframe = std::upper_bound(_keyframe_pts.begin(), _keyframe_pts.end(), select_frame_pts);
+    return keyframe == _keyframe_pts.begin() || *std::prev(keyframe) <= _last_pts;
+}
+
 // Seeks to the frame_number in the video file and decodes each frame in the sequence.
 VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsigned seek_frame_number, size_t sequence_length, size_t stride, int out_width, int out_height, int out_stride, AVPixelFormat out_pix_format) {
     VideoDecoder::Status status = Status::OK;
 
-    // Initialize the SwsContext
+    // The SwsContext is reused as long as the conversion parameters do not change
     SwsContext *swsctx = nullptr;
     if ((out_width != _codec_width) || (out_height != _codec_height) || (out_pix_format != _dec_pix_fmt)) {
-        swsctx = sws_getCachedContext(nullptr, _codec_width, _codec_height, _dec_pix_fmt,
-                                      out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
-        if (!swsctx) {
+        _sws_ctx = sws_getCachedContext(_sws_ctx, _codec_width, _codec_height, _dec_pix_fmt,
+                                        out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!_sws_ctx) {
             ERR("Fail to get sws_getCachedContext");
             return Status::FAILED;
         }
+        swsctx = _sws_ctx;
     }
-    int select_frame_pts = SeekFrame(_video_stream->avg_frame_rate, _video_stream->time_base, seek_frame_number);
-    if (select_frame_pts < 0) {
-        ERR("Error in seeking frame..Unable to seek the given frame in a video");
-        return Status::FAILED;
+    if (!_dec_frame && !(_dec_frame = av_frame_alloc())) {
+        ERR("Could not allocate dec_frame");
+        return Status::NO_MEMORY;
+    }
+    AVFrame *dec_frame = _dec_frame;
+    int64_t select_frame_pts = av_rescale_q((int64_t)seek_frame_number, av_inv_q(_video_stream->avg_frame_rate), _video_stream->time_base);
+    if (!can_continue_to(select_frame_pts, sequence_length * stride)) {
+        avcodec_flush_buffers(_video_dec_ctx);
+        _decoder_positioned = false;
+        _last_pts = AV_NOPTS_VALUE;
+        if (SeekFrame(_video_stream->avg_frame_rate, _video_stream->time_base, seek_frame_number) < 0) {
+            ERR("Error in seeking frame..Unable to seek the given frame in a video");
+            return Status::FAILED;
+        }
     }
     unsigned frame_count = 0;
     bool end_of_stream = false;
@@ -65,11 +110,6 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
     int dst_linesize[4] = {0};
     int image_size = out_height * out_stride * sizeof(unsigned char);
     AVPacket pkt;
-    AVFrame *dec_frame = av_frame_alloc();
-    if (!dec_frame) {
-        ERR("Could not allocate dec_frame");
-        return Status::NO_MEMORY;
-    }
     do {
         int ret;
         // read packet from input file
@@ -79,7 +119,10 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
             status = Status::FAILED;
             break;
         }
-        if (ret == 0 && pkt.stream_index != _video_stream_idx) continue;
+        if (ret == 0 && pkt.stream_index != _video_stream_idx) {
+            av_packet_unref(&pkt);
+            continue;
+        }
         end_of_stream = (ret == AVERROR_EOF);
         if (end_of_stream) {
             // null packet for bumping process
@@ -92,6 +135,7 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
         if (ret < 0) {
             ERR("Error while sending packet to the decoder\n");
             status = Status::FAILED;
+            av_packet_unref(&pkt);
             break;
         }
 
@@ -99,7 +143,12 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
         while (ret >= 0) {
             ret = avcodec_receive_frame(_video_dec_ctx, dec_frame);
             if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) break;
-            if ((dec_frame->pts < select_frame_pts) || (ret < 0)) continue;
+            if (ret < 0) continue;
+            _last_pts = dec_frame->pts;
+            if (dec_frame->pts < select_frame_pts) {
+                av_frame_unref(dec_frame);
+                continue;
+            }
             if (frame_count % stride == 0) {
                 dst_data[0] = out_buffer;
                 dst_linesize[0] = out_stride;
@@ -121,9 +170,8 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
         av_packet_unref(&pkt);
         if (sequence_filled) break;
     } while (!end_of_stream);
-    avcodec_flush_buffers(_video_dec_ctx);
-    av_frame_free(&dec_frame);
-    sws_freeContext(swsctx);
+    // The decoder stays positioned after the sequence unless it was drained or failed, the next sequence of this video may continue from here
+    _decoder_positioned = sequence_filled && status == Status::OK;
     return status;
 }
 
@@ -133,6 +181,9 @@ VideoDecoder::Status FFmpegVideoDecoder::Initialize(const char *src_filename, in
     int ret;
     AVDictionary *opts = NULL;
 
+    // The decoder instances are reused across video files, drop the contexts of the previous file first
+    Release();
+
     // open input file, and initialize the context required for decoding
     _fmt_ctx = avformat_alloc_context();
     _src_filename = src_filename;
@@ -189,14 +240,25 @@ VideoDecoder::Status FFmpegVideoDecoder::Initialize(const char *src_filename, in
     _dec_pix_fmt = _video_dec_ctx->pix_fmt;
     _codec_width = _video_stream->codecpar->width;
     _codec_height = _video_stream->codecpar->height;
+    _frame_duration = std::max<int64_t>(av_rescale_q(1, av_inv_q(_video_stream->avg_frame_rate), _video_stream->time_base), 1);
+    build_keyframe_index();
     return status;
 }
 
 void FFmpegVideoDecoder::Release() {
+    if (_sws_ctx) {
+        sws_freeContext(_sws_ctx);
+        _sws_ctx = nullptr;
+    }
+    if (_dec_frame)
+        av_frame_free(&_dec_frame);
     if (_video_dec_ctx)
         avcodec_free_context(&_video_dec_ctx);
     if (_fmt_ctx)
         avformat_close_input(&_fmt_ctx);
+    _keyframe_pts.clear();
+    _last_pts = AV_NOPTS_VALUE;
+    _decoder_positioned = false;
 }
 
 FFmpegVideoDecoder::~FFmpegVideoDecoder() {
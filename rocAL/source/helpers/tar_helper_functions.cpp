@@ -21,15 +21,12 @@ THE SOFTWARE.
 */
 
 #ifdef ENABLE_WDS
-#include <mutex>
-#include <vector>
-#include <libtar.h>
-#include <string>
-#include <list>
-#include <cassert>
-#include <cstdarg>
 #include <algorithm>
+#include <cassert>
 #include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "helpers/tar_helper_functions.h"
 #include "pipeline/exception.h"
 
@@ -38,70 +35,165 @@ constexpr value align_up(value v, alignment a) {
   return v + ((a - 1) & -v);
 }
 
-constexpr uint64_t TARARCHIVEBUFFERINITSIZE = 1;
-
-std::mutex instances_mutex;
-std::list<std::vector<TarArchive*>> instances_registry = {
-    std::vector<TarArchive*>(TARARCHIVEBUFFERINITSIZE)
+namespace {
+// ustar header block, the GNU format uses the same layout with a different magic and no prefix
+struct TarHeader {
+  char name[100];
+  char mode[8];
+  char uid[8];
+  char gid[8];
+  char size[12];
+  char mtime[12];
+  char chksum[8];
+  char typeflag;
+  char linkname[100];
+  char magic[6];
+  char version[2];
+  char uname[32];
+  char gname[32];
+  char devmajor[8];
+  char devminor[8];
+  char prefix[155];
+  char padding[12];
 };
-TarArchive** instances = instances_registry.back().data();
-
-int add_to_register(TarArchive* archive) {
-  std::lock_guard<std::mutex> instances_lock(instances_mutex);
-  for (auto& instances_entry : instances_registry.back()) {
-    if (instances_entry != nullptr) {
-      continue;
-    }
-    instances_entry = archive;
-    return &instances_entry - instances;
+static_assert(sizeof(TarHeader) == kBlockSize, "tar header must be one block");
+
+// Numeric fields are octal strings, or big-endian base-256 when the high bit of the first byte is set
+uint64_t parse_tar_number(const char *field, size_t length) {
+  uint64_t value = 0;
+  if (static_cast<unsigned char>(field[0]) & 0x80) {
+    value = static_cast<unsigned char>(field[0]) & 0x7F;
+    for (size_t i = 1; i < length; i++)
+      value = (value << 8) | static_cast<unsigned char>(field[i]);
+    return value;
   }
-  std::vector<TarArchive*>& old = instances_registry.back();
-  instances_registry.emplace_back();
-  std::vector<TarArchive*>& curr = instances_registry.back();
-  curr.reserve(old.size() * 2);
-  curr = old;
-  curr.push_back(archive);
-  curr.resize(old.size() * 2, nullptr);
-  instances = curr.data();
-  return old.size();
+  size_t i = 0;
+  while (i < length && field[i] == ' ') i++;
+  for (; i < length && field[i] >= '0' && field[i] <= '7'; i++)
+    value = (value << 3) | (field[i] - '0');
+  return value;
 }
 
-inline void remove_from_register(int instance_handle) {
-  instances[instance_handle] = nullptr;
+std::string tar_string(const char *field, size_t length) {
+  return std::string(field, strnlen(field, length));
 }
 
-inline TAR* void_ptr_to_tar_ptr(void* handle) {
-  return reinterpret_cast<TAR*>(handle);
+bool is_zero_block(const char *block) {
+  return std::all_of(block, block + kBlockSize, [](char c) { return c == 0; });
 }
 
-inline TAR** void_ptr_to_tar_ptr(void** handle) {
-  return reinterpret_cast<TAR**>(handle);
+bool tar_checksum_matches(const TarHeader &header) {
+  auto expected = parse_tar_number(header.chksum, sizeof(header.chksum));
+  auto bytes = reinterpret_cast<const unsigned char *>(&header);
+  uint64_t unsigned_sum = 0;
+  int64_t signed_sum = 0;
+  for (size_t i = 0; i < kBlockSize; i++) {
+    bool in_chksum = i >= offsetof(TarHeader, chksum) && i < offsetof(TarHeader, chksum) + sizeof(header.chksum);
+    unsigned char c = in_chksum ? ' ' : bytes[i];
+    unsigned_sum += c;
+    signed_sum += static_cast<signed char>(c);
+  }
+  // Some old tar implementations summed the header as signed chars
+  return expected == unsigned_sum || static_cast<int64_t>(expected) == signed_sum;
 }
 
-ssize_t read_tar_archive(int instance_handle, void* buf, size_t count) {
-  const auto current_archive = instances[instance_handle];
-  current_archive->get_stream()->read(reinterpret_cast<char*>(buf), count);
-  const ssize_t num_read = current_archive->get_stream()->gcount();
-  return num_read;
+// Returns the path recorded in a pax extended header, the records look like "<length> <key>=<value>\n"
+std::string pax_path(const std::string &records) {
+  std::string path;
+  size_t pos = 0;
+  while (pos < records.size()) {
+    size_t space = records.find(' ', pos);
+    if (space == std::string::npos) break;
+    size_t length = std::strtoull(records.c_str() + pos, nullptr, 10);
+    if (length == 0 || pos + length > records.size()) break;
+    std::string record = records.substr(space + 1, pos + length - space - 2);
+    if (record.compare(0, 5, "path=") == 0)
+      path = record.substr(5);
+    pos += length;
+  }
+  return path;
 }
 
-int open_tar_archive(const char*, int oflags, ...) {
-  va_list args;
-  va_start(args, oflags);
-  const int _instance_handle = va_arg(args, int);
-  va_end(args);
-  return _instance_handle;
+constexpr int create_version_number(int major, int minor, int patch = 0) {
+  if (major < 0 || minor < 0 || patch < 0) {
+    return -1;
+  }
+  return major * 1000 + minor * 10 + patch;
 }
 
-static tartype_t kTarArchiveType = {open_tar_archive, [](int) -> int { return 0; },
-                                    read_tar_archive,
-                                    [](int, const void*, size_t) -> ssize_t { return 0; }};
+inline std::tuple<std::string, std::string> split_name(const std::string& file_path) {
+  size_t dot_pos = file_path.find('.', file_path.rfind('/') + 1);
+  return {file_path.substr(0, dot_pos), file_path.substr(dot_pos + 1)};
+}
+
+inline int parse_index_version(const std::string& idx_version_in_str) {
+  const char* c_string_ptr = idx_version_in_str.c_str();
+  assert(*c_string_ptr == 'v');
+  c_string_ptr++;
+  auto major = atoi(c_string_ptr);
+  c_string_ptr = strchr(c_string_ptr, '.');
+  assert(c_string_ptr);
+  c_string_ptr++;
+  auto minor = atoi(c_string_ptr);
+  return create_version_number(major, minor);
+}
+
+void parse_sample_description(std::vector<SampleDescription>& samples_container,
+                              std::vector<ComponentDescription>& components_container,
+                              std::ifstream& index_file, int64_t line, int index_version) {
+  samples_container.emplace_back();
+  samples_container.back().components = VectorView<ComponentDescription>(components_container, components_container.size());
+  samples_container.back().line_number = line;
+
+  // Getting the components data
+  std::string components_metadata;
+  std::getline(index_file, components_metadata);
+  std::stringstream components_stream(components_metadata);
+
+  // Reading consecutive components
+  ComponentDescription component;
+  while (components_stream >> component.ext) {
+    if (index_version == create_version_number(1, 0)) {
+      if (!(components_stream >> component.offset >> component.size >> component.filename)) {
+        THROW("Could not find all necessary component parameters "
+              "(offset, size or filename). Every record in the index "
+              "file should look like: `<ext> <offset> <size> <filename>`.");
+      }
+    } else {
+      if (!(components_stream >> component.offset >> component.size))
+        THROW("Could not find all necessary component parameters "
+              "(offset or size). Every record in the index file should "
+              "look like: `<ext> <offset> <size>`");
+    }
+
+    if (component.filename.empty()) {  // Use line number as file number
+      component.filename = std::to_string(line);
+    } else {
+      // Find the position of the last period
+      auto last_period_pos = component.filename.find_last_of('.');
+      // If a period is found, truncate everything after it
+      if (last_period_pos != std::string::npos) {
+        component.filename.erase(last_period_pos);
+      }
+    }
+
+    if (!(component.offset % kBlockSize == 0))
+      THROW("tar offset is not a multiple of tar block size kBlockSize, "
+            "perhaps the size value is exported before offset?");
+
+    components_container.emplace_back(std::move(component));
+    samples_container.back().components.num++;
+  }
+
+  if ((!samples_container.back().components.num))
+    THROW("No extensions provided for the sample");
+}
+}  // namespace
 
 TarArchive::TarArchive(std::unique_ptr<std::ifstream> stream)
-    : _stream(std::move(stream)), _instance_handle(add_to_register(this)) {
-  tar_open(void_ptr_to_tar_ptr(&_handle), "", &kTarArchiveType, 0, _instance_handle, TAR_GNU);
-   _stream->seekg(0, std::ios_base::end);
-  _eof = _stream->tellg() == 0;
+    : _stream(std::move(stream)) {
+  _stream->seekg(0, std::ios_base::end);
+  _eof = _stream->tellg() <= 0;
   _stream->seekg(0, std::ios_base::beg);
   parse_current_header();
 }
@@ -121,18 +213,13 @@ std::ifstream* TarArchive::get_stream() {
 TarArchive& TarArchive::operator=(TarArchive&& other) {
   if (&other != this) {
     _stream = std::move(other._stream);
-    std::swap(_handle, other._handle);
     std::swap(_filename, other._filename);
     std::swap(_filesize, other._filesize);
     std::swap(_filetype, other._filetype);
     std::swap(_readoffset, other._readoffset);
     std::swap(_current_header, other._current_header);
+    std::swap(_data_offset, other._data_offset);
     std::swap(_eof, other._eof);
-    std::swap(_instance_handle, other._instance_handle);
-    if (_instance_handle >= 0) {
-      std::lock_guard<std::mutex> instances_lock(instances_mutex);
-      instances[_instance_handle] = this;
-    }
     other.release_file_stream();
   }
   return *this;
@@ -146,10 +233,7 @@ bool TarArchive::advance_to_next_file_in_tar() {
   if (_eof) { 
     return false;
   }
-//   const int64_t offset = _stream->tellg() + round_it_to_given_block_size(_filesize) - _readoffset;
-  const int64_t offset = static_cast<int64_t>(_stream->tellg()) + round_it_to_given_block_size(_filesize) - _readoffset;
-  _current_header = offset;
-  _stream->seekg(offset, std::ios::beg);
+  _current_header = _data_offset + round_it_to_given_block_size(_filesize);
   parse_current_header();
   return !_eof;
 }
@@ -160,10 +244,8 @@ bool TarArchive::at_end_of_archive() const {
 
 void TarArchive::seek_to_offset_in_archive(int64_t offset) {
   if (offset == _current_header) return;
-  assert(offset % T_BLOCKSIZE == 0);
+  assert(offset % kBlockSize == 0);
   _eof = false;
-  _readoffset = 0;
-  _stream->seekg(offset, std::ios::beg);
   _current_header = offset;
   parse_current_header();
 }
@@ -173,8 +255,7 @@ int64_t TarArchive::get_current_archive_offset() const {
 }
 
 int64_t TarArchive::get_current_header_size() const {
-  return static_cast<int64_t>(_stream->tellg()) - _readoffset - _current_header;
-
+  return _data_offset - _current_header;
 }
 
 const std::string& TarArchive::get_current_file_name() const {
@@ -190,7 +271,8 @@ TarArchive::EntryType TarArchive::get_current_file_type() const {
 }
 
 std::shared_ptr<void> TarArchive::read_current_file() {
-  _stream->seekg(static_cast<size_t>(_stream->tellg()) - static_cast<size_t>(_readoffset), std::ios::beg);
+  _stream->seekg(_data_offset, std::ios::beg);
+  _readoffset = 0;
 
   std::shared_ptr<void> out;
   if (out != nullptr) {
@@ -201,7 +283,8 @@ std::shared_ptr<void> TarArchive::read_current_file() {
 
 size_t TarArchive::read_into_buffer(void *buffer, size_t count) {
   if (_eof) return 0;
-  count = std::clamp(_filesize - _readoffset, static_cast<uint64_t>(0), count);
+  count = std::clamp(_filesize - _readoffset, static_cast<size_t>(0), count);
+  _stream->seekg(_data_offset + _readoffset, std::ios::beg);
   _stream->read(reinterpret_cast<char*>(buffer), count);
   size_t num_read_bytes = _stream->gcount();
   _readoffset += num_read_bytes;
@@ -219,51 +302,171 @@ inline void TarArchive::mark_end_of_file() {
   _filetype = ENTRY_NONE;
 }
 
+bool TarArchive::read_block(int64_t offset, char *block) {
+  _stream->clear();
+  _stream->seekg(offset, std::ios::beg);
+  _stream->read(block, kBlockSize);
+  return static_cast<size_t>(_stream->gcount()) == kBlockSize;
+}
+
+std::string TarArchive::read_extension_data(int64_t offset, size_t size) {
+  std::string data(size, '\0');
+  _stream->clear();
+  _stream->seekg(offset, std::ios::beg);
+  _stream->read(&data[0], size);
+  if (static_cast<size_t>(_stream->gcount()) != size)
+    THROW("Truncated tar extension header at offset " + std::to_string(offset));
+  return data;
+}
+
 inline void TarArchive::parse_current_header() {
   if (_eof) return;
-  int errorcode = th_read(void_ptr_to_tar_ptr(_handle));
-  if (errorcode) {
-    if (errorcode == -1)
-      THROW("Corrupted tar file at " + void_ptr_to_tar_ptr(_handle)->pathname);
-    mark_end_of_file();
+  _readoffset = 0;
+  TarHeader header;
+  int64_t offset = _current_header;
+  std::string long_name;
+  // The GNU long name and pax headers describe the entry that follows them
+  while (true) {
+    // A short read or the zero block terminating the archive both end the listing
+    if (!read_block(offset, reinterpret_cast<char *>(&header)) || is_zero_block(reinterpret_cast<char *>(&header))) {
+      mark_end_of_file();
+      return;
+    }
+    if (!tar_checksum_matches(header))
+      THROW("Corrupted tar file at offset " + std::to_string(offset));
+    size_t size = parse_tar_number(header.size, sizeof(header.size));
+    offset += kBlockSize;
+    if (header.typeflag == 'L') {
+      long_name = read_extension_data(offset, size);
+      long_name.resize(strnlen(long_name.c_str(), long_name.size()));
+    } else if (header.typeflag == 'x') {
+      auto path = pax_path(read_extension_data(offset, size));
+      if (!path.empty())
+        long_name = path;
+    } else if (header.typeflag != 'K' && header.typeflag != 'g') {
+      _filesize = size;
+      break;
+    }
+    offset += round_it_to_given_block_size(size);
+  }
+  _data_offset = offset;
+  if (!long_name.empty()) {
+    _filename = long_name;
   } else {
-    _filename = th_get_pathname(void_ptr_to_tar_ptr(_handle));
-    _filesize = th_get_size(void_ptr_to_tar_ptr(_handle));
-
-    if (TH_ISREG(void_ptr_to_tar_ptr(_handle))) {
+    _filename = tar_string(header.name, sizeof(header.name));
+    // Only the POSIX ustar format stores the leading directories in the prefix field
+    if (memcmp(header.magic, "ustar", 6) == 0 && header.prefix[0])
+      _filename = tar_string(header.prefix, sizeof(header.prefix)) + "/" + _filename;
+  }
+  switch (header.typeflag) {
+    case '0':
+    case '\0':
+    case '7':
       _filetype = ENTRY_FILE;
-    } else if (TH_ISDIR(void_ptr_to_tar_ptr(_handle))) {
-      _filetype = ENTRY_DIR;
-    } else if (TH_ISLNK(void_ptr_to_tar_ptr(_handle))) {
+      break;
+    case '1':
       _filetype = ENTRY_HARDLINK;
-    } else if (TH_ISSYM(void_ptr_to_tar_ptr(_handle))) {
+      break;
+    case '2':
       _filetype = ENTRY_SYMLINK;
-    } else if (TH_ISCHR(void_ptr_to_tar_ptr(_handle))) {
+      break;
+    case '3':
       _filetype = ENTRY_CHARDEV;
-    } else if (TH_ISBLK(void_ptr_to_tar_ptr(_handle))) {
+      break;
+    case '4':
       _filetype = ENTRY_BLOCKDEV;
-    } else if (TH_ISFIFO(void_ptr_to_tar_ptr(_handle))) {
+      break;
+    case '5':
+      _filetype = ENTRY_DIR;
+      break;
+    case '6':
       _filetype = ENTRY_FIFO;
-    } else {
-       _filetype = ENTRY_NOT_DEFINED;
-    }
+      break;
+    default:
+      _filetype = ENTRY_NOT_DEFINED;
   }
-  _readoffset = 0;
 }
 
 std::unique_ptr<std::ifstream> TarArchive::release_file_stream() {
   auto out = std::move(_stream);
-  if (_handle != nullptr) {
-    tar_close(void_ptr_to_tar_ptr(_handle));
-    _handle = nullptr;
-  }
   _readoffset = 0;
   _current_header = 0;
+  _data_offset = 0;
   mark_end_of_file();
-  if (_instance_handle >= 0) {
-    remove_from_register(_instance_handle);
-  }
-  _instance_handle = -1;
   return out;
 }
+
+void parse_tar_file(const std::string& tar_path,
+                    std::vector<SampleDescription>& samples_container,
+                    std::vector<ComponentDescription>& components_container) {
+  auto tar_file = std::make_unique<std::ifstream>(tar_path, std::ios::binary);
+  if (!tar_file->is_open())
+    THROW("Failed to open the tar file " + tar_path);
+  TarArchive tar_archive(std::move(tar_file));
+
+  std::string last_filename;
+  for (; !tar_archive.at_end_of_archive(); tar_archive.advance_to_next_file_in_tar()) {
+    if (tar_archive.get_current_file_type() == TarArchive::ENTRY_FILE) {
+      std::tie(last_filename, std::ignore) = split_name(tar_archive.get_current_file_name());
+      break;
+    }
+  }
+  size_t last_components_size = components_container.size();
+  for (; !tar_archive.at_end_of_archive(); tar_archive.advance_to_next_file_in_tar()) {
+    if (tar_archive.get_current_file_type() != TarArchive::ENTRY_FILE) {
+      continue;
+    }
+
+    std::string basename, ext;
+    std::tie(basename, ext) = split_name(tar_archive.get_current_file_name());
+    if (basename.empty()) {
+      continue;
+    }
+
+    if (basename != last_filename) {
+      samples_container.emplace_back();
+      samples_container.back().components = VectorView<ComponentDescription>(components_container, last_components_size, components_container.size() - last_components_size);
+      last_filename = basename;
+      last_components_size = components_container.size();
+    }
+    components_container.emplace_back();
+    components_container.back().size = tar_archive.get_current_file_size();
+    components_container.back().offset = tar_archive.get_current_archive_offset() + tar_archive.get_current_header_size();
+    components_container.back().ext = std::move(ext);
+    auto last_id = basename;
+    auto last_slash_idx = last_id.find_last_of("\\/");
+    if (std::string::npos != last_slash_idx) {
+      last_id.erase(0, last_slash_idx + 1);
+    }
+    components_container.back().filename = last_id;
+  }
+  samples_container.emplace_back();
+  samples_container.back().components = VectorView<ComponentDescription>(components_container, last_components_size, components_container.size() - last_components_size);
+}
+
+void parse_index_file(const std::string& index_path,
+                      std::vector<SampleDescription>& samples_container,
+                      std::vector<ComponentDescription>& components_container) {
+  std::ifstream index_file(index_path);
+  std::string global_meta;
+  getline(index_file, global_meta);
+  std::stringstream global_meta_stream(global_meta);
+  std::string index_version_str;
+  if (!(global_meta_stream >> index_version_str))
+    THROW("Unsupported version of the index file")
+
+  int index_version = parse_index_version(index_version_str);
+
+  int64_t sample_desc_num_signed;
+  if (!(global_meta_stream >> sample_desc_num_signed))
+    THROW("no sample count found")
+  if (!(sample_desc_num_signed > 0))
+    THROW("sample count must be positive")
+
+  const size_t sample_desc_num = sample_desc_num_signed;
+  samples_container.reserve(samples_container.size() + sample_desc_num);
+  for (size_t sample_index = 0; sample_index < sample_desc_num; sample_index++) {
+    parse_sample_description(samples_container, components_container, index_file, sample_index + 1, index_version);
+  }
+}
 #endif
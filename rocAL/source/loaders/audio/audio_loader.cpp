@@ -56,6 +56,10 @@ void AudioLoader::set_prefetch_queue_depth(size_t prefetch_queue_depth) {
     _prefetch_queue_depth = prefetch_queue_depth;
 }
 
+void AudioLoader::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _decode_pool = std::move(decode_pool);
+}
+
 void AudioLoader::set_gpu_device_id(int device_id) {
     if (device_id < 0)
         THROW("invalid device_id passed to loader");
@@ -119,6 +123,7 @@ void AudioLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _batch_size = batch_size;
     _loop = reader_cfg.loop();
     _audio_loader = std::make_shared<AudioReadAndDecode>();
+    _audio_loader->set_decode_pool(_decode_pool);
     size_t shard_count = reader_cfg.get_shard_count();
     int device_id = reader_cfg.get_shard_id();
     try {
@@ -190,10 +195,10 @@ AudioLoader::load_routine() {
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // The loader thread then sleeps since there is no more data to read,
+            // till program ends, reset is called or new data is fed to the loader
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            _circ_buff.wait_for_new_data();
         }
     }
     return LoaderModuleStatus::OK;
@@ -34,6 +34,10 @@ void AudioLoaderSharded::set_prefetch_queue_depth(size_t prefetch_queue_depth) {
     _prefetch_queue_depth = prefetch_queue_depth;
 }
 
+void AudioLoaderSharded::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _decode_pool = std::move(decode_pool);
+}
+
 std::vector<std::string> AudioLoaderSharded::get_id() {
     if (!_initialized)
         THROW("get_id() should be called after initialize() function");
@@ -82,6 +86,7 @@ void AudioLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     for (size_t i = 0; i < _shard_count; i++) {
         std::shared_ptr loader = std::make_shared<AudioLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_decode_pool(_decode_pool);
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -111,8 +111,7 @@ AudioReadAndDecode::Load(float *audio_buffer,
         for (size_t i = 0; i < _batch_size; i++) {
             _decompressed_buff_ptrs[i] = audio_buffer + (audio_size * i);
         }
-#pragma omp parallel for num_threads(_num_threads)  // default(none) TBD: option disabled in Ubuntu 20.04
-        for (size_t i = 0; i < _batch_size; i++) {
+        auto decode_audio = [&](size_t i) {
             int original_samples, original_channels;
             float original_sample_rate;
             if (_decoder[i]->Initialize(_audio_meta_info[i].file_path.c_str()) != AudioDecoder::Status::OK) {
@@ -128,6 +127,13 @@ AudioReadAndDecode::Load(float *audio_buffer,
                 THROW("Decoder failed for file: " + _audio_meta_info[i].file_name.c_str())
             }
             _decoder[i]->Release();
+        };
+        if (_decode_pool) {
+            _decode_pool->parallel_for(_batch_size, [&decode_audio](size_t i, size_t) { decode_audio(i); }, _num_threads);
+        } else {
+#pragma omp parallel for num_threads(_num_threads)  // default(none) TBD: option disabled in Ubuntu 20.04
+            for (size_t i = 0; i < _batch_size; i++)
+                decode_audio(i);
         }
         for (size_t i = 0; i < _batch_size; i++) {
             audio_info._data_names[i] = _audio_meta_info[i].file_name;
@@ -53,6 +53,8 @@ void CircularBuffer::unblock_reader() {
         return;
     // Wake up the reader thread in case it's waiting for a load
     _wait_for_load.notify_one();
+    if (_push_callback)
+        _push_callback();
 }
 
 void CircularBuffer::unblock_writer() {
@@ -60,6 +62,22 @@ void CircularBuffer::unblock_writer() {
         return;
     // Wake up the writer thread in case it's waiting for an unload
     _wait_for_unload.notify_one();
+    // or waiting for its source to have new data
+    notify_new_data();
+}
+
+void CircularBuffer::wait_for_new_data() {
+    std::unique_lock<std::mutex> lock(_lock);
+    _wait_for_new_data.wait(lock, [this] { return _new_data_available; });
+    _new_data_available = false;
+}
+
+void CircularBuffer::notify_new_data() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _new_data_available = true;
+    }
+    _wait_for_new_data.notify_all();
 }
 
 void *CircularBuffer::get_read_buffer_dev() {
@@ -305,6 +323,7 @@ bool CircularBuffer::full() {
 }
 
 size_t CircularBuffer::level() {
+    std::unique_lock<std::mutex> lock(_lock);
     return _level;
 }
 
@@ -324,6 +343,8 @@ void CircularBuffer::increment_write_ptr() {
     lock.unlock();
     // Wake up the reader thread (in case waiting) since there is a new load to be read
     _wait_for_load.notify_all();
+    if (_push_callback)
+        _push_callback();
 }
 
 void CircularBuffer::block_if_empty() {
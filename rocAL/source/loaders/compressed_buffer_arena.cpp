@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "loaders/compressed_buffer_arena.h"
+
+#include <algorithm>
+
+void CompressedBufferArena::add_chunk(size_t size) {
+    // The memory is left uninitialized, pages the payloads never reach are not backed
+    _chunks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+    _capacity += size;
+    _offset = 0;
+}
+
+unsigned char *CompressedBufferArena::allocate(size_t size) {
+    size_t aligned_size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    std::unique_lock<std::mutex> lock(_lock);
+    if (_chunks.empty() || _offset + aligned_size > _chunks.back().size)
+        // Growing geometrically bounds the number of chunks a batch much larger than the previous ones adds
+        add_chunk(std::max({aligned_size, MIN_CHUNK_SIZE, _capacity}));
+    auto buffer = _chunks.back().data.get() + _offset;
+    _offset += aligned_size;
+    _batch_bytes += aligned_size;
+    return buffer;
+}
+
+void CompressedBufferArena::reset() {
+    std::unique_lock<std::mutex> lock(_lock);
+    // A quarter of headroom absorbs the usual variation of the batch size without adding chunks
+    size_t target_size = std::max(_batch_bytes + _batch_bytes / 4, MIN_CHUNK_SIZE);
+    if (_chunks.size() > 1 || (_capacity > 4 * target_size && _batch_bytes > 0)) {
+        _chunks.clear();
+        _capacity = 0;
+        add_chunk(target_size);
+    }
+    _offset = 0;
+    _batch_bytes = 0;
+}
+
+size_t CompressedBufferArena::capacity() {
+    std::unique_lock<std::mutex> lock(_lock);
+    return _capacity;
+}
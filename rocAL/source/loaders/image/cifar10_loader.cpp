@@ -229,10 +229,10 @@ CIFAR10Loader::load_routine() {
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // The loader thread then sleeps since there is no more data to read,
+            // till program ends, reset is called or new data is fed to the loader
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            _circ_buff.wait_for_new_data();
         }
     }
     return LoaderModuleStatus::OK;
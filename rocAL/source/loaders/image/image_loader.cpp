@@ -66,6 +66,33 @@ void ImageLoader::set_gpu_device_id(int device_id) {
     _device_id = device_id;
 }
 
+void ImageLoader::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _decode_pool = std::move(decode_pool);
+}
+
+void ImageLoader::set_decode_quality(DecodeQuality decode_quality) {
+    _decode_quality = decode_quality;
+}
+
+void ImageLoader::set_io_depth(size_t io_depth) {
+    _io_depth = io_depth;
+}
+
+void ImageLoader::set_decode_size_hint(size_t width, size_t height) {
+    _decode_width_hint = width;
+    _decode_height_hint = height;
+    if (_image_loader)
+        _image_loader->set_decode_size_hint(width, height);
+}
+
+void ImageLoader::set_ready_callback(std::function<void()> callback) {
+    _circ_buff.set_push_callback(std::move(callback));
+}
+
+bool ImageLoader::is_ready() {
+    return _stopped || is_out_of_data() || _circ_buff.level() > 0;
+}
+
 size_t
 ImageLoader::remaining_count() {
     if (_external_source_reader) {
@@ -142,6 +169,11 @@ void ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _loop = reader_cfg.loop();
     _decoder_keep_original = decoder_keep_original;
     _image_loader = std::make_shared<ImageReadAndDecode>();
+    _image_loader->set_decode_pool(_decode_pool);
+    _image_loader->set_decode_size_hint(_decode_width_hint, _decode_height_hint);
+    decoder_cfg.set_decode_quality(_decode_quality);
+    if (_io_depth)
+        reader_cfg.set_io_depth(_io_depth);
     size_t shard_count = reader_cfg.get_shard_count();
     int device_id = reader_cfg.get_shard_id();
 #if ENABLE_HIP
@@ -236,10 +268,10 @@ ImageLoader::load_routine() {
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // The loader thread then sleeps since there is no more data to read,
+            // till program ends, reset is called or new data is fed to the loader
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            _circ_buff.wait_for_new_data();
         }
     }
     return LoaderModuleStatus::OK;
@@ -314,4 +346,5 @@ void ImageLoader::feed_external_input(const std::vector<std::string>& input_imag
     _external_source_reader = true;
     _external_input_eos = eos;
     _image_loader->feed_external_input(input_images_names, input_buffer, roi_xywh, max_width, max_height, channels, mode, eos);
+    _circ_buff.notify_new_data();  // Wake up the loader thread if it ran out of data before this feed
 }
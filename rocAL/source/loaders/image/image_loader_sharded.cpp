@@ -22,6 +22,8 @@ THE SOFTWARE.
 
 #include "loaders/image/image_loader_sharded.h"
 
+#include <algorithm>
+
 ImageLoaderSharded::ImageLoaderSharded(void* dev_resources) : _dev_resources(dev_resources) {
     _loader_idx = 0;
 }
@@ -32,6 +34,27 @@ void ImageLoaderSharded::set_prefetch_queue_depth(size_t prefetch_queue_depth) {
     _prefetch_queue_depth = prefetch_queue_depth;
 }
 
+void ImageLoaderSharded::set_deterministic_order(bool deterministic_order) {
+    _deterministic_order = deterministic_order;
+}
+
+void ImageLoaderSharded::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _decode_pool = std::move(decode_pool);
+}
+
+void ImageLoaderSharded::set_decode_quality(DecodeQuality decode_quality) {
+    _decode_quality = decode_quality;
+}
+
+void ImageLoaderSharded::set_io_depth(size_t io_depth) {
+    _io_depth = io_depth;
+}
+
+void ImageLoaderSharded::set_decode_size_hint(size_t width, size_t height) {
+    for (auto &loader : _loaders)
+        loader->set_decode_size_hint(width, height);
+}
+
 std::vector<std::string> ImageLoaderSharded::get_id() {
     if (!_initialized)
         THROW("get_id() should be called after initialize() function");
@@ -48,6 +71,7 @@ CropImageInfo ImageLoaderSharded::get_crop_image_info() {
 
 ImageLoaderSharded::~ImageLoaderSharded() {
     _loaders.clear();
+    _decode_pool.reset();
 }
 
 void ImageLoaderSharded::fast_forward_through_empty_loaders() {
@@ -57,15 +81,50 @@ void ImageLoaderSharded::fast_forward_through_empty_loaders() {
         increment_loader_idx();
 }
 
+void ImageLoaderSharded::notify_ready() {
+    // Taking the lock orders the notification after the check of a consumer about to wait, so no push is missed
+    std::unique_lock<std::mutex> lock(_ready_lock);
+    _ready_cv.notify_one();
+}
+
+void ImageLoaderSharded::wait_for_ready_loader() {
+    std::unique_lock<std::mutex> lock(_ready_lock);
+    while (true) {
+        bool has_data = false;
+        // Start after the current loader, so that none of them is starved when several are ready
+        for (size_t i = 1; i <= _shard_count; i++) {
+            size_t idx = (_loader_idx + i) % _shard_count;
+            if (_loaders[idx]->remaining_count() == 0)
+                continue;
+            has_data = true;
+            if (_loaders[idx]->is_ready()) {
+                _loader_idx = idx;
+                return;
+            }
+        }
+        // With every loader empty the round robin path below reports the end of data as before
+        if (!has_data || _stopped) {
+            increment_loader_idx();
+            fast_forward_through_empty_loaders();
+            return;
+        }
+        _ready_cv.wait(lock);
+    }
+}
+
 LoaderModuleStatus ImageLoaderSharded::load_next() {
     if (!_initialized)
         return LoaderModuleStatus::NOT_INITIALIZED;
 
-    increment_loader_idx();
+    if (_deterministic_order || _shard_count == 1) {
+        increment_loader_idx();
 
-    // Since loaders may have different number of images loaded, some run out earlier than other.
-    // Fast forward through loaders that are empty to get to a loader that is not empty.
-    fast_forward_through_empty_loaders();
+        // Since loaders may have different number of images loaded, some run out earlier than other.
+        // Fast forward through loaders that are empty to get to a loader that is not empty.
+        fast_forward_through_empty_loaders();
+    } else {
+        wait_for_ready_loader();
+    }
 
     auto ret = _loaders[_loader_idx]->load_next();
 
@@ -76,10 +135,18 @@ void ImageLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     if (_initialized)
         return;
     _shard_count = reader_cfg.get_shard_count();
+    // A single pool replaces the OpenMP teams each loader would start, so the shards never run more decode threads than the cpu thread budget
+    // rocJpeg decodes the whole batch on the device and does not need it
+    if (!_decode_pool && _shard_count > 1 && decoder_cfg._type != DecoderType::ROCJPEG_DEC)
+        _decode_pool = std::make_shared<ThreadPool>(std::max<size_t>(reader_cfg.get_cpu_num_threads(), 1) * _shard_count);
     // Create loader modules
     for (size_t i = 0; i < _shard_count; i++) {
         std::shared_ptr loader = std::make_shared<ImageLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_decode_pool(_decode_pool);
+        loader->set_decode_quality(_decode_quality);
+        loader->set_io_depth(_io_depth);
+        loader->set_ready_callback([this] { notify_ready(); });
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -94,12 +161,21 @@ void ImageLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     _initialized = true;
 }
 void ImageLoaderSharded::start_loading() {
+    {
+        std::unique_lock<std::mutex> lock(_ready_lock);
+        _stopped = false;
+    }
     for (unsigned i = 0; i < _loaders.size(); i++) {
         _loaders[i]->start_loading();
     }
 }
 
 void ImageLoaderSharded::shut_down() {
+    {
+        std::unique_lock<std::mutex> lock(_ready_lock);
+        _stopped = true;
+    }
+    _ready_cv.notify_all();
     for (unsigned i = 0; i < _loaders.size(); i++)
         _loaders[i]->shut_down();
 }
@@ -131,6 +207,8 @@ Timing ImageLoaderSharded::timing() {
     long long unsigned max_decode_time = 0;
     long long unsigned max_read_time = 0;
     long long unsigned swap_handle_time = 0;
+    long long unsigned max_file_read_time = 0;
+    long long unsigned max_read_wait_time = 0;
 
     // image read and decode runs in parallel using multiple loaders, and the observable latency that the ImageLoaderSharded user
     // is experiences on the load_next() call due to read and decode time is the maximum of all
@@ -138,10 +216,15 @@ Timing ImageLoaderSharded::timing() {
         auto info = loader->timing();
         max_read_time = (info.read_time > max_read_time) ? info.read_time : max_read_time;
         max_decode_time = (info.decode_time > max_decode_time) ? info.decode_time : max_decode_time;
+        max_file_read_time = (info.file_read_time > max_file_read_time) ? info.file_read_time : max_file_read_time;
+        max_read_wait_time = (info.read_wait_time > max_read_wait_time) ? info.read_wait_time : max_read_wait_time;
         swap_handle_time += info.process_time;
+        t.compressed_buffer_size += info.compressed_buffer_size;
     }
     t.decode_time = max_decode_time;
     t.read_time = max_read_time;
+    t.file_read_time = max_file_read_time;
+    t.read_wait_time = max_read_wait_time;
     t.process_time = swap_handle_time;
     return t;
 }
@@ -22,7 +22,13 @@ THE SOFTWARE.
 
 #include "loaders/image/image_read_and_decode.h"
 
+#include <fcntl.h>
 #include <omp.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <iterator>
 
@@ -51,6 +57,9 @@ ImageReadAndDecode::timing() {
     Timing t;
     t.decode_time = _decode_time.get_timing();
     t.read_time = _file_load_time.get_timing();
+    t.file_read_time = _file_read_time_us.load();
+    t.read_wait_time = _read_wait_time_us.load();
+    t.compressed_buffer_size = _compressed_arena.capacity();
     return t;
 }
 
@@ -59,6 +68,7 @@ ImageReadAndDecode::ImageReadAndDecode() : _file_load_time("FileLoadTime", DBG_T
 }
 
 ImageReadAndDecode::~ImageReadAndDecode() {
+    _io_pool = nullptr;
     _reader = nullptr;
     _decoder.clear();
 }
@@ -66,7 +76,7 @@ ImageReadAndDecode::~ImageReadAndDecode() {
 void ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_config, int batch_size, int device_id) {
     // Can initialize it to any decoder types if needed
     _batch_size = batch_size;
-    _compressed_buff.resize(batch_size);
+    _compressed_data.resize(batch_size);
     _decoder.resize(batch_size);
     _actual_read_size.resize(batch_size);
     _image_names.resize(batch_size);
@@ -88,14 +98,10 @@ void ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decode
     }
     if ((_decoder_config._type != DecoderType::SKIP_DECODE)) {
         if (_decoder_config._type == DecoderType::ROCJPEG_DEC) {
-            for (int i = 0; i < batch_size; i++) {
-                _compressed_buff[i].resize(MAX_COMPRESSED_SIZE);  // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
-            }
             _rocjpeg_decoder = create_decoder(decoder_config);
             _rocjpeg_decoder->initialize(device_id, batch_size);
         } else {
             for (int i = 0; i < batch_size; i++) {
-                _compressed_buff[i].resize(MAX_COMPRESSED_SIZE);  // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
                 _decoder[i] = create_decoder(decoder_config);
                 _decoder[i]->initialize(device_id);
             }
@@ -104,6 +110,55 @@ void ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decode
     _num_threads = reader_config.get_cpu_num_threads();
     _reader = create_reader(reader_config);
     _is_external_source = (reader_config.type() == StorageType::EXTERNAL_FILE_SOURCE);
+    // Readers exposing plain file paths get their files read concurrently by the I/O workers, so decode overlaps with the reads
+    size_t io_depth = reader_config.get_io_depth();
+    if (io_depth > 1 && _decoder_config._type != DecoderType::SKIP_DECODE && !_is_external_source && _reader->supports_path_read()) {
+        _io_pool = std::make_unique<ThreadPool>(std::min(io_depth, _batch_size));
+        _read_done.resize(_batch_size);
+    }
+}
+
+void ImageReadAndDecode::read_file(const std::string &file_path, size_t idx) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    size_t file_size = 0, read_size = 0;
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0)
+            file_size = file_stat.st_size;
+        _compressed_data[idx] = _compressed_arena.allocate(file_size);
+        while (read_size < file_size) {
+            ssize_t ret = pread(fd, _compressed_data[idx] + read_size, file_size - read_size, read_size);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                break;
+            read_size += ret;
+        }
+        ::close(fd);
+    } else {
+        _compressed_data[idx] = _compressed_arena.allocate(0);
+    }
+    if (read_size == 0)
+        WRN("Opened file " + file_path + " of size 0")
+    else if (read_size < file_size)
+        LOG("Reader read less than requested bytes of size: " + TOSTR(read_size))
+    _actual_read_size[idx] = read_size;
+    _compressed_image_size[idx] = read_size;
+    auto end_time = std::chrono::high_resolution_clock::now();
+    _file_read_time_us += std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+}
+
+void ImageReadAndDecode::wait_for_read(size_t idx) {
+    if (!_io_pool || !_read_done[idx].valid())
+        return;
+    auto read_done = _read_done[idx];  // Each decode thread waits on its own copy of the shared state
+    if (read_done.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        return;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    read_done.wait();
+    auto end_time = std::chrono::high_resolution_clock::now();
+    _read_wait_time_us += std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
 }
 
 void ImageReadAndDecode::feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
@@ -188,9 +243,12 @@ ImageReadAndDecode::load(unsigned char *buff,
     const bool keep_original = decoder_keep_original;
     const size_t image_size = max_decoded_width * max_decoded_height * output_planes * sizeof(unsigned char);
     bool skip_decode = _decoder_config._type == DecoderType::SKIP_DECODE;
+    _decoder_config.set_decode_size_hint(_decode_width_hint, _decode_height_hint);
     // Decode with the height and size equal to a single image
-    // File read is done serially since I/O parallelization does not work very well.
+    // File read is done serially unless the reader supports path based reads, in which case the reads are issued on the I/O workers
     _file_load_time.start();  // Debug timing
+    // The decode of the previous batch has completed, none of its compressed payloads is referenced anymore
+    _compressed_arena.reset();
     if (_decoder_config._type == DecoderType::SKIP_DECODE) {
         while ((file_counter != _batch_size) && _reader->count_items() > 0) {
             auto read_ptr = buff + image_size * file_counter;
@@ -251,8 +309,8 @@ ImageReadAndDecode::load(unsigned char *buff,
                     WRN("Opened file " + _reader->id() + " of size 0");
                     continue;
                 }
-                _compressed_buff[file_counter].reserve(fsize);
-                _actual_read_size[file_counter] = _reader->read_data(_compressed_buff[file_counter].data(), fsize);
+                _compressed_data[file_counter] = _compressed_arena.allocate(fsize);
+                _actual_read_size[file_counter] = _reader->read_data(_compressed_data[file_counter], fsize);
                 _image_names[file_counter] = _reader->id();
                 _reader->close();
                 _compressed_image_size[file_counter] = fsize;
@@ -260,28 +318,41 @@ ImageReadAndDecode::load(unsigned char *buff,
             }
         }
         // return LoaderModuleStatus::OK;
+    } else if (_io_pool) {
+        // Only the file names are fetched here, decode of a sample starts as soon as its read completes
+        while ((file_counter != _batch_size) && _reader->count_items() > 0) {
+            auto file_path = _reader->next_file_path();
+            _image_names[file_counter] = _reader->id();
+            _read_done[file_counter] = _io_pool->submit([this, file_path, file_counter]() { read_file(file_path, file_counter); });
+            file_counter++;
+        }
     } else {
+        // Readers backed by a mapping hand out the items in place, the decoders read them without a copy
+        bool mapped_read = _reader->supports_mapped_read();
         while ((file_counter != _batch_size) && _reader->count_items() > 0) {
             size_t fsize = _reader->open();
             if (fsize == 0) {
                 WRN("Opened file " + _reader->id() + " of size 0");
                 continue;
             }
-            _compressed_buff[file_counter].reserve(fsize);
-            _actual_read_size[file_counter] = _reader->read_data(_compressed_buff[file_counter].data(), fsize);
+            if (mapped_read) {
+                _compressed_data[file_counter] = _reader->mapped_data(_actual_read_size[file_counter]);
+            } else {
+                _compressed_data[file_counter] = _compressed_arena.allocate(fsize);
+                _actual_read_size[file_counter] = _reader->read_data(_compressed_data[file_counter], fsize);
+            }
             _image_names[file_counter] = _reader->id();
             _reader->close();
             _compressed_image_size[file_counter] = fsize;
             file_counter++;
         }
-        if (_randombboxcrop_meta_data_reader) {
-            // Fetch the crop co-ordinates for a batch of images
-            _bbox_coords = _randombboxcrop_meta_data_reader->get_batch_crop_coords(_image_names);
-            set_batch_random_bbox_crop_coords(_bbox_coords);
-        } else if (_random_crop_dec_param) {
-            _random_crop_dec_param->generate_random_seeds();
-        }
     }
+    // The random bbox crops are sampled per image along with the decode below
+    const bool sample_bbox_crops = !skip_decode && !_is_external_source && _randombboxcrop_meta_data_reader;
+    if (!skip_decode && !_is_external_source && !_randombboxcrop_meta_data_reader && _random_crop_dec_param)
+        _random_crop_dec_param->generate_random_seeds();
+    if (sample_bbox_crops)
+        _bbox_coords.resize(_batch_size);
 
     _file_load_time.end();  // Debug timing
 
@@ -291,21 +362,22 @@ ImageReadAndDecode::load(unsigned char *buff,
             _decompressed_buff_ptrs[i] = buff + image_size * i;
 
         if (_decoder_config._type != DecoderType::ROCJPEG_DEC) {
-#pragma omp parallel for num_threads(_num_threads)
-            for (size_t i = 0; i < _batch_size; i++) {
+            auto decode_sample = [&](size_t i) {
+                wait_for_read(i);
                 // initialize the actual decoded height and width with the maximum
                 _actual_decoded_width[i] = max_decoded_width;
                 _actual_decoded_height[i] = max_decoded_height;
                 int original_width, original_height, jpeg_sub_samp;
-                if (_decoder[i]->decode_info(_compressed_buff[i].data(), _actual_read_size[i], &original_width, &original_height,
+                if (_decoder[i]->decode_info(_compressed_data[i], _actual_read_size[i], &original_width, &original_height,
                                             &jpeg_sub_samp) != Decoder::Status::OK) {
                     // Substituting the image which failed decoding with other image from the same batch
                     int j = ((i + 1) != _batch_size) ? _batch_size - 1 : _batch_size - 2;
                     while ((j >= 0)) {
-                        if (_decoder[i]->decode_info(_compressed_buff[j].data(), _actual_read_size[j], &original_width, &original_height,
+                        wait_for_read(j);
+                        if (_decoder[i]->decode_info(_compressed_data[j], _actual_read_size[j], &original_width, &original_height,
                                                     &jpeg_sub_samp) == Decoder::Status::OK) {
                             _image_names[i] = _image_names[j];
-                            _compressed_buff[i] = _compressed_buff[j];
+                            _compressed_data[i] = _compressed_data[j];
                             _actual_read_size[i] = _actual_read_size[j];
                             _compressed_image_size[i] = _compressed_image_size[j];
                             break;
@@ -319,6 +391,9 @@ ImageReadAndDecode::load(unsigned char *buff,
                 }
                 _original_height[i] = original_height;
                 _original_width[i] = original_width;
+                // The crop streams are keyed on the image, so sampling them here gives the same crops for any thread count
+                if (sample_bbox_crops)
+                    _bbox_coords[i] = _randombboxcrop_meta_data_reader->get_crop_coords(_image_names[i]);
                 // decode the image and get the actual decoded image width and height
                 size_t scaledw, scaledh;
                 if (_decoder[i]->is_partial_decoder()) {
@@ -330,7 +405,7 @@ ImageReadAndDecode::load(unsigned char *buff,
                         _decoder[i]->set_crop_window(crop_window);
                     }
                 }
-                if (_decoder[i]->decode(_compressed_buff[i].data(), _compressed_image_size[i], _decompressed_buff_ptrs[i],
+                if (_decoder[i]->decode(_compressed_data[i], _compressed_image_size[i], _decompressed_buff_ptrs[i],
                                         max_decoded_width, max_decoded_height,
                                         original_width, original_height,
                                         scaledw, scaledh,
@@ -338,6 +413,15 @@ ImageReadAndDecode::load(unsigned char *buff,
                 }
                 _actual_decoded_width[i] = scaledw;
                 _actual_decoded_height[i] = scaledh;
+            };
+            if (_decode_pool) {
+                // The pool is shared with the other loaders and pipelines, so the samples are decoded by whichever workers they leave idle,
+                // at most _num_threads at a time like the OpenMP team
+                _decode_pool->parallel_for(_batch_size, [&decode_sample](size_t i, size_t) { decode_sample(i); }, _num_threads);
+            } else {
+#pragma omp parallel for num_threads(_num_threads)
+                for (size_t i = 0; i < _batch_size; i++)
+                    decode_sample(i);
             }
         } else if (_decoder_config._type == DecoderType::ROCJPEG_DEC) {
 #if ENABLE_HIP
@@ -351,22 +435,25 @@ ImageReadAndDecode::load(unsigned char *buff,
                 _set_device_id = true;
             }
 #endif
+            // rocJpeg decodes the whole batch at once, so all the reads have to complete first
+            for (size_t i = 0; i < _batch_size; i++)
+                wait_for_read(i);
             // Iterate through each image in the batch and obtain the decode info
             for (size_t i = 0; i < _batch_size; i++) {
                 _actual_decoded_width[i] = max_decoded_width;
                 _actual_decoded_height[i] = max_decoded_height;
                 int original_width, original_height, decoded_width, decoded_height;
-                if (_rocjpeg_decoder->decode_info(_compressed_buff[i].data(), _actual_read_size[i], &original_width, &original_height,
+                if (_rocjpeg_decoder->decode_info(_compressed_data[i], _actual_read_size[i], &original_width, &original_height,
                                             &decoded_width, &decoded_height, 
                                             max_decoded_width, max_decoded_height, decoder_color_format, i) != Decoder::Status::OK) {
                     // Substituting the image which failed decoding with other image from the same batch
                     int j = ((i + 1) != _batch_size) ? _batch_size - 1 : _batch_size - 2;
                     while ((j >= 0)) {
-                        if (_rocjpeg_decoder->decode_info(_compressed_buff[j].data(), _actual_read_size[j], &original_width, &original_height,
+                        if (_rocjpeg_decoder->decode_info(_compressed_data[j], _actual_read_size[j], &original_width, &original_height,
                                                     &decoded_width, &decoded_height, 
                                                     max_decoded_width, max_decoded_height, decoder_color_format, i) == Decoder::Status::OK) {
                             _image_names[i] = _image_names[j];
-                            _compressed_buff[i] = _compressed_buff[j];
+                            _compressed_data[i] = _compressed_data[j];
                             _actual_read_size[i] = _actual_read_size[j];
                             _compressed_image_size[i] = _compressed_image_size[j];
                             break;
@@ -383,6 +470,17 @@ ImageReadAndDecode::load(unsigned char *buff,
                 _actual_decoded_height[i] = decoded_height;
             }
             
+            if (sample_bbox_crops) {
+                auto sample_crop = [this](size_t i) { _bbox_coords[i] = _randombboxcrop_meta_data_reader->get_crop_coords(_image_names[i]); };
+                if (_decode_pool) {
+                    _decode_pool->parallel_for(_batch_size, [&sample_crop](size_t i, size_t) { sample_crop(i); }, _num_threads);
+                } else {
+#pragma omp parallel for num_threads(_num_threads)
+                    for (size_t i = 0; i < _batch_size; i++)
+                        sample_crop(i);
+                }
+            }
+
             if (_rocjpeg_decoder->decode_batch(_decompressed_buff_ptrs,
                                                max_decoded_width, max_decoded_height,
                                                _original_width, _original_height,
@@ -398,7 +496,11 @@ ImageReadAndDecode::load(unsigned char *buff,
             actual_width[i] = _original_width[i];
             actual_height[i] = _original_height[i];
         }
+        if (sample_bbox_crops)
+            set_batch_random_bbox_crop_coords(std::move(_bbox_coords));
     }
+    if (_io_pool)
+        _io_pool->wait_all();
     _bbox_coords.clear();
     _decode_time.end();  // Debug timing
     return LoaderModuleStatus::OK;
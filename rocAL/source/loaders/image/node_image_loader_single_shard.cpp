@@ -30,7 +30,8 @@ ImageLoaderSingleShardNode::ImageLoaderSingleShardNode(Tensor *output, void *dev
 
 void ImageLoaderSingleShardNode::init(unsigned shard_id, unsigned shard_count, unsigned cpu_num_threads, const std::string &source_path, const std::string &json_path, StorageType storage_type, DecoderType decoder_type,
                                       bool shuffle, bool loop, size_t load_batch_count, RocalMemType mem_type, std::shared_ptr<MetaDataReader> meta_data_reader,
-                                      bool decoder_keep_original, const ShardingInfo& sharding_info, const std::map<std::string, std::string> feature_key_map, unsigned sequence_length, unsigned step, unsigned stride, ExternalSourceFileMode external_file_mode, const std::string &index_path) {
+                                      bool decoder_keep_original, const ShardingInfo& sharding_info, const std::map<std::string, std::string> feature_key_map, unsigned sequence_length, unsigned step, unsigned stride, ExternalSourceFileMode external_file_mode, const std::string &index_path,
+                                      size_t shuffle_buffer_size, size_t max_open_files) {
     if (!_loader_module)
         THROW("ERROR: loader module is not set for ImageLoaderNode, cannot initialize")
     if (shard_count < 1)
@@ -51,6 +52,8 @@ void ImageLoaderSingleShardNode::init(unsigned shard_id, unsigned shard_count, u
     reader_cfg.set_frame_stride(stride);
     reader_cfg.set_external_filemode(external_file_mode);
     reader_cfg.set_index_path(index_path);
+    reader_cfg.set_shuffle_buffer_size(shuffle_buffer_size);
+    reader_cfg.set_max_open_files(max_open_files);
     reader_cfg.set_sharding_info(sharding_info);
     _loader_module->initialize(reader_cfg, DecoderConfig(decoder_type),
                                mem_type,
@@ -28,8 +28,9 @@ NumpyLoaderNode::NumpyLoaderNode(Tensor *output, void *device_resources) : Node(
     _loader_module = std::make_shared<NumpyLoaderSharded>(device_resources);
 }
 
-void NumpyLoaderNode::init(unsigned internal_shard_count, const std::string &source_path, const std::vector<std::string> &files, StorageType storage_type, DecoderType decoder_type, bool shuffle, bool loop,
-                           size_t load_batch_count, RocalMemType mem_type, unsigned seed, const ShardingInfo& sharding_info) {
+void NumpyLoaderNode::init(unsigned internal_shard_count, unsigned cpu_num_threads, const std::string &source_path, const std::vector<std::string> &files, StorageType storage_type, DecoderType decoder_type, bool shuffle, bool loop,
+                           size_t load_batch_count, RocalMemType mem_type, unsigned seed, const ShardingInfo& sharding_info,
+                           const std::vector<unsigned> &roi_start, const std::vector<unsigned> &roi_shape) {
     if (!_loader_module)
         THROW("ERROR: loader module is not set for NumpyLoaderNode, cannot initialize")
     if (internal_shard_count < 1)
@@ -38,10 +39,12 @@ void NumpyLoaderNode::init(unsigned internal_shard_count, const std::string &sou
     // Set reader and decoder config accordingly for the NumpyLoaderNode
     auto reader_cfg = ReaderConfig(storage_type, source_path, "", std::map<std::string, std::string>(), shuffle, loop);
     reader_cfg.set_shard_count(internal_shard_count);
+    reader_cfg.set_cpu_num_threads(cpu_num_threads);
     reader_cfg.set_batch_count(load_batch_count);
     reader_cfg.set_sharding_info(sharding_info);
     reader_cfg.set_files_list(files);
     reader_cfg.set_seed(seed);
+    reader_cfg.set_numpy_roi(roi_start, roi_shape);
     _loader_module->initialize(reader_cfg, DecoderConfig(DecoderType::SKIP_DECODE), mem_type, _batch_size);
     _loader_module->start_loading();
 }
@@ -22,7 +22,9 @@ THE SOFTWARE.
 
 #include "loaders/image/numpy_loader.h"
 
+#include <algorithm>
 #include <chrono>
+#include <numeric>
 #include <thread>
 
 #include "vx_ext_amd.h"
@@ -100,6 +102,10 @@ NumpyLoader::load_next() {
     return update_output_tensor();
 }
 
+void NumpyLoader::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _read_pool = std::move(decode_pool);
+}
+
 void NumpyLoader::set_output(Tensor *output_tensor) {
     _output_tensor = output_tensor;
     _output_mem_size = ((_output_tensor->info().data_size() + 8) & ~7);
@@ -135,6 +141,14 @@ void NumpyLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     }
     _decoded_data_info._data_names.resize(_batch_size);
     _tensor_roi.resize(_batch_size);
+    _roi_start = reader_cfg.get_numpy_roi_start();
+    _roi_shape = reader_cfg.get_numpy_roi_shape();
+    _sample_path.resize(_batch_size);
+    _sample_header.resize(_batch_size);
+    _sample_start.resize(_batch_size);
+    _sample_extent.resize(_batch_size);
+    // The arrays of a batch are read concurrently on the shared pool when the loader is given more than one CPU thread
+    _read_threads = std::max<size_t>(1, std::min<size_t>(reader_cfg.get_cpu_num_threads(), _batch_size));
     _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth);
     _is_initialized = true;
     LOG("Loader module initialized");
@@ -171,35 +185,62 @@ NumpyLoader::load_routine() {
 
         auto load_status = LoaderModuleStatus::NO_MORE_DATA_TO_READ;
         {
-            unsigned file_counter = 0;
             _file_load_time.start();  // Debug timing
-
-            while ((file_counter != _batch_size) && _reader->count_items() > 0) {
-                auto read_ptr = data + _tensor_size * file_counter;
-                size_t read_size = _reader->open();
-                if (read_size == 0) {
-                    ERR("Opened file " + _reader->id() + " of size 0");
+            // Slots of the batch still to be filled, the ones whose read fails are filled again with the next files
+            std::vector<unsigned> free_slots(_batch_size);
+            std::iota(free_slots.begin(), free_slots.end(), 0);
+            while (!free_slots.empty() && _reader->count_items() > 0) {
+                // The reader hands the files out in order on this thread, only the reads themselves run in parallel
+                std::vector<unsigned> read_slots;
+                while (read_slots.size() != free_slots.size() && _reader->count_items() > 0) {
+                    auto slot = free_slots[read_slots.size()];
+                    size_t read_size = _reader->open();
+                    if (read_size == 0) {
+                        ERR("Opened file " + _reader->id() + " of size 0");
+                        _reader->close();
+                        continue;
+                    }
+                    _sample_path[slot] = _reader->file_path();
+                    _sample_header[slot] = _reader->get_numpy_header_data();
+                    _sample_header[slot].clamp_region(_roi_start, _roi_shape, _sample_start[slot], _sample_extent[slot]);
+                    _decoded_data_info._data_names[slot] = _reader->id();
                     _reader->close();
-                    continue;
+                    read_slots.push_back(slot);
                 }
-                auto fsize = _reader->read_numpy_data(read_ptr, read_size, strides_in_dims);
-                if (fsize == 0) {
-                    ERR("Cannot read numpy data from " + _reader->id());
-                    _reader->close();
-                    continue;
-                }
-                _decoded_data_info._data_names[file_counter] = _reader->id();
-                auto original_roi = _reader->get_numpy_header_data().shape();
-                // The numpy header data contains the full array shape. We require only width and height for ROI updation
-                if (data_layout == RocalTensorlayout::NHWC) {
-                    _tensor_roi[file_counter] = {original_roi[1], original_roi[0]};
-                } else if (data_layout == RocalTensorlayout::NCHW) {
-                    _tensor_roi[file_counter] = {original_roi[2], original_roi[1]};
+                free_slots.erase(free_slots.begin(), free_slots.begin() + read_slots.size());
+
+                std::vector<size_t> read_bytes(read_slots.size());
+                auto read_sample = [&](size_t i) {
+                    auto slot = read_slots[i];
+                    read_bytes[i] = _reader->read_numpy_region(_sample_path[slot], _sample_header[slot], data + _tensor_size * slot,
+                                                               strides_in_dims, _sample_start[slot], _sample_extent[slot]);
+                };
+                if (_read_pool && _read_threads > 1 && read_slots.size() > 1) {
+                    _read_pool->parallel_for(read_slots.size(), [&read_sample](size_t i, size_t) { read_sample(i); }, _read_threads);
                 } else {
-                    _tensor_roi[file_counter] = original_roi;
+                    for (size_t i = 0; i < read_slots.size(); i++)
+                        read_sample(i);
+                }
+
+                for (size_t i = 0; i < read_slots.size(); i++) {
+                    auto slot = read_slots[i];
+                    auto &extent = _sample_extent[slot];
+                    bool empty_region = std::find(extent.begin(), extent.end(), 0) != extent.end();
+                    if (read_bytes[i] == 0 && !empty_region) {
+                        ERR("Cannot read numpy data from " + _decoded_data_info._data_names[slot]);
+                        free_slots.push_back(slot);
+                        continue;
+                    }
+                    // The numpy header data contains the full array shape. We require only width and height for ROI updation
+                    if (data_layout == RocalTensorlayout::NHWC) {
+                        _tensor_roi[slot] = {extent[1], extent[0]};
+                    } else if (data_layout == RocalTensorlayout::NCHW) {
+                        _tensor_roi[slot] = {extent[2], extent[1]};
+                    } else {
+                        _tensor_roi[slot] = extent;
+                    }
                 }
-                _reader->close();
-                file_counter++;
+                std::sort(free_slots.begin(), free_slots.end());
             }
             _file_load_time.end();  // Debug timing
             _circ_buff.set_decoded_data_info(_decoded_data_info);
@@ -222,10 +263,10 @@ NumpyLoader::load_routine() {
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // The loader thread then sleeps since there is no more data to read,
+            // till program ends, reset is called or new data is fed to the loader
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            _circ_buff.wait_for_new_data();
         }
     }
     return LoaderModuleStatus::OK;
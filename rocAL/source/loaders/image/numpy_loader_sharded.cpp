@@ -32,6 +32,10 @@ void NumpyLoaderSharded::set_prefetch_queue_depth(size_t prefetch_queue_depth) {
     _prefetch_queue_depth = prefetch_queue_depth;
 }
 
+void NumpyLoaderSharded::set_decode_pool(std::shared_ptr<ThreadPool> decode_pool) {
+    _decode_pool = std::move(decode_pool);
+}
+
 std::vector<std::string> NumpyLoaderSharded::get_id() {
     if (!_initialized)
         THROW("get_id() should be called after initialize() function");
@@ -77,6 +81,7 @@ void NumpyLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     for (size_t i = 0; i < _shard_count; i++) {
         std::shared_ptr loader = std::make_shared<NumpyLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_decode_pool(_decode_pool);
         _loaders.push_back(loader);
     }
     // Initialize loader modules
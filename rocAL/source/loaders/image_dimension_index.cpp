@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "loaders/image_dimension_index.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#include "pipeline/commons.h"
+
+constexpr char ImageDimensionIndex::INDEX_MAGIC[8];
+
+ImageDimensionIndex::ImageDimensionIndex(const std::string &index_path) : _index_path(index_path) {
+    load();
+}
+
+bool ImageDimensionIndex::stamp(const std::string &file_path, FileStamp &file_stamp) {
+    struct stat file_stat;
+    if (stat(file_path.c_str(), &file_stat) != 0)
+        return false;
+    file_stamp.mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+    file_stamp.size = file_stat.st_size;
+    return true;
+}
+
+bool ImageDimensionIndex::lookup(const std::string &file_path, const FileStamp &file_stamp, unsigned &width, unsigned &height) const {
+    auto it = _entries.find(file_path);
+    if (it == _entries.end() || !(it->second.file_stamp == file_stamp))
+        return false;
+    width = it->second.width;
+    height = it->second.height;
+    return true;
+}
+
+void ImageDimensionIndex::insert(const std::string &file_path, const FileStamp &file_stamp, unsigned width, unsigned height) {
+    auto &entry = _entries[file_path];
+    entry.file_stamp = file_stamp;
+    entry.width = width;
+    entry.height = height;
+    _modified = true;
+}
+
+void ImageDimensionIndex::retain(const std::vector<std::string> &file_paths) {
+    std::unordered_set<std::string> seen(file_paths.begin(), file_paths.end());
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (seen.count(it->first)) {
+            ++it;
+        } else {
+            it = _entries.erase(it);
+            _modified = true;
+        }
+    }
+}
+
+void ImageDimensionIndex::load() {
+    if (_index_path.empty())
+        return;
+    std::ifstream index_file(_index_path, std::ios::binary);
+    if (!index_file)
+        return;
+    char magic[sizeof(INDEX_MAGIC)];
+    uint32_t version = 0;
+    uint64_t entry_count = 0;
+    index_file.read(magic, sizeof(magic));
+    index_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    index_file.read(reinterpret_cast<char *>(&entry_count), sizeof(entry_count));
+    if (!index_file || memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || version != INDEX_VERSION) {
+        WRN("ImageDimensionIndex: Ignoring invalid index file " + _index_path)
+        return;
+    }
+    _entries.reserve(entry_count);
+    std::string file_path;
+    for (uint64_t i = 0; i < entry_count; i++) {
+        uint32_t path_length = 0;
+        Entry entry;
+        index_file.read(reinterpret_cast<char *>(&path_length), sizeof(path_length));
+        file_path.resize(path_length);
+        index_file.read(&file_path[0], path_length);
+        index_file.read(reinterpret_cast<char *>(&entry.file_stamp.mtime_ns), sizeof(entry.file_stamp.mtime_ns));
+        index_file.read(reinterpret_cast<char *>(&entry.file_stamp.size), sizeof(entry.file_stamp.size));
+        index_file.read(reinterpret_cast<char *>(&entry.width), sizeof(entry.width));
+        index_file.read(reinterpret_cast<char *>(&entry.height), sizeof(entry.height));
+        if (!index_file) {
+            WRN("ImageDimensionIndex: Index file " + _index_path + " is truncated, rebuilding it")
+            _entries.clear();
+            return;
+        }
+        _entries.emplace(file_path, entry);
+    }
+}
+
+void ImageDimensionIndex::save() {
+    if (_index_path.empty() || !_modified)
+        return;
+    // Write to a temporary file first so concurrent jobs never read a partially written index
+    std::string tmp_path = _index_path + ".tmp" + TOSTR(getpid());
+    {
+        std::ofstream index_file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!index_file) {
+            WRN("ImageDimensionIndex: Cannot write the index file " + _index_path)
+            return;
+        }
+        uint32_t version = INDEX_VERSION;
+        uint64_t entry_count = _entries.size();
+        index_file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        index_file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        index_file.write(reinterpret_cast<const char *>(&entry_count), sizeof(entry_count));
+        for (auto &it : _entries) {
+            uint32_t path_length = it.first.size();
+            index_file.write(reinterpret_cast<const char *>(&path_length), sizeof(path_length));
+            index_file.write(it.first.data(), path_length);
+            index_file.write(reinterpret_cast<const char *>(&it.second.file_stamp.mtime_ns), sizeof(it.second.file_stamp.mtime_ns));
+            index_file.write(reinterpret_cast<const char *>(&it.second.file_stamp.size), sizeof(it.second.file_stamp.size));
+            index_file.write(reinterpret_cast<const char *>(&it.second.width), sizeof(it.second.width));
+            index_file.write(reinterpret_cast<const char *>(&it.second.height), sizeof(it.second.height));
+        }
+        if (!index_file) {
+            WRN("ImageDimensionIndex: Failed writing the index file " + _index_path)
+            index_file.close();
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), _index_path.c_str()) != 0) {
+        WRN("ImageDimensionIndex: Cannot replace the index file " + _index_path)
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    _modified = false;
+}
@@ -22,8 +22,50 @@ THE SOFTWARE.
 
 #include "loaders/image_source_evaluator.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+
 #include "decoders/image/decoder_factory.h"
+#include "pipeline/filesystem.h"
 #include "readers/image/reader_factory.h"
+
+static const char *IMAGE_DIMENSION_INDEX_FILE = ".rocal_image_dims.idx";
+
+// Reads up to size bytes at offset, returns the number of bytes read
+static size_t read_at(int fd, unsigned char *buf, size_t size, size_t offset) {
+    size_t read_size = 0;
+    while (read_size < size) {
+        ssize_t ret = pread(fd, buf + read_size, size - read_size, offset + read_size);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            break;
+        read_size += ret;
+    }
+    return read_size;
+}
+
+// Decodes the header of the image using only its first header_size bytes, falls back to the whole file if the header is larger
+static bool read_image_dims(const std::string &file_path, size_t file_size, size_t header_size, std::shared_ptr<Decoder> &decoder,
+                            std::vector<unsigned char> &buff, int &width, int &height) {
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    size_t read_size = read_at(fd, buff.data(), std::min(header_size, file_size), 0);
+    int color_comps;
+    bool decoded = read_size && decoder->decode_info(buff.data(), read_size, &width, &height, &color_comps) == Decoder::Status::OK;
+    if (!decoded && read_size == header_size && file_size > header_size) {
+        buff.resize(file_size);
+        read_size += read_at(fd, buff.data() + read_size, file_size - read_size, read_size);
+        decoded = decoder->decode_info(buff.data(), read_size, &width, &height, &color_comps) == Decoder::Status::OK;
+        buff.resize(header_size);
+    }
+    close(fd);
+    return decoded;
+}
+
 void ImageSourceEvaluator::set_size_evaluation_policy(MaxSizeEvaluationPolicy arg) {
     _width_max.set_policy(arg);
     _height_max.set_policy(arg);
@@ -44,6 +86,9 @@ ImageSourceEvaluator::create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg)
     // Can initialize it to any decoder types if needed
 
     // _header_buff.resize(COMPRESSED_SIZE);
+    _decoder_cfg = decoder_cfg;
+    if (!reader_cfg.path().empty() && filesys::is_directory(filesys::path(reader_cfg.path())))
+        _index_path = (filesys::path(reader_cfg.path()) / IMAGE_DIMENSION_INDEX_FILE).string();
     _decoder = create_decoder(std::move(decoder_cfg));
     _reader = create_reader(std::move(reader_cfg));
     find_max_dimension();
@@ -51,6 +96,10 @@ ImageSourceEvaluator::create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg)
 }
 
 void ImageSourceEvaluator::find_max_dimension() {
+    if (_reader->supports_path_read()) {
+        find_max_dimension_from_headers();
+        return;
+    }
     _reader->reset();
 
     while (_reader->count_items()) {
@@ -77,6 +126,69 @@ void ImageSourceEvaluator::find_max_dimension() {
     _reader->reset();
 }
 
+void ImageSourceEvaluator::find_max_dimension_from_headers() {
+    _reader->reset();
+    std::vector<std::string> file_paths;
+    while (_reader->count_items())
+        file_paths.emplace_back(_reader->next_file_path());
+    // return the reader read pointer to the begining of the resource
+    _reader->reset();
+
+    ImageDimensionIndex index(_index_path);
+    const size_t file_count = file_paths.size();
+    std::vector<ImageDimensionIndex::FileStamp> file_stamps(file_count);
+    std::vector<unsigned> widths(file_count, 0), heights(file_count, 0);
+    std::vector<char> is_indexed(file_count, 0), is_new(file_count, 0);
+
+    // The headers are read on the CPU workers of the pipeline, so the scan stays within the core budget and affinity of its CPU set
+    const size_t slot_count = _scan_pool ? _scan_pool->max_slots() : 1;
+    std::vector<std::shared_ptr<Decoder>> decoders(slot_count);
+    std::vector<std::vector<unsigned char>> header_buffs(slot_count, std::vector<unsigned char>(HEADER_READ_SIZE));
+    for (auto &decoder : decoders)
+        decoder = create_decoder(_decoder_cfg);
+    auto scan_file = [&](size_t i, size_t slot) {
+        if (!ImageDimensionIndex::stamp(file_paths[i], file_stamps[i]) || file_stamps[i].size == 0)
+            return;
+        if (index.lookup(file_paths[i], file_stamps[i], widths[i], heights[i])) {
+            is_indexed[i] = 1;
+            return;
+        }
+        int width = 0, height = 0;
+        if (read_image_dims(file_paths[i], file_stamps[i].size, HEADER_READ_SIZE, decoders[slot], header_buffs[slot], width, height) && width > 0 && height > 0) {
+            widths[i] = width;
+            heights[i] = height;
+        }
+        is_new[i] = 1;
+    };
+    if (_scan_pool) {
+        _scan_pool->parallel_for(file_count, scan_file);
+    } else {
+        for (size_t i = 0; i < file_count; i++)
+            scan_file(i, 0);
+    }
+
+    size_t rescanned_count = 0;
+    for (size_t i = 0; i < file_count; i++) {
+        if (is_new[i]) {
+            // Files which failed decoding are indexed as well with zero dimensions, so they are not rescanned on later runs
+            index.insert(file_paths[i], file_stamps[i], widths[i], heights[i]);
+            rescanned_count++;
+            if (widths[i] == 0 || heights[i] == 0)
+                WRN("Could not decode the header of the: " + file_paths[i])
+        }
+        if (!is_new[i] && !is_indexed[i])
+            continue;
+        if (widths[i] == 0 || heights[i] == 0)
+            continue;
+        _width_max.process_sample(widths[i]);
+        _height_max.process_sample(heights[i]);
+    }
+    LOG("ImageSourceEvaluator: Scanned headers of " + TOSTR(rescanned_count) + " out of " + TOSTR(file_count) + " images")
+    // Entries of the files deleted or renamed since the last scan are dropped, so the index does not grow with every change of the dataset
+    index.retain(file_paths);
+    index.save();
+}
+
 void ImageSourceEvaluator::FindMaxSize::process_sample(unsigned val) {
     if (_policy == MaxSizeEvaluationPolicy::MAXIMUM_FOUND_SIZE) {
         _max = (val > _max) ? val : _max;
@@ -85,8 +197,7 @@ void ImageSourceEvaluator::FindMaxSize::process_sample(unsigned val) {
         auto it = _hist.find(val);
         size_t count = 1;
         if (it != _hist.end()) {
-            it->second = +1;
-            count = it->second;
+            count = ++it->second;
         } else {
             _hist.insert(std::make_pair(val, 1));
         }
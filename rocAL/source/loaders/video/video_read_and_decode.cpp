@@ -23,6 +23,9 @@ THE SOFTWARE.
 #include "loaders/video/video_read_and_decode.h"
 #include "decoders/video/video_decoder_factory.h"
 
+#include <algorithm>
+#include <exception>
+
 #ifdef ROCAL_VIDEO
 std::tuple<VideoDecoder::ColorFormat, unsigned, AVPixelFormat>
 video_interpret_color_format(RocalColorFormat color_format) {
@@ -54,6 +57,7 @@ VideoReadAndDecode::VideoReadAndDecode() : _file_load_time("FileLoadTime", DBG_T
 }
 
 VideoReadAndDecode::~VideoReadAndDecode() {
+    _decode_pool.reset();
     _video_reader = nullptr;
     _video_decoder.clear();
 }
@@ -74,32 +78,23 @@ void VideoReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decode
     _video_decoder_config = decoder_config;
     _device_id = device_id;
 
-    // Initialize the ffmpeg context once for the video files.
-    size_t i = 0;
-    for (; i < _video_process_count; i++) {
+    // Open the first videos on the decoder slots, the other videos are opened on the least recently used slot when they are needed
+    _slot_video_name.assign(_video_process_count, std::string());
+    _slot_pinned.assign(_video_process_count, 0);
+    _lru_slots.clear();
+    _lru_position.resize(_video_process_count);
+    for (size_t i = 0; i < _video_process_count; i++) {
         _video_decoder[i] = create_video_decoder(decoder_config);
+        _lru_position[i] = _lru_slots.insert(_lru_slots.end(), i);
         std::vector<std::string> substrings;
         char delim = '#';
         substring_extraction(_video_names[i], delim, substrings);
-        video_map video_instance;
-        video_instance._video_map_idx = atoi(substrings[0].c_str());
-        video_instance._is_decoder_instance = true;
-        if (_video_decoder[i]->Initialize(substrings[1].c_str(), _device_id) != VideoDecoder::Status::OK)
-            video_instance._is_decoder_instance = false;
-        _video_file_name_map.insert(std::pair<std::string, video_map>(_video_names[i], video_instance));
-    }
-    if (_video_process_count != _video_count) {
-        while (i < _video_count) {
-            std::vector<std::string> substrings;
-            char delim = '#';
-            substring_extraction(_video_names[i], delim, substrings);
-            video_map video_instance;
-            video_instance._video_map_idx = atoi(substrings[0].c_str());
-            video_instance._is_decoder_instance = false;
-            _video_file_name_map.insert(std::pair<std::string, video_map>(_video_names[i], video_instance));
-            i++;
+        if (_video_decoder[i]->Initialize(substrings[1].c_str(), _device_id) == VideoDecoder::Status::OK) {
+            _slot_video_name[i] = _video_names[i];
+            _video_decoder_slot.emplace(_video_names[i], i);
         }
     }
+    _decode_pool = std::make_unique<ThreadPool>(_video_process_count);
     _video_reader = create_video_reader(reader_config);
 }
 
@@ -118,11 +113,45 @@ float VideoReadAndDecode::convert_framenum_to_timestamp(size_t frame_number) {
     return timestamp;
 }
 
-void VideoReadAndDecode::decode_sequence(size_t sequence_index) {
-    if (_video_decoder[_sequence_video_idx[sequence_index]]->Decode(_decompressed_buff_ptrs[sequence_index], _sequence_start_frame_num[sequence_index], _sequence_length, _stride,
-                                                                    _max_decoded_width, _max_decoded_height, _max_decoded_stride, _out_pix_fmt) == VideoDecoder::Status::OK) {
-        _actual_decoded_width[sequence_index] = _max_decoded_width;
-        _actual_decoded_height[sequence_index] = _max_decoded_height;
+void VideoReadAndDecode::touch_decoder(size_t slot) {
+    _lru_slots.splice(_lru_slots.begin(), _lru_slots, _lru_position[slot]);
+}
+
+int VideoReadAndDecode::acquire_decoder(const std::string &video_name) {
+    auto it = _video_decoder_slot.find(video_name);
+    if (it != _video_decoder_slot.end()) {
+        touch_decoder(it->second);
+        return it->second;
+    }
+    for (auto slot_itr = _lru_slots.rbegin(); slot_itr != _lru_slots.rend(); ++slot_itr) {
+        size_t slot = *slot_itr;
+        if (_slot_pinned[slot])
+            continue;
+        if (!_slot_video_name[slot].empty())
+            _video_decoder_slot.erase(_slot_video_name[slot]);
+        _slot_video_name[slot].clear();
+        touch_decoder(slot);
+        std::vector<std::string> substrings;
+        char delim = '#';
+        substring_extraction(video_name, delim, substrings);
+        if (_video_decoder[slot]->Initialize(substrings[1].c_str(), _device_id) != VideoDecoder::Status::OK) {
+            WRN("VideoReadAndDecode: Cannot open the video " + substrings[1])
+            return DECODER_OPEN_FAILED;
+        }
+        _slot_video_name[slot] = video_name;
+        _video_decoder_slot.emplace(video_name, slot);
+        return slot;
+    }
+    return NO_FREE_DECODER;
+}
+
+void VideoReadAndDecode::decode_sequences(size_t slot, const std::vector<size_t> &sequence_indices) {
+    for (auto sequence_index : sequence_indices) {
+        if (_video_decoder[slot]->Decode(_decompressed_buff_ptrs[sequence_index], _sequence_start_frame_num[sequence_index], _sequence_length, _stride,
+                                         _max_decoded_width, _max_decoded_height, _max_decoded_stride, _out_pix_fmt) == VideoDecoder::Status::OK) {
+            _actual_decoded_width[sequence_index] = _max_decoded_width;
+            _actual_decoded_height[sequence_index] = _max_decoded_height;
+        }
     }
 }
 
@@ -160,72 +189,72 @@ VideoReadAndDecode::load(unsigned char *buff,
 
     _file_load_time.start();  // Debug timing
 
-    std::vector<size_t> sequential_decode_sequences;
-    std::vector<size_t> parallel_decode_sequences;
-    std::vector<int> video_index;
-    size_t parallel_sequence_count = 0;
     _sequence_start_frame_num.resize(_batch_size);
     _sequence_video_path.resize(_batch_size);
+    std::vector<size_t> pending_sequences;
     for (size_t i = 0; i < _batch_size; i++) {
         auto sequence_info = _video_reader->get_sequence_info();
         _sequence_start_frame_num[i] = sequence_info.start_frame_number;
         _sequence_video_path[i] = sequence_info.video_file_name;
         _decompressed_buff_ptrs[i] = buff + (i * image_size * _sequence_length);
-
-        // Check if the video file is already initialized otherwise use an existing decoder instance to initialize the video
-        // std::cerr << "\nThe source video is " << _sequence_video_path[i] << " MAP : "<<_video_file_name_map.find(_sequence_video_path[i])->second._video_map_idx << "\tThe start index is : " << _sequence_start_frame_num[i] << "\n";
-        std::map<std::string, video_map>::iterator itr = _video_file_name_map.find(_sequence_video_path[i]);
-        if (itr->second._is_decoder_instance == false) {
-            std::map<std::string, video_map>::iterator temp_itr;
-            for (temp_itr = _video_file_name_map.begin(); temp_itr != _video_file_name_map.end(); ++temp_itr) {
-                if (temp_itr->second._is_decoder_instance == true) {
-                    int video_idx = temp_itr->second._video_map_idx;
-                    if ((std::count(_sequence_video_idx.begin(), _sequence_video_idx.end(), video_idx) >= 1) && (_sequence_video_idx.size() != 0))
-                        continue;
-                    std::vector<std::string> substrings;
-                    char delim = '#';
-                    substring_extraction(itr->first, delim, substrings);
-                    if (_video_decoder[video_idx]->Initialize(substrings[1].c_str(), _device_id) == VideoDecoder::Status::OK) {
-                        itr->second._video_map_idx = video_idx;
-                        itr->second._is_decoder_instance = true;
-                    }
-                    temp_itr->second._is_decoder_instance = false;
-                    break;
-                }
-            }
-        }
-        if (itr->second._is_decoder_instance == false)
-            continue;
-        _sequence_video_idx.push_back(itr->second._video_map_idx);
-
-        // Check if the sequences are from same or different video file
-        video_index.push_back(_video_file_name_map[_sequence_video_path[i]]._video_map_idx);
-        if (std::count(video_index.begin(), video_index.end(), video_index[i]) > 1) {
-            sequential_decode_sequences.push_back(i);
-        } else {
-            parallel_decode_sequences.push_back(i);
-            parallel_sequence_count++;
-        }
-    }
-    if (parallel_sequence_count == 1) {
-        sequential_decode_sequences.push_back(parallel_decode_sequences.back());
-        parallel_decode_sequences.clear();
+        pending_sequences.push_back(i);
     }
 
     _file_load_time.end();  // Debug timing
 
     _decode_time.start();  // Debug timing
 
-    for (size_t i = 0; i < sequential_decode_sequences.size(); i++)
-        decode_sequence(sequential_decode_sequences[i]);
-
-    // Initialize threads to decode
-    std::vector<std::thread> decode_threads;
-    for (size_t i = 0; i < parallel_decode_sequences.size(); i++)
-        decode_threads.push_back(std::thread(&VideoReadAndDecode::decode_sequence, this, parallel_decode_sequences[i]));
-
-    for (auto &th : decode_threads)
-        th.join();
+    // The sequences of a video are decoded in order on the slot which has it open, the slots are decoded concurrently.
+    // When the batch holds more videos than there are slots, the remaining ones are decoded in further rounds.
+    std::vector<std::vector<size_t>> slot_sequences(_video_process_count);
+    std::vector<size_t> deferred_sequences;
+    while (!pending_sequences.empty()) {
+        std::fill(_slot_pinned.begin(), _slot_pinned.end(), 0);
+        for (auto &sequences : slot_sequences)
+            sequences.clear();
+        deferred_sequences.clear();
+        for (auto i : pending_sequences) {
+            int slot = acquire_decoder(_sequence_video_path[i]);
+            if (slot == NO_FREE_DECODER) {
+                deferred_sequences.push_back(i);
+                continue;
+            }
+            if (slot == DECODER_OPEN_FAILED)
+                continue;
+            _slot_pinned[slot] = 1;
+            slot_sequences[slot].push_back(i);
+        }
+        std::vector<size_t> active_slots;
+        for (size_t slot = 0; slot < _video_process_count; slot++) {
+            if (slot_sequences[slot].empty())
+                continue;
+            // Increasing start frames let the decoder continue from one sequence to the next without seeking back
+            std::sort(slot_sequences[slot].begin(), slot_sequences[slot].end(),
+                      [this](size_t a, size_t b) { return _sequence_start_frame_num[a] < _sequence_start_frame_num[b]; });
+            active_slots.push_back(slot);
+        }
+        if (active_slots.size() == 1) {
+            // A single video does not need the workers, avoid the hand-off
+            decode_sequences(active_slots[0], slot_sequences[active_slots[0]]);
+        } else {
+            std::vector<std::shared_future<void>> decode_jobs;
+            for (auto slot : active_slots)
+                decode_jobs.push_back(_decode_pool->submit([this, slot, &slot_sequences]() { decode_sequences(slot, slot_sequences[slot]); }));
+            // The jobs reference slot_sequences, so every job has to complete before a failure is propagated
+            std::exception_ptr error;
+            for (auto &job : decode_jobs) {
+                try {
+                    job.get();
+                } catch (...) {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+        pending_sequences.swap(deferred_sequences);
+    }
 
     _decode_time.end();  // Debug timing
 
@@ -249,7 +278,6 @@ VideoReadAndDecode::load(unsigned char *buff,
     sequence_frame_timestamps_vec.insert(sequence_frame_timestamps_vec.begin(), sequence_frame_timestamps);
     _sequence_start_frame_num.clear();
     _sequence_video_path.clear();
-    _sequence_video_idx.clear();
     return LoaderModuleStatus::OK;
 }
 #endif
@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "meta_data/anchor_box_store.h"
+#include "pipeline/commons.h"
+#include "pipeline/cpu_features.h"
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+AnchorBoxStore::AnchorBoxStore(const std::vector<float> &anchors) {
+    init(anchors);
+}
+
+void AnchorBoxStore::init(const std::vector<float> &anchors) {
+    if (anchors.size() % 4 != 0)
+        THROW("Anchors size should be a multiple of 4, given " + TOSTR(anchors.size()))
+    _count = anchors.size() / 4;
+    _padded_count = ((_count + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE;
+    _ltrb.resize(_count);
+    _l.resize(_padded_count);
+    _t.resize(_padded_count);
+    _r.resize(_padded_count);
+    _b.resize(_padded_count);
+    _area.resize(_padded_count);
+    for (unsigned i = 0; i < _padded_count; i++) {
+        unsigned src = std::min(i, _count - 1);
+        _l[i] = anchors[src * 4];
+        _t[i] = anchors[src * 4 + 1];
+        _r[i] = anchors[src * 4 + 2];
+        _b[i] = anchors[src * 4 + 3];
+        _area[i] = (_b[i] - _t[i]) * (_r[i] - _l[i]);
+        if (i < _count)
+            _ltrb[i] = BoundingBoxCord(_l[i], _t[i], _r[i], _b[i]);
+    }
+    _block_extent.resize(_padded_count / BLOCK_SIZE);
+    for (unsigned block = 0; block < _block_extent.size(); block++) {
+        unsigned start = block * BLOCK_SIZE;
+        BoundingBoxCord extent(_l[start], _t[start], _r[start], _b[start]);
+        for (unsigned i = start + 1; i < start + BLOCK_SIZE; i++) {
+            extent.l = std::min(extent.l, _l[i]);
+            extent.t = std::min(extent.t, _t[i]);
+            extent.r = std::max(extent.r, _r[i]);
+            extent.b = std::max(extent.b, _b[i]);
+        }
+        _block_extent[block] = extent;
+    }
+}
+
+#if SIMD_X86
+namespace {
+// Same arithmetic as the scalar IoU: intersection / (box_area + anchor_area - intersection)
+SIMD_TARGET_AVX512 void block_ious_avx512(const BoundingBoxCord &box, float box_area, const float *l, const float *t, const float *r, const float *b,
+                                          const float *area, unsigned count, float *ious) {
+    const __m512 pbox_l = _mm512_set1_ps(box.l), pbox_t = _mm512_set1_ps(box.t), pbox_r = _mm512_set1_ps(box.r), pbox_b = _mm512_set1_ps(box.b);
+    const __m512 pbox_area = _mm512_set1_ps(box_area), pzero = _mm512_setzero_ps();
+    for (unsigned i = 0; i < count; i += 16) {
+        __m512 pw = _mm512_max_ps(pzero, _mm512_sub_ps(_mm512_min_ps(pbox_r, _mm512_loadu_ps(r + i)), _mm512_max_ps(pbox_l, _mm512_loadu_ps(l + i))));
+        __m512 ph = _mm512_max_ps(pzero, _mm512_sub_ps(_mm512_min_ps(pbox_b, _mm512_loadu_ps(b + i)), _mm512_max_ps(pbox_t, _mm512_loadu_ps(t + i))));
+        __m512 pintersection = _mm512_mul_ps(pw, ph);
+        __m512 punion = _mm512_sub_ps(_mm512_add_ps(pbox_area, _mm512_loadu_ps(area + i)), pintersection);
+        _mm512_storeu_ps(ious + i, _mm512_div_ps(pintersection, punion));
+    }
+}
+
+SIMD_TARGET_AVX2 void block_ious_avx2(const BoundingBoxCord &box, float box_area, const float *l, const float *t, const float *r, const float *b,
+                                      const float *area, unsigned count, float *ious) {
+    const __m256 pbox_l = _mm256_set1_ps(box.l), pbox_t = _mm256_set1_ps(box.t), pbox_r = _mm256_set1_ps(box.r), pbox_b = _mm256_set1_ps(box.b);
+    const __m256 pbox_area = _mm256_set1_ps(box_area), pzero = _mm256_setzero_ps();
+    for (unsigned i = 0; i < count; i += 8) {
+        __m256 pw = _mm256_max_ps(pzero, _mm256_sub_ps(_mm256_min_ps(pbox_r, _mm256_loadu_ps(r + i)), _mm256_max_ps(pbox_l, _mm256_loadu_ps(l + i))));
+        __m256 ph = _mm256_max_ps(pzero, _mm256_sub_ps(_mm256_min_ps(pbox_b, _mm256_loadu_ps(b + i)), _mm256_max_ps(pbox_t, _mm256_loadu_ps(t + i))));
+        __m256 pintersection = _mm256_mul_ps(pw, ph);
+        __m256 punion = _mm256_sub_ps(_mm256_add_ps(pbox_area, _mm256_loadu_ps(area + i)), pintersection);
+        _mm256_storeu_ps(ious + i, _mm256_div_ps(pintersection, punion));
+    }
+}
+
+SIMD_TARGET_SSE42 void block_ious_sse42(const BoundingBoxCord &box, float box_area, const float *l, const float *t, const float *r, const float *b,
+                                        const float *area, unsigned count, float *ious) {
+    const __m128 pbox_l = _mm_set1_ps(box.l), pbox_t = _mm_set1_ps(box.t), pbox_r = _mm_set1_ps(box.r), pbox_b = _mm_set1_ps(box.b);
+    const __m128 pbox_area = _mm_set1_ps(box_area), pzero = _mm_setzero_ps();
+    for (unsigned i = 0; i < count; i += 4) {
+        __m128 pw = _mm_max_ps(pzero, _mm_sub_ps(_mm_min_ps(pbox_r, _mm_loadu_ps(r + i)), _mm_max_ps(pbox_l, _mm_loadu_ps(l + i))));
+        __m128 ph = _mm_max_ps(pzero, _mm_sub_ps(_mm_min_ps(pbox_b, _mm_loadu_ps(b + i)), _mm_max_ps(pbox_t, _mm_loadu_ps(t + i))));
+        __m128 pintersection = _mm_mul_ps(pw, ph);
+        __m128 punion = _mm_sub_ps(_mm_add_ps(pbox_area, _mm_loadu_ps(area + i)), pintersection);
+        _mm_storeu_ps(ious + i, _mm_div_ps(pintersection, punion));
+    }
+}
+}  // namespace
+#endif
+
+void AnchorBoxStore::compute_block_ious(const BoundingBoxCord &box, float box_area, unsigned start, float *ious) const {
+    const float *l = _l.data() + start, *t = _t.data() + start, *r = _r.data() + start, *b = _b.data() + start, *area = _area.data() + start;
+#if SIMD_X86
+    switch (cpu_isa_level()) {
+        case CpuIsaLevel::AVX512:
+            return block_ious_avx512(box, box_area, l, t, r, b, area, BLOCK_SIZE, ious);
+        case CpuIsaLevel::AVX2:
+            return block_ious_avx2(box, box_area, l, t, r, b, area, BLOCK_SIZE, ious);
+        case CpuIsaLevel::SSE42:
+            return block_ious_sse42(box, box_area, l, t, r, b, area, BLOCK_SIZE, ious);
+        default:
+            break;
+    }
+#endif
+    for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+        float w = std::max(0.0f, std::min(box.r, r[i]) - std::max(box.l, l[i]));
+        float h = std::max(0.0f, std::min(box.b, b[i]) - std::max(box.t, t[i]));
+        float intersection = w * h;
+        ious[i] = intersection / (box_area + area[i] - intersection);
+    }
+}
+
+unsigned AnchorBoxStore::compute_ious(const BoundingBoxCord &box, float *ious) const {
+    float box_area = (box.b - box.t) * (box.r - box.l);
+    unsigned best_idx = 0;
+    float best_iou = 0.0f;  // The IoU of the skipped anchors, compared with > so the first anchor wins on ties
+    for (unsigned block = 0; block < _block_extent.size(); block++) {
+        unsigned start = block * BLOCK_SIZE;
+        const auto &extent = _block_extent[block];
+        if (box.l >= extent.r || box.r <= extent.l || box.t >= extent.b || box.b <= extent.t) {
+            // No anchor of the block shares any area with the box
+            memset(ious + start, 0, BLOCK_SIZE * sizeof(float));
+            continue;
+        }
+        compute_block_ious(box, box_area, start, ious + start);
+        unsigned end = std::min(start + BLOCK_SIZE, _count);
+        if (start == 0)
+            best_iou = ious[0];
+        for (unsigned i = start; i < end; i++) {
+            if (ious[i] > best_iou) {
+                best_iou = ious[i];
+                best_idx = i;
+            }
+        }
+    }
+    return best_idx;
+}
@@ -60,16 +60,6 @@ void BoundingBoxGraph::update_meta_data(pMetaDataBatch input_meta_data, DecodedD
     }
 }
 
-inline float ssd_BBoxIntersectionOverUnion(const BoundingBoxCord &box1, const float &box1_area, const BoundingBoxCord &box2) {
-    float xA = std::max(static_cast<float>(box1.l), box2.l);
-    float yA = std::max(static_cast<float>(box1.t), box2.t);
-    float xB = std::min(static_cast<float>(box1.r), box2.r);
-    float yB = std::min(static_cast<float>(box1.b), box2.b);
-    float intersection_area = std::max((float)0.0, xB - xA) * std::max((float)0.0, yB - yA);
-    float box2_area = (box2.b - box2.t) * (box2.r - box2.l);
-    return (float)(intersection_area / (box1_area + box2_area - intersection_area));
-}
-
 void BoundingBoxGraph::update_random_bbox_meta_data(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data, DecodedDataInfo decode_image_info, CropImageInfo crop_image_info) {
     std::vector<uint32_t> original_height = decode_image_info._original_height;
     std::vector<uint32_t> original_width = decode_image_info._original_width;
@@ -119,62 +109,70 @@ void BoundingBoxGraph::update_random_bbox_meta_data(pMetaDataBatch input_meta_da
     }
 }
 
-inline void calculate_ious_for_box(float *ious, BoundingBoxCord &box, BoundingBoxCord *anchors, unsigned int num_anchors) {
-    float box_area = (box.b - box.t) * (box.r - box.l);
-    ious[0] = ssd_BBoxIntersectionOverUnion(box, box_area, anchors[0]);
-
-    int best_idx = 0;
-    float best_iou = ious[0];
-    for (unsigned int anchor_idx = 1; anchor_idx < num_anchors; anchor_idx++) {
-        ious[anchor_idx] = ssd_BBoxIntersectionOverUnion(box, box_area, anchors[anchor_idx]);
-        if (ious[anchor_idx] > best_iou) {
-            best_iou = ious[anchor_idx];
-            best_idx = anchor_idx;
-        }
-    }
-    // For best default box matched with current object let iou = 2, to make sure there is a match,
-    // as this object will be the best (highest IoU), for this default box
-    ious[best_idx] = 2.;
-}
-
-inline int find_best_box_for_anchor(unsigned anchor_idx, const std::vector<float> &ious, unsigned num_boxes, unsigned anchors_size) {
+inline int find_best_box_for_anchor(unsigned anchor_idx, const float *ious, unsigned num_boxes, unsigned ious_stride) {
     unsigned best_idx = 0;
     float best_iou = ious[anchor_idx];
     for (unsigned bbox_idx = 1; bbox_idx < num_boxes; ++bbox_idx) {
-        if (ious[bbox_idx * anchors_size + anchor_idx] >= best_iou) {
-            best_iou = ious[bbox_idx * anchors_size + anchor_idx];
+        if (ious[bbox_idx * ious_stride + anchor_idx] >= best_iou) {
+            best_iou = ious[bbox_idx * ious_stride + anchor_idx];
             best_idx = bbox_idx;
         }
     }
     return best_idx;
 }
 
-void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) {
+void BoundingBoxGraph::reserve_scratch(size_t slot_count) {
+    // One scratch per thread, kept across batches so the IoU buffers are only allocated once
+    if (_scratch.size() < slot_count)
+        _scratch.resize(slot_count);
+}
+
+void BoundingBoxGraph::parallel_for(size_t count, const std::function<void(size_t, size_t)> &body) {
+    if (_cpu_pool) {
+        reserve_scratch(_cpu_pool->max_slots());
+        _cpu_pool->parallel_for(count, body);
+        return;
+    }
+    reserve_scratch(omp_get_max_threads());
 #pragma omp parallel for
-    for (int i = 0; i < full_batch_meta_data->size(); i++) {
-        BoundingBoxCord *bbox_anchors = reinterpret_cast<BoundingBoxCord *>(anchors->data());
-        auto bb_count = full_batch_meta_data->get_labels_batch()[i].size();
-        int *bb_labels = full_batch_meta_data->get_labels_batch()[i].data();
-        BoundingBoxCord *bb_coords = reinterpret_cast<BoundingBoxCord *>(full_batch_meta_data->get_bb_cords_batch()[i].data());
-        unsigned anchors_size = anchors->size() / 4;  // divide the anchors_size by 4 to get the total number of anchors
+    for (size_t i = 0; i < count; i++)
+        body(i, omp_get_thread_num());
+}
+
+void BoundingBoxGraph::update_box_encoder_meta_data(const AnchorBoxStore &anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) {
+    const BoundingBoxCord *bbox_anchors = anchors.ltrb();
+    unsigned anchors_size = anchors.size();
+    unsigned ious_stride = anchors.stride();
+    // Read only accessors, a write accessor called from the workers would race on the copy of the values shared with a clone
+    const auto &labels_batch = full_batch_meta_data->read_labels_batch();
+    const auto &bb_cords_batch = full_batch_meta_data->read_bb_cords_batch();
+    parallel_for(full_batch_meta_data->size(), [&](size_t i, size_t slot) {
+        auto bb_count = labels_batch[i].size();
+        const int *bb_labels = labels_batch[i].data();
+        const BoundingBoxCord *bb_coords = bb_cords_batch[i].data();
         int *encoded_labels = encoded_labels_data + (i * anchors_size);
         BoundingBoxCord_xcycwh *encoded_bb = reinterpret_cast<BoundingBoxCord_xcycwh *>(encoded_boxes_data + (i * anchors_size * 4));
         // Calculate Ious
-        // ious size - bboxes count x anchors count
-        std::vector<float> ious(bb_count * anchors_size);
+        // ious size - bboxes count x anchors stride
+        auto &ious = _scratch[slot].ious;
+        if (ious.size() < bb_count * ious_stride)
+            ious.resize(bb_count * ious_stride);
         for (uint bb_idx = 0; bb_idx < bb_count; bb_idx++) {
-            auto iou_rows = ious.data() + (bb_idx * (anchors_size));
-            calculate_ious_for_box(iou_rows, bb_coords[bb_idx], bbox_anchors, anchors_size);
+            auto iou_rows = ious.data() + (bb_idx * ious_stride);
+            auto best_idx = anchors.compute_ious(bb_coords[bb_idx], iou_rows);
+            // For best default box matched with current object let iou = 2, to make sure there is a match,
+            // as this object will be the best (highest IoU), for this default box
+            iou_rows[best_idx] = 2.;
         }
         float inv_stds[4] = {(float)(1. / stds[0]), (float)(1. / stds[1]), (float)(1. / stds[2]), (float)(1. / stds[3])};
         float half_scale = 0.5 * scale;
         // Depending on the matches ->place the best bbox instead of the corresponding anchor_idx in anchor
         for (unsigned anchor_idx = 0; anchor_idx < anchors_size; anchor_idx++) {
             BoundingBoxCord_xcycwh box_bestidx, anchor_xcyxwh;
-            BoundingBoxCord *p_anchor = &bbox_anchors[anchor_idx];
-            const auto best_idx = find_best_box_for_anchor(anchor_idx, ious, bb_count, anchors_size);
+            const BoundingBoxCord *p_anchor = &bbox_anchors[anchor_idx];
+            const auto best_idx = find_best_box_for_anchor(anchor_idx, ious.data(), bb_count, ious_stride);
             // Filter matches by criteria
-            if (ious[(best_idx * anchors_size) + anchor_idx] > criteria)  // Its a match
+            if (ious[(best_idx * ious_stride) + anchor_idx] > criteria)  // Its a match
             {
                 // Convert the "ltrb" format to "xcycwh"
                 if (offset) {
@@ -218,36 +216,38 @@ void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors,
                 }
             }
         }
-    }
+    });
 }
 
 void BoundingBoxGraph::update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) {
-    auto bb_coords_batch = full_batch_meta_data->get_bb_cords_batch();
-    unsigned anchors_size = iou_matcher_info.anchors->size() / 4;  // divide the anchors_size by 4 to get the total number of anchors
-    BoundingBoxCord *bbox_anchors = reinterpret_cast<BoundingBoxCord *>(iou_matcher_info.anchors->data());
+    const auto &bb_coords_batch = full_batch_meta_data->read_bb_cords_batch();
+    const AnchorBoxStore &anchors = *iou_matcher_info.anchors;
+    unsigned anchors_size = anchors.size();
 
     std::vector<int *> matches(full_batch_meta_data->size());
     for (int i = 0; i < full_batch_meta_data->size(); i++) {
         matches[i] = reinterpret_cast<int *>(matches_idx_buffer + i * anchors_size);
     }
 
-#pragma omp parallel for
-    for (int i = 0; i < full_batch_meta_data->size(); i++) {
-        auto bb_coords = bb_coords_batch[i];
+    parallel_for(full_batch_meta_data->size(), [&](size_t i, size_t slot) {
+        auto &bb_coords = bb_coords_batch[i];
         auto bb_count = bb_coords.size();
 
-        std::vector<float> matched_vals(anchors_size, -1.0);
-        std::vector<int> low_quality_preds(anchors_size, -1);
+        auto &scratch = _scratch[slot];
+        auto &matched_vals = scratch.matched_vals;
+        auto &low_quality_preds = scratch.low_quality_preds;
+        auto &bbox_iou = scratch.ious;  // IoU value for bbox mapped with each anchor
+        matched_vals.assign(anchors_size, -1.0);
+        low_quality_preds.assign(anchors_size, -1);
+        if (bbox_iou.size() < anchors.stride())
+            bbox_iou.resize(anchors.stride());
 
         // Calculate IoU's, The number of IoU Values calculated will be (bb_count x anchors_size)
         for (unsigned bb_idx = 0; bb_idx < bb_count; bb_idx++) {
-            BoundingBoxCord box = bb_coords[bb_idx];
-            float box_area = (box.b - box.t) * (box.r - box.l);
             float best_bbox_iou = -1.0f;
-            std::vector<float> bbox_iou(anchors_size);  // IoU value for bbox mapped with each anchor
+            anchors.compute_ious(bb_coords[bb_idx], bbox_iou.data());
             for (unsigned int anchor_idx = 0; anchor_idx < anchors_size; anchor_idx++) {
-                float iou_val = ssd_BBoxIntersectionOverUnion(box, box_area, bbox_anchors[anchor_idx]);
-                bbox_iou[anchor_idx] = iou_val;
+                float iou_val = bbox_iou[anchor_idx];
 
                 // Find col maximum in (bb_count x anchors_size) IoU values calculated
                 if (iou_val > matched_vals[anchor_idx]) {
@@ -279,8 +279,5 @@ void BoundingBoxGraph::update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_inf
                 }
             }
         }
-
-        matched_vals.clear();
-        low_quality_preds.clear();
-    }
+    });
 }
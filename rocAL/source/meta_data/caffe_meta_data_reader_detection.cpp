@@ -40,18 +40,7 @@ void CaffeMetaDataReaderDetection::init(const MetaDataConfig &cfg, pMetaDataBatc
 }
 
 bool CaffeMetaDataReaderDetection::exists(const std::string &_image_name) {
-    return _map_content.find(_image_name) != _map_content.end();
-}
-
-void CaffeMetaDataReaderDetection::add(std::string image_name, BoundingBoxCords bb_coords, Labels bb_labels, ImgSize image_size) {
-    if (exists(image_name)) {
-        auto it = _map_content.find(image_name);
-        it->second->get_bb_cords().push_back(bb_coords[0]);
-        it->second->get_labels().push_back(bb_labels[0]);
-        return;
-    }
-    pMetaDataBox info = std::make_shared<BoundingBox>(bb_coords, bb_labels, image_size);
-    _map_content.insert(pair<std::string, std::shared_ptr<BoundingBox>>(image_name, info));
+    return _store.find(_image_name) != nullptr;
 }
 
 void CaffeMetaDataReaderDetection::lookup(const std::vector<std::string> &_image_names) {
@@ -63,31 +52,35 @@ void CaffeMetaDataReaderDetection::lookup(const std::vector<std::string> &_image
         _output->resize(_image_names.size());
 
     for (unsigned i = 0; i < _image_names.size(); i++) {
-        auto image_name = _image_names[i];
-        auto it = _map_content.find(image_name);
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_bb_cords_batch()[i] = it->second->get_bb_cords();
-        _output->get_labels_batch()[i] = it->second->get_labels();
-        _output->get_img_sizes_batch()[i] = it->second->get_img_size();
+        auto entry = _store.find(_image_names[i]);
+        if (!entry)
+            THROW("ERROR: Given name not present in the map" + _image_names[i])
+        auto boxes = _store.boxes(*entry);
+        auto labels = _store.labels(*entry);
+        _output->get_bb_cords_batch()[i].assign(boxes.begin(), boxes.end());
+        _output->get_labels_batch()[i].assign(labels.begin(), labels.end());
+        _output->get_img_sizes_batch()[i] = entry->img_size;
     }
 }
 
-void CaffeMetaDataReaderDetection::print_map_contents() {
-    BoundingBoxCords bb_coords;
-    Labels bb_labels;
+const std::map<std::string, std::shared_ptr<MetaData>> &CaffeMetaDataReaderDetection::get_map_content() {
+    if (_map_content.empty())
+        _store.build_map_content(_map_content, false);
+    return _map_content;
+}
 
+void CaffeMetaDataReaderDetection::print_map_contents() {
     std::cerr << "\nMap contents: \n";
-    for (auto &elem : _map_content) {
-        std::cerr << "Name :\t " << elem.first;
-        bb_coords = elem.second->get_bb_cords();
-        bb_labels = elem.second->get_labels();
-        std::cerr << "\nsize of the element  : " << bb_coords.size() << std::endl;
-        for (unsigned int i = 0; i < bb_coords.size(); i++) {
+    _store.for_each([&](const std::string &image_name, const FlatMetaDataStore::Entry &entry) {
+        auto bb_coords = _store.boxes(entry);
+        auto bb_labels = _store.labels(entry);
+        std::cerr << "Name :\t " << image_name;
+        std::cerr << "\nsize of the element  : " << bb_coords.size << std::endl;
+        for (unsigned int i = 0; i < bb_coords.size; i++) {
             std::cerr << " l : " << bb_coords[i].l << " t: :" << bb_coords[i].t << " r : " << bb_coords[i].r << " b: :" << bb_coords[i].b << std::endl;
             std::cerr << "Label Id : " << bb_labels[i] << std::endl;
         }
-    }
+    });
 }
 
 void CaffeMetaDataReaderDetection::read_all(const std::string &path) {
@@ -102,7 +95,14 @@ void CaffeMetaDataReaderDetection::read_all(const std::string &path) {
     in_file1.seekg(0, ios::end);
     file_size1 = in_file1.tellg();
     file_bytes = file_size + file_size1;
+    // The parsed boxes are cached next to the LMDB folder, keyed by the database file
+    std::string cache_path = FlatMetaDataStore::cache_path(path);
+    uint64_t source_key = FlatMetaDataStore::source_key({tmp1}, "CaffeDetection");
+    if (_store.load(cache_path, source_key))
+        return;
     read_lmdb_record(path, file_bytes);
+    _store.finalize();
+    _store.save(cache_path, source_key);
     // print_map_contents();
 }
 
@@ -133,10 +133,8 @@ void CaffeMetaDataReaderDetection::read_lmdb_record(std::string file_name, uint
 
         int boundBox_size = annotGrp_protos.annotation_size();
 
-        BoundingBoxCords bb_coords;
-        Labels bb_labels;
         BoundingBoxCord box;
-        ImgSize img_size;
+        ImgSize img_size = {};
 
         if (boundBox_size > 0) {
             for (int i = 0; i < boundBox_size; i++) {
@@ -151,18 +149,12 @@ void CaffeMetaDataReaderDetection::read_lmdb_record(std::string file_name, uint
 
                 int label = bbox_protos.label();
 
-                bb_coords.push_back(box);
-                bb_labels.push_back(label);
-                add(file_name.c_str(), bb_coords, bb_labels, img_size);
-                bb_coords.clear();
-                bb_labels.clear();
+                _store.add_annotation(file_name, 0, img_size, box, label);
             }
         } else {
             box.l = box.t = 0;
             box.r = box.b = 1;
-            bb_coords.push_back(box);
-            bb_labels.push_back(0);
-            add(file_name.c_str(), bb_coords, bb_labels, img_size);
+            _store.add_annotation(file_name, 0, img_size, box, 0);
         }
     }
     // Closing all the LMDB environment and cursor handles
@@ -177,10 +169,12 @@ void CaffeMetaDataReaderDetection::release(std::string _image_name) {
         WRN("ERROR: Given not present in the map" + _image_name);
         return;
     }
+    _store.erase(_image_name);
     _map_content.erase(_image_name);
 }
 
 void CaffeMetaDataReaderDetection::release() {
+    _store.clear();
     _map_content.clear();
 }
 
@@ -40,14 +40,14 @@ void COCOMetaDataReader::init(const MetaDataConfig &cfg, pMetaDataBatch meta_dat
 }
 
 bool COCOMetaDataReader::exists(const std::string &image_name) {
-    return _map_content.find(image_name) != _map_content.end();
+    return _store.find(image_name) != nullptr;
 }
 
 ImgSize COCOMetaDataReader::lookup_image_size(const std::string &image_name) {
-    auto it = _map_content.find(image_name);
-    if (_map_content.end() == it)
+    auto entry = _store.find(image_name);
+    if (!entry)
         THROW("ERROR: Given name not present in the map " + image_name)
-    return it->second->get_img_size();
+    return entry->img_size;
 }
 
 void COCOMetaDataReader::lookup(const std::vector<std::string> &image_names) {
@@ -55,90 +55,82 @@ void COCOMetaDataReader::lookup(const std::vector<std::string> &image_names) {
         WRN("No image names passed")
         return;
     }
-    if (image_names.size() != (unsigned)_output->size())
-        _output->resize(image_names.size());
+    // Every sample is rewritten below, the values of the previous batch still held by its clones are released instead of copied
+    _output->prepare_overwrite(image_names.size());
 
+    auto &bb_cords_batch = _output->get_bb_cords_batch();
+    auto &labels_batch = _output->get_labels_batch();
+    bool is_polygon_mask = _output->get_metadata_type() == MetaDataType::PolygonMask;
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto it = _map_content.find(image_name);
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_bb_cords_batch()[i] = it->second->get_bb_cords();
-        _output->get_labels_batch()[i] = it->second->get_labels();
-        _output->get_img_sizes_batch()[i] = it->second->get_img_size();
-        _output->get_image_id_batch()[i] = it->second->get_image_id();
-        if (_output->get_metadata_type() == MetaDataType::PolygonMask) {
-            auto mask_cords = it->second->get_mask_cords();
-            _output->get_mask_cords_batch()[i] = mask_cords;
-            _output->get_mask_polygons_count_batch()[i] = it->second->get_polygon_count();
-            _output->get_mask_vertices_count_batch()[i] = it->second->get_vertices_count();
+        auto entry = _store.find(image_names[i]);
+        if (!entry)
+            THROW("ERROR: Given name not present in the map" + image_names[i])
+        // assign() reuses the storage of the previous batch
+        auto boxes = _store.boxes(*entry);
+        auto labels = _store.labels(*entry);
+        bb_cords_batch[i].assign(boxes.begin(), boxes.end());
+        labels_batch[i].assign(labels.begin(), labels.end());
+        _output->get_img_sizes_batch()[i] = entry->img_size;
+        _output->get_image_id_batch()[i] = entry->image_id;
+        if (is_polygon_mask) {
+            auto mask_cords = _store.mask_cords(*entry);
+            auto polygon_counts = _store.polygon_counts(*entry);
+            auto vertices_counts = _store.vertices_counts(*entry);
+            _output->get_mask_cords_batch()[i].assign(mask_cords.begin(), mask_cords.end());
+            _output->get_mask_polygons_count_batch()[i].assign(polygon_counts.begin(), polygon_counts.end());
+            auto &vertices_count = _output->get_mask_vertices_count_batch()[i];
+            vertices_count.resize(entry->box_count);
+            for (unsigned box = 0, polygon = 0; box < entry->box_count; polygon += polygon_counts[box], box++)
+                vertices_count[box].assign(vertices_counts.begin() + polygon, vertices_counts.begin() + polygon + polygon_counts[box]);
         }
     }
 }
 
-void COCOMetaDataReader::add(std::string image_name, BoundingBoxCords bb_coords, Labels bb_labels, ImgSize image_size, MaskCords mask_cords, std::vector<int> polygon_count, std::vector<std::vector<int>> vertices_count, int image_id) {
-    if (exists(image_name)) {
-        auto it = _map_content.find(image_name);
-        it->second->get_bb_cords().push_back(bb_coords[0]);
-        it->second->get_labels().push_back(bb_labels[0]);
-        it->second->get_mask_cords().insert(it->second->get_mask_cords().end(), mask_cords.begin(), mask_cords.end());
-        it->second->get_polygon_count().push_back(polygon_count[0]);
-        it->second->get_vertices_count().push_back(vertices_count[0]);
-        return;
-    }
-    pMetaDataPolygonMask info = std::make_shared<PolygonMask>(bb_coords, bb_labels, image_size, mask_cords, polygon_count, vertices_count, image_id);
-    _map_content.insert(pair<std::string, std::shared_ptr<PolygonMask>>(image_name, info));
-}
-
-void COCOMetaDataReader::add(std::string image_name, BoundingBoxCords bb_coords, Labels bb_labels, ImgSize image_size, int image_id) {
-    if (exists(image_name)) {
-        auto it = _map_content.find(image_name);
-        it->second->get_bb_cords().push_back(bb_coords[0]);
-        it->second->get_labels().push_back(bb_labels[0]);
-        return;
-    }
-    pMetaDataBox info = std::make_shared<BoundingBox>(bb_coords, bb_labels, image_size, image_id);
-    _map_content.insert(pair<std::string, std::shared_ptr<BoundingBox>>(image_name, info));
+const std::map<std::string, std::shared_ptr<MetaData>> &COCOMetaDataReader::get_map_content() {
+    // The per image objects are only needed by the readers walking all the annotations (random bbox crop), they are built once from the store
+    if (_map_content.empty())
+        _store.build_map_content(_map_content, _output->get_metadata_type() == MetaDataType::PolygonMask);
+    return _map_content;
 }
 
 void COCOMetaDataReader::print_map_contents() {
-    BoundingBoxCords bb_coords;
-    Labels bb_labels;
-    ImgSize img_size;
-    MaskCords mask_cords;
-    std::vector<int> polygon_size;
-    std::vector<std::vector<int>> vertices_count;
-
     std::cout << "\nBBox Annotations List: \n";
-    for (auto &elem : _map_content) {
-        std::cout << "\nName :\t " << elem.first;
-        bb_coords = elem.second->get_bb_cords();
-        bb_labels = elem.second->get_labels();
-        img_size = elem.second->get_img_size();
-        std::cout << "<wxh, num of bboxes>: " << img_size.w << " X " << img_size.h << " , " << bb_coords.size() << std::endl;
-        for (unsigned int i = 0; i < bb_coords.size(); i++) {
+    _store.for_each([&](const std::string &image_name, const FlatMetaDataStore::Entry &entry) {
+        auto bb_coords = _store.boxes(entry);
+        auto bb_labels = _store.labels(entry);
+        std::cout << "\nName :\t " << image_name;
+        std::cout << "<wxh, num of bboxes>: " << entry.img_size.w << " X " << entry.img_size.h << " , " << bb_coords.size << std::endl;
+        for (unsigned int i = 0; i < bb_coords.size; i++) {
             std::cout << " l : " << bb_coords[i].l << " t: :" << bb_coords[i].t << " r : " << bb_coords[i].r << " b: :" << bb_coords[i].b << "Label Id : " << bb_labels[i] << std::endl;
         }
         if (_output->get_metadata_type() == MetaDataType::PolygonMask) {
-            int count = 0;
-            mask_cords = elem.second->get_mask_cords();
-            polygon_size = elem.second->get_polygon_count();
-            vertices_count = elem.second->get_vertices_count();
-            std::cout << "\nNumber of objects : " << bb_coords.size() << std::endl;
-            for (unsigned int i = 0; i < bb_coords.size(); i++) {
+            auto mask_cords = _store.mask_cords(entry);
+            auto polygon_size = _store.polygon_counts(entry);
+            auto vertices_count = _store.vertices_counts(entry);
+            std::cout << "\nNumber of objects : " << bb_coords.size << std::endl;
+            for (unsigned int i = 0, count = 0, polygon = 0; i < bb_coords.size; i++) {
                 std::cout << "\nNumber of polygons for object[ << " << i << "]:" << polygon_size[i];
-                for (int j = 0; j < polygon_size[i]; j++) {
-                    std::cout << "\nPolygon size :" << vertices_count[i][j] << "Elements::";
-                    for (int k = 0; k < vertices_count[i][j]; k++, count++)
+                for (int j = 0; j < polygon_size[i]; j++, polygon++) {
+                    std::cout << "\nPolygon size :" << vertices_count[polygon] << "Elements::";
+                    for (int k = 0; k < vertices_count[polygon]; k++, count++)
                         std::cout << "\t " << mask_cords[count];
                 }
             }
         }
-    }
+    });
 }
 
 void COCOMetaDataReader::read_all(const std::string &path) {
     _coco_metadata_read_time.start();  // Debug timing
+    // The parsed annotations are cached next to the json file, the cache is keyed by the json file and the options changing the parsed values
+    std::string cache_path = FlatMetaDataStore::cache_path(path);
+    std::string cache_options = "COCO type:" + TOSTR(static_cast<int>(_output->get_metadata_type())) + " avoid_class_remapping:" + TOSTR(_avoid_class_remapping);
+    uint64_t source_key = FlatMetaDataStore::source_key({path}, cache_options);
+    if (_store.load(cache_path, source_key)) {
+        _coco_metadata_read_time.end();  // Debug timing
+        LOG("COCOMetaDataReader: Loaded " + TOSTR(_store.size()) + " annotated images from the annotation cache " + cache_path)
+        return;
+    }
     std::ifstream f;
     f.open(path, std::ifstream::in | std::ios::binary);
     if (f.fail()) THROW("ERROR: Given annotations file not present " + path);
@@ -159,13 +151,6 @@ void COCOMetaDataReader::read_all(const std::string &path) {
 
     LookaheadParser parser(buff.get());
 
-    BoundingBoxCords bb_coords;
-    Labels bb_labels;
-    ImgSizes img_sizes;
-    std::vector<int> polygon_count;
-    int polygon_size = 0;
-    std::vector<std::vector<int>> vertices_count;
-
     BoundingBoxCord box;
     ImgSize img_size;
     RAPIDJSON_ASSERT(parser.PeekType() == kObjectType);
@@ -255,7 +240,6 @@ void COCOMetaDataReader::read_all(const std::string &path) {
                             RAPIDJSON_ASSERT(parser.PeekType() == kArrayType);
                             parser.EnterArray();
                             while (parser.NextArrayValue()) {
-                                polygon_size += 1;
                                 int vertex_count = 0;
                                 parser.EnterArray();
                                 while (parser.NextArrayValue()) {
@@ -278,28 +262,13 @@ void COCOMetaDataReader::read_all(const std::string &path) {
                     box.t = bbox[1];
                     box.r = (bbox[0] + bbox[2] - 1);
                     box.b = (bbox[1] + bbox[3] - 1);
-                    bb_coords.push_back(box);
-                    bb_labels.push_back(label);
-                    polygon_count.push_back(polygon_size);
-                    vertices_count.push_back(vertices_array);
-                    add(itr->second, bb_coords, bb_labels, image_size, mask, polygon_count, vertices_count, id);
-                    mask.clear();
-                    polygon_size = 0;
-                    polygon_count.clear();
-                    vertices_count.clear();
-                    vertices_array.clear();
-                    bb_coords.clear();
-                    bb_labels.clear();
+                    _store.add_annotation(itr->second, id, image_size, box, label, mask.data(), mask.size(), vertices_array);
                 } else if (!(_output->get_metadata_type() == MetaDataType::PolygonMask)) {
                     box.l = bbox[0];
                     box.t = bbox[1];
                     box.r = (bbox[0] + bbox[2]);
                     box.b = (bbox[1] + bbox[3]);
-                    bb_coords.push_back(box);
-                    bb_labels.push_back(label);
-                    add(itr->second, bb_coords, bb_labels, image_size, id);
-                    bb_coords.clear();
-                    bb_labels.clear();
+                    _store.add_annotation(itr->second, id, image_size, box, label);
                 }
                 image_size = {};
             }
@@ -307,17 +276,12 @@ void COCOMetaDataReader::read_all(const std::string &path) {
             parser.SkipValue();
         }
     }
-    for (auto &elem : _map_content) {
-        bb_coords = elem.second->get_bb_cords();
-        bb_labels = elem.second->get_labels();
-        Labels continuous_label_id;
-        for (unsigned int i = 0; i < bb_coords.size(); i++) {
-            auto _it_label = _label_info.find(bb_labels[i]);
-            int cnt_idx = _avoid_class_remapping ? _it_label->first : _it_label->second;
-            continuous_label_id.push_back(cnt_idx);
-        }
-        elem.second->set_labels(continuous_label_id);
+    _store.finalize();
+    for (auto &label : _store.labels_column()) {
+        auto _it_label = _label_info.find(label);
+        label = _avoid_class_remapping ? _it_label->first : _it_label->second;
     }
+    _store.save(cache_path, source_key);
     _coco_metadata_read_time.end();  // Debug timing
     // print_map_contents();
     //  std::cout << "coco read time in sec: " << _coco_metadata_read_time.get_timing() / 1000 << std::endl;
@@ -328,10 +292,12 @@ void COCOMetaDataReader::release(std::string image_name) {
         WRN("ERROR: Given name not present in the map" + image_name);
         return;
     }
+    _store.erase(image_name);
     _map_content.erase(image_name);
 }
 
 void COCOMetaDataReader::release() {
+    _store.clear();
     _map_content.clear();
     _map_img_sizes.clear();
 }
@@ -0,0 +1,389 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "meta_data/flat_meta_data_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "pipeline/commons.h"
+
+namespace {
+// Layout of the cache file: the header followed by the columns, each column starts on a CACHE_ALIGNMENT boundary so it can be used in place
+constexpr char CACHE_MAGIC[8] = {'R', 'O', 'C', 'A', 'L', 'M', 'D', 'C'};
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr size_t CACHE_ALIGNMENT = 64;
+constexpr size_t SOURCE_SAMPLE_SIZE = 64 * 1024;  // Bytes hashed at the start and at the end of every source file
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_size;       // sizeof(Entry) and sizeof(BoundingBoxCord) of the writer, guards against layout changes
+    uint32_t box_size;
+    uint32_t reserved;
+    uint64_t source_key;
+    uint64_t entry_count;
+    uint64_t box_count;
+    uint64_t vertices_count;
+    uint64_t mask_count;
+    uint64_t names_size;
+};
+
+size_t align_up(size_t offset) { return (offset + CACHE_ALIGNMENT - 1) & ~(CACHE_ALIGNMENT - 1); }
+
+uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+    auto bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Offsets of the columns in the cache file, shared by save() and load()
+struct CacheLayout {
+    size_t entries, boxes, labels, polygon_counts, vertices_counts, mask_cords, name_offsets, names, file_size;
+    explicit CacheLayout(const CacheHeader &header) {
+        entries = align_up(sizeof(CacheHeader));
+        boxes = align_up(entries + header.entry_count * header.entry_size);
+        labels = align_up(boxes + header.box_count * header.box_size);
+        polygon_counts = align_up(labels + header.box_count * sizeof(int));
+        vertices_counts = align_up(polygon_counts + header.box_count * sizeof(int));
+        mask_cords = align_up(vertices_counts + header.vertices_count * sizeof(int));
+        name_offsets = align_up(mask_cords + header.mask_count * sizeof(float));
+        names = align_up(name_offsets + (header.entry_count + 1) * sizeof(uint64_t));
+        file_size = names + header.names_size;
+    }
+};
+}  // namespace
+
+static_assert(sizeof(BoundingBoxCord) == 4 * sizeof(float), "BoundingBoxCord is stored as raw bytes in the annotation cache");
+
+void FlatMetaDataStore::add_annotation(const std::string &image_name, int image_id, const ImgSize &img_size, const BoundingBoxCord &box, int label,
+                                       const float *mask_cords, size_t mask_size, const std::vector<int> &vertices_count) {
+    auto it = _index.find(image_name);
+    unsigned entry_idx;
+    if (it == _index.end()) {
+        entry_idx = _entries.size();
+        Entry entry;
+        entry.image_id = image_id;
+        entry.img_size = img_size;
+        _entries.push_back(entry);
+        _index.emplace(image_name, entry_idx);
+        _id_index.emplace(image_id, entry_idx);
+    } else {
+        entry_idx = it->second;
+    }
+    // The mask data is appended in parsing order, finalize() moves it next to the other annotations of the image
+    PendingAnnotation annotation{entry_idx, box, label,
+                                 static_cast<unsigned>(_mask_cords.size()), static_cast<unsigned>(mask_size),
+                                 static_cast<unsigned>(_vertices_counts.size()), static_cast<unsigned>(vertices_count.size())};
+    if (mask_cords)
+        _mask_cords.insert(_mask_cords.end(), mask_cords, mask_cords + mask_size);
+    _vertices_counts.insert(_vertices_counts.end(), vertices_count.begin(), vertices_count.end());
+    _pending.push_back(annotation);
+    auto &entry = _entries[entry_idx];
+    entry.box_count++;
+    entry.mask_count += mask_size;
+    entry.polygon_count += vertices_count.size();
+}
+
+void FlatMetaDataStore::view_owned_columns() {
+    _mapping.reset();
+    _view.entries = _entries.data();
+    _view.boxes = _boxes.data();
+    _view.labels = _labels.data();
+    _view.polygon_counts = _polygon_counts.data();
+    _view.vertices_counts = _vertices_counts.data();
+    _view.mask_cords = _mask_cords.data();
+    _view.entry_count = _entries.size();
+    _view.box_count = _boxes.size();
+    _view.vertices_count = _vertices_counts.size();
+    _view.mask_count = _mask_cords.size();
+}
+
+void FlatMetaDataStore::finalize() {
+    if (_pending.empty()) {
+        view_owned_columns();
+        return;
+    }
+    // Counting sort of the annotations by image, keeping the parsing order of the annotations of each image
+    unsigned box_offset = 0, mask_offset = 0, vertices_offset = 0;
+    for (auto &entry : _entries) {
+        entry.box_offset = box_offset;
+        entry.mask_offset = mask_offset;
+        entry.vertices_offset = vertices_offset;
+        box_offset += entry.box_count;
+        mask_offset += entry.mask_count;
+        vertices_offset += entry.polygon_count;
+    }
+    std::vector<BoundingBoxCord> boxes(box_offset);
+    std::vector<int> labels(box_offset), polygon_counts(box_offset), vertices_counts(vertices_offset);
+    std::vector<float> mask_cords(mask_offset);
+    std::vector<unsigned> box_pos(_entries.size()), mask_pos(_entries.size()), vertices_pos(_entries.size());
+    for (unsigned i = 0; i < _entries.size(); i++) {
+        box_pos[i] = _entries[i].box_offset;
+        mask_pos[i] = _entries[i].mask_offset;
+        vertices_pos[i] = _entries[i].vertices_offset;
+    }
+    for (auto &annotation : _pending) {
+        auto idx = annotation.entry_idx;
+        boxes[box_pos[idx]] = annotation.box;
+        labels[box_pos[idx]] = annotation.label;
+        polygon_counts[box_pos[idx]] = annotation.polygon_count;
+        box_pos[idx]++;
+        std::copy_n(_mask_cords.begin() + annotation.mask_offset, annotation.mask_count, mask_cords.begin() + mask_pos[idx]);
+        mask_pos[idx] += annotation.mask_count;
+        std::copy_n(_vertices_counts.begin() + annotation.vertices_offset, annotation.polygon_count, vertices_counts.begin() + vertices_pos[idx]);
+        vertices_pos[idx] += annotation.polygon_count;
+    }
+    _boxes = std::move(boxes);
+    _labels = std::move(labels);
+    _polygon_counts = std::move(polygon_counts);
+    _vertices_counts = std::move(vertices_counts);
+    _mask_cords = std::move(mask_cords);
+    std::vector<PendingAnnotation>().swap(_pending);
+    view_owned_columns();
+}
+
+void FlatMetaDataStore::clear() {
+    _entries.clear();
+    _index.clear();
+    _id_index.clear();
+    _pending.clear();
+    _boxes.clear();
+    _labels.clear();
+    _polygon_counts.clear();
+    _vertices_counts.clear();
+    _mask_cords.clear();
+    _view = {};
+    _mapping.reset();
+}
+
+void FlatMetaDataStore::erase(const std::string &image_name) {
+    auto it = _index.find(image_name);
+    if (it == _index.end())
+        return;
+    _id_index.erase(_view.entries[it->second].image_id);
+    _index.erase(it);
+}
+
+const FlatMetaDataStore::Entry *FlatMetaDataStore::find(const std::string &image_name) const {
+    auto it = _index.find(image_name);
+    return it == _index.end() ? nullptr : &_view.entries[it->second];
+}
+
+const FlatMetaDataStore::Entry *FlatMetaDataStore::find(int image_id) const {
+    auto it = _id_index.find(image_id);
+    return it == _id_index.end() ? nullptr : &_view.entries[it->second];
+}
+
+void FlatMetaDataStore::build_map_content(std::map<std::string, std::shared_ptr<MetaData>> &map_content, bool with_masks) const {
+    for_each([&](const std::string &image_name, const Entry &entry) {
+        auto box_span = boxes(entry);
+        auto label_span = labels(entry);
+        BoundingBoxCords bb_coords(box_span.begin(), box_span.end());
+        Labels bb_labels(label_span.begin(), label_span.end());
+        if (with_masks) {
+            auto mask = mask_cords(entry);
+            auto polygons = polygon_counts(entry);
+            auto vertices = vertices_counts(entry);
+            std::vector<std::vector<int>> vertices_count(entry.box_count);
+            for (unsigned box = 0, polygon = 0; box < entry.box_count; polygon += polygons[box], box++)
+                vertices_count[box].assign(vertices.begin() + polygon, vertices.begin() + polygon + polygons[box]);
+            map_content.emplace(image_name, std::make_shared<PolygonMask>(bb_coords, bb_labels, entry.img_size, MaskCords(mask.begin(), mask.end()),
+                                                                          std::vector<int>(polygons.begin(), polygons.end()), vertices_count, entry.image_id));
+        } else {
+            map_content.emplace(image_name, std::make_shared<BoundingBox>(bb_coords, bb_labels, entry.img_size, entry.image_id));
+        }
+    });
+}
+
+bool FlatMetaDataStore::save(const std::string &cache_path, uint64_t source_key) const {
+    if (!_pending.empty() || !_view.entries)
+        return false;
+    // Images removed with erase() keep an empty name and are skipped by load()
+    std::vector<const std::string *> names(_view.entry_count, nullptr);
+    uint64_t names_size = 0;
+    for (auto &elem : _index) {
+        names[elem.second] = &elem.first;
+        names_size += elem.first.size();
+    }
+    std::vector<uint64_t> name_offsets(_view.entry_count + 1, 0);
+    for (size_t i = 0; i < names.size(); i++)
+        name_offsets[i + 1] = name_offsets[i] + (names[i] ? names[i]->size() : 0);
+
+    CacheHeader header = {};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.entry_size = sizeof(Entry);
+    header.box_size = sizeof(BoundingBoxCord);
+    header.source_key = source_key;
+    header.entry_count = _view.entry_count;
+    header.box_count = _view.box_count;
+    header.vertices_count = _view.vertices_count;
+    header.mask_count = _view.mask_count;
+    header.names_size = names_size;
+    CacheLayout layout(header);
+
+    // Write to a temporary file first so concurrent jobs never map a partially written cache
+    std::string tmp_path = cache_path + ".tmp" + TOSTR(getpid());
+    {
+        std::ofstream cache_file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!cache_file) {
+            WRN("FlatMetaDataStore: Cannot write the annotation cache " + cache_path)
+            return false;
+        }
+        const char padding[CACHE_ALIGNMENT] = {};
+        auto write_at = [&](size_t offset, const void *data, size_t size) {
+            size_t position = cache_file.tellp();
+            cache_file.write(padding, offset - position);
+            cache_file.write(static_cast<const char *>(data), size);
+        };
+        cache_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        write_at(layout.entries, _view.entries, header.entry_count * sizeof(Entry));
+        write_at(layout.boxes, _view.boxes, header.box_count * sizeof(BoundingBoxCord));
+        write_at(layout.labels, _view.labels, header.box_count * sizeof(int));
+        write_at(layout.polygon_counts, _view.polygon_counts, header.box_count * sizeof(int));
+        write_at(layout.vertices_counts, _view.vertices_counts, header.vertices_count * sizeof(int));
+        write_at(layout.mask_cords, _view.mask_cords, header.mask_count * sizeof(float));
+        write_at(layout.name_offsets, name_offsets.data(), name_offsets.size() * sizeof(uint64_t));
+        write_at(layout.names, nullptr, 0);
+        for (auto name : names)
+            if (name) cache_file.write(name->data(), name->size());
+        if (!cache_file) {
+            WRN("FlatMetaDataStore: Failed writing the annotation cache " + cache_path)
+            cache_file.close();
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+        WRN("FlatMetaDataStore: Cannot replace the annotation cache " + cache_path)
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FlatMetaDataStore::load(const std::string &cache_path, uint64_t source_key) {
+    int fd = open(cache_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(CacheHeader)) {
+        close(fd);
+        return false;
+    }
+    size_t file_size = file_stat.st_size;
+    void *address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        WRN("FlatMetaDataStore: Cannot map the annotation cache " + cache_path)
+        return false;
+    }
+    std::shared_ptr<void> mapping(address, [file_size](void *ptr) { munmap(ptr, file_size); });
+    auto base = static_cast<const char *>(address);
+    CacheHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.entry_size != sizeof(Entry) || header.box_size != sizeof(BoundingBoxCord)) {
+        WRN("FlatMetaDataStore: Ignoring invalid annotation cache " + cache_path)
+        return false;
+    }
+    if (header.source_key != source_key)
+        return false;  // The annotations changed since the cache was written
+    CacheLayout layout(header);
+    if (layout.file_size != file_size) {
+        WRN("FlatMetaDataStore: Annotation cache " + cache_path + " is truncated, rebuilding it")
+        return false;
+    }
+
+    clear();
+    _view.entries = reinterpret_cast<const Entry *>(base + layout.entries);
+    _view.boxes = reinterpret_cast<const BoundingBoxCord *>(base + layout.boxes);
+    _view.labels = reinterpret_cast<const int *>(base + layout.labels);
+    _view.polygon_counts = reinterpret_cast<const int *>(base + layout.polygon_counts);
+    _view.vertices_counts = reinterpret_cast<const int *>(base + layout.vertices_counts);
+    _view.mask_cords = reinterpret_cast<const float *>(base + layout.mask_cords);
+    _view.entry_count = header.entry_count;
+    _view.box_count = header.box_count;
+    _view.vertices_count = header.vertices_count;
+    _view.mask_count = header.mask_count;
+    _mapping = std::move(mapping);
+
+    // Only the hash indexes are rebuilt, the columns stay in the mapped file
+    auto name_offsets = reinterpret_cast<const uint64_t *>(base + layout.name_offsets);
+    auto names = base + layout.names;
+    _index.reserve(header.entry_count);
+    _id_index.reserve(header.entry_count);
+    for (unsigned i = 0; i < header.entry_count; i++) {
+        if (name_offsets[i + 1] == name_offsets[i])
+            continue;
+        _index.emplace(std::string(names + name_offsets[i], name_offsets[i + 1] - name_offsets[i]), i);
+        _id_index.emplace(_view.entries[i].image_id, i);
+    }
+    return true;
+}
+
+uint64_t FlatMetaDataStore::source_key(const std::vector<std::string> &source_paths, const std::string &options) {
+    uint64_t key = fnv1a(14695981039346656037ULL, options.data(), options.size());
+    std::vector<char> sample(SOURCE_SAMPLE_SIZE);
+    for (auto &path : source_paths) {
+        key = fnv1a(key, path.data(), path.size());
+        struct stat file_stat;
+        if (stat(path.c_str(), &file_stat) != 0)
+            continue;
+        int64_t mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+        uint64_t file_size = file_stat.st_size;
+        key = fnv1a(key, &mtime_ns, sizeof(mtime_ns));
+        key = fnv1a(key, &file_size, sizeof(file_size));
+        // The start and the end of the content are hashed as well, so a file rewritten with the same size and a restored mtime is still detected
+        std::ifstream file(path, std::ios::binary);
+        file.read(sample.data(), sample.size());
+        key = fnv1a(key, sample.data(), file.gcount());
+        if (file_size > 2 * SOURCE_SAMPLE_SIZE) {
+            file.clear();
+            file.seekg(file_size - SOURCE_SAMPLE_SIZE);
+            file.read(sample.data(), sample.size());
+            key = fnv1a(key, sample.data(), file.gcount());
+        }
+    }
+    return key;
+}
+
+std::string FlatMetaDataStore::cache_path(const std::string &source_path) {
+    std::string path = source_path;
+    while (path.size() > 1 && path.back() == '/')
+        path.pop_back();
+    auto separator = path.find_last_of('/');
+    std::string folder = separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+    std::string name = separator == std::string::npos ? path : path.substr(separator + 1);
+    return folder + "." + name + ".rocal_meta.cache";
+}
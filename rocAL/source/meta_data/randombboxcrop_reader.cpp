@@ -41,7 +41,8 @@ void RandomBBoxCropReader::init(const RandomBBoxCrop_MetaDataConfig &cfg, std::s
     }
     _output = meta_data_batch;
     _user_batch_size = 128;  // todo:: get it from master graph
-    _seed = cfg.seed();
+    // Without an explicit seed the crops follow the seed of the pipeline
+    _seed = cfg.seed() ? cfg.seed() : ParameterFactory::instance()->get_seed();
 }
 
 void RandomBBoxCropReader::set_meta_data(std::shared_ptr<MetaDataReader> meta_data_reader) {
@@ -121,201 +122,103 @@ void RandomBBoxCropReader::print_map_contents() {
     }
 }
 
-void RandomBBoxCropReader::read_all() {
-    release();
+const std::map<std::string, std::shared_ptr<MetaData>> &RandomBBoxCropReader::meta_bbox_map() {
+    // Looked up once, some meta data readers build the map on the first call
+    std::call_once(_meta_bbox_map_flag, [this] { _meta_bbox_map = &_meta_data_reader->get_map_content(); });
+    return *_meta_bbox_map;
+}
+
+BoundingBoxCord RandomBBoxCropReader::sample_crop(const BoundingBoxCords &bb_coords, int img_width, CounterRNG &rng) const {
     const std::vector<float> sample_options = {-1.0f, 0.1f, 0.3f, 0.5f, 0.7f, 0.9f, 0.0f};
-    int sample_option;
-    float min_iou;
-    bool invalid_bboxes;
-    bool crop_success;
-    BoundingBoxCord crop_box;
-    uint bb_count;
-    _meta_bbox_map_content = _meta_data_reader->get_map_content();
     std::uniform_int_distribution<> option_dis(0, 6);
-    std::uniform_real_distribution<float> _float_dis(0.3, 1.0);
-
-    size_t sample = 0;
-    for (auto &elem : _meta_bbox_map_content) {
-        std::string image_name = elem.first;
-        BoundingBoxCords bb_coords = elem.second->get_bb_cords();
-        bb_count = bb_coords.size();
-        while (true) {
-            crop_success = false;
-            sample_option = option_dis(_rngs[sample]);
-            min_iou = sample_options[sample_option];
-            invalid_bboxes = false;
-
-            // Condition for Original Image
-            if (sample_option == 6 || _has_shape) {
-                crop_box.l = 0;
-                crop_box.t = 0;
-                crop_box.r = 1;
-                crop_box.b = 1;
-                break;
-            }
-
-            // If it has no shape, then area and aspect ratio thing should be provided
-            for (int j = 0; j < 1; j++) {
-                // Setting width and height factor btw 0.3 and 1.0";
-                float width_factor = _float_dis(_rngs[sample]);
-                float height_factor = _float_dis(_rngs[sample]);
-                if ((width_factor / height_factor < 0.5) || (width_factor / height_factor > 2.)) {
-                    continue;
-                }
-                // Setting width factor btw 0 and 1 - width_factor and height factor btw 0 and 1 - height_factor
-                std::uniform_real_distribution<float> l_dis(0.0, 1.0 - width_factor), t_dis(0.0, 1.0 - height_factor);
-                float x_factor = l_dis(_rngs[sample]);
-                float y_factor = t_dis(_rngs[sample]);
-                crop_box.l = x_factor;
-                crop_box.t = y_factor;
-                crop_box.r = crop_box.l + width_factor;
-                crop_box.b = crop_box.t + height_factor;
-                // std::cout << "random crop params < option, xfactor, yfactor, wf, hf>: " << sample_option << " " << x_factor << " " << y_factor << " " << width_factor << " " << height_factor << std::endl;
-                //  All boxes should satisfy IOU criteria
-                if (_all_boxes_overlap) {
-                    for (uint j = 0; j < bb_count; j++) {
-                        float bb_iou = ssd_BBoxIntersectionOverUnion(bb_coords[j], crop_box, true);
-                        if (bb_iou < min_iou) {
-                            invalid_bboxes = true;
-                            break;
-                        }
-                    }
-                    if (invalid_bboxes) {
-                        continue;  // Goes to for loop
-                    }
-                }
-
-                // Mask Condition
-                int valid_bbox_count = 0;
-                valid_bbox_count = 0;
-                for (uint j = 0; j < bb_count; j++) {
-                    auto x_c = 0.5 * (bb_coords[j].l + bb_coords[j].r);
-                    auto y_c = 0.5 * (bb_coords[j].t + bb_coords[j].b);
-                    if ((x_c > crop_box.l) && (x_c < crop_box.r) && (y_c > crop_box.t) && (y_c < crop_box.b)) {
-                        valid_bbox_count++;
-                    }
-                }
-                if (valid_bbox_count == 0)
+    std::uniform_real_distribution<float> float_dis(0.3, 1.0);
+    const BoundingBoxCord whole_image = {0, 0, 1, 1};
+    uint bb_count = bb_coords.size();
+    for (int attempt = 0; _total_num_of_attempts <= 0 || attempt < _total_num_of_attempts; attempt++) {
+        int sample_option = option_dis(rng);
+        // Condition for Original Image
+        if (sample_option == 6 || _has_shape)
+            return whole_image;
+
+        float min_iou = sample_options[sample_option];
+        // If it has no shape, then area and aspect ratio thing should be provided
+        // Setting width and height factor btw 0.3 and 1.0";
+        float width_factor = float_dis(rng);
+        float height_factor = float_dis(rng);
+        if ((width_factor / height_factor < 0.5) || (width_factor / height_factor > 2.))
+            continue;
+        // Setting width factor btw 0 and 1 - width_factor and height factor btw 0 and 1 - height_factor
+        std::uniform_real_distribution<float> l_dis(0.0, 1.0 - width_factor), t_dis(0.0, 1.0 - height_factor);
+        float x_factor = l_dis(rng);
+        float y_factor = t_dis(rng);
+        // todo::adjust x_factor and y_factor so that x and y is a multiple of 4 (tjpg crop coordinates req)
+        if (img_width > 0)
+            x_factor = (float)(std::lround(x_factor * img_width) & ~7) / img_width;
+        BoundingBoxCord crop_box = {x_factor, y_factor, (x_factor + width_factor), (y_factor + height_factor)};
+        // All boxes should satisfy IOU criteria
+        if (_all_boxes_overlap) {
+            bool invalid_bboxes = false;
+            for (uint j = 0; j < bb_count; j++) {
+                float bb_iou = ssd_BBoxIntersectionOverUnion(bb_coords[j], crop_box, true);
+                if (bb_iou < min_iou) {
+                    invalid_bboxes = true;
                     break;
-
-                crop_success = true;
-                break;
+                }
             }
+            if (invalid_bboxes)
+                continue;
+        }
+
+        // Mask Condition
+        for (uint j = 0; j < bb_count; j++) {
+            auto x_c = 0.5 * (bb_coords[j].l + bb_coords[j].r);
+            auto y_c = 0.5 * (bb_coords[j].t + bb_coords[j].b);
+            if ((x_c > crop_box.l) && (x_c < crop_box.r) && (y_c > crop_box.t) && (y_c < crop_box.b))
+                return crop_box;
+        }
+    }
+    // No valid crop within total_num_attempts, the image is kept whole
+    return whole_image;
+}
 
-            if (crop_success == true)
-                break;
-        }  // while loop
-
-        // std::cout << image_name << " crop<l,t,r,b>: " << crop_box.l << " X " << crop_box.t << " X " << crop_box.r << " X " << crop_box.b << std::endl;
-        add(image_name, crop_box);
-
-        sample++;
+void RandomBBoxCropReader::read_all() {
+    release();
+    uint64_t epoch = _epoch;
+    for (auto &elem : meta_bbox_map()) {
+        CounterRNG rng(_seed, epoch, CounterRNG::hash(elem.first));
+        add(elem.first, sample_crop(elem.second->get_bb_cords(), 0, rng));
     }
 }
 
+std::vector<float> RandomBBoxCropReader::get_crop_coords(const std::string &image_name) {
+    auto &meta_map = meta_bbox_map();
+    auto elem = meta_map.find(image_name);
+    if (meta_map.end() == elem)
+        THROW("ERROR: Given name not present in the map" + image_name)
+    // Every image draws from its own stream, so the crop only depends on the seed, the epoch and the image
+    CounterRNG rng(_seed, _epoch, CounterRNG::hash(image_name));
+    BoundingBoxCord crop_box = sample_crop(elem->second->get_bb_cords(), elem->second->get_img_size().w, rng);
+    // Crop coordinates expected in "xywh" format
+    return {crop_box.l, crop_box.t, crop_box.r - crop_box.l, crop_box.b - crop_box.t};
+}
+
 std::vector<std::vector<float>>
 RandomBBoxCropReader::get_batch_crop_coords(const std::vector<std::string> &image_names) {
     if (image_names.empty()) {
         std::cerr << "\n No images passed";
         THROW("No image names passed")
     }
-    if (image_names.size() != (unsigned)_output->size()) {
-        _output->resize(image_names.size());
-    }
-    const std::vector<float> sample_options = {-1.0f, 0.1f, 0.3f, 0.5f, 0.7f, 0.9f, 0.0f};
-    std::vector<float> coords_buf(4);
-    bool invalid_bboxes;
-    bool crop_success;
-    BoundingBoxCord crop_box;
-    uint bb_count;
-    _meta_bbox_map_content = _meta_data_reader->get_map_content();
-
-    std::uniform_int_distribution<> option_dis(0, 6);
-    std::uniform_real_distribution<float> _float_dis(0.3, 1.0);
-    _crop_coords.clear();
-    for (unsigned int i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto elem = _meta_bbox_map_content.find(image_name);
-        if (_meta_bbox_map_content.end() == elem)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        BoundingBoxCords bb_coords = elem->second->get_bb_cords();
-        ImgSize img_size = elem->second->get_img_size();
-        int img_width = img_size.w;
-        bb_count = bb_coords.size();
-        crop_success = false;
-        while (!crop_success) {
-            invalid_bboxes = false;
-            int sample_option = option_dis(_rngs[_sample_cnt]);
-            // Condition for Original Image
-            if (sample_option == 6 || _has_shape) {
-                crop_box.l = crop_box.t = 0;
-                crop_box.r = crop_box.b = 1;
-                break;
-            }
-
-            float min_iou = sample_options[sample_option];
-            // If it has no shape, then area and aspect ratio thing should be provided
-            for (int j = 0; j < 1; j++) {
-                // Setting width and height factor btw 0.3 and 1.0";
-                float width_factor = _float_dis(_rngs[_sample_cnt]);
-                float height_factor = _float_dis(_rngs[_sample_cnt]);
-                if ((width_factor / height_factor < 0.5) || (width_factor / height_factor > 2.)) {
-                    continue;
-                }
-                // Setting width factor btw 0 and 1 - width_factor and height factor btw 0 and 1 - height_factor
-                std::uniform_real_distribution<float> l_dis(0.0, 1.0 - width_factor), t_dis(0.0, 1.0 - height_factor);
-                float x_factor = l_dis(_rngs[_sample_cnt]);
-                float y_factor = t_dis(_rngs[_sample_cnt]);
-                // todo::adjust x_factor and y_factor so that x and y is a multiple of 4 (tjpg crop coordinates req)
-                x_factor = (float)(std::lround(x_factor * img_width) & ~7) / img_width;
-                crop_box = {x_factor, y_factor, (x_factor + width_factor), (y_factor + height_factor)};
-                // All boxes should satisfy IOU criteria
-                if (_all_boxes_overlap) {
-                    for (uint j = 0; j < bb_count; j++) {
-                        float bb_iou = ssd_BBoxIntersectionOverUnion(bb_coords[j], crop_box, true);
-                        if (bb_iou < min_iou) {
-                            invalid_bboxes = true;
-                            break;
-                        }
-                    }
-                    if (invalid_bboxes) {
-                        continue;  // Goes to for loop
-                    }
-                }
-
-                // Mask Condition
-                int valid_bbox_count = 0;
-                valid_bbox_count = 0;
-                for (uint j = 0; j < bb_count; j++) {
-                    auto x_c = 0.5 * (bb_coords[j].l + bb_coords[j].r);
-                    auto y_c = 0.5 * (bb_coords[j].t + bb_coords[j].b);
-                    if ((x_c > crop_box.l) && (x_c < crop_box.r) && (y_c > crop_box.t) && (y_c < crop_box.b)) {
-                        valid_bbox_count++;
-                    }
-                }
-                if (valid_bbox_count == 0)
-                    break;
-
-                crop_success = true;
-                break;
-            }
-        }  // while loop
-        // Crop coordinates expected in "xywh" format
-        coords_buf[0] = crop_box.l;
-        coords_buf[1] = crop_box.t;
-        coords_buf[2] = crop_box.r - crop_box.l;
-        coords_buf[3] = crop_box.b - crop_box.t;
-
-        _crop_coords.push_back(coords_buf);
-        _sample_cnt++;
-    }
-    return _crop_coords;
+    std::vector<std::vector<float>> crop_coords(image_names.size());
+    for (unsigned int i = 0; i < image_names.size(); i++)
+        crop_coords[i] = get_crop_coords(image_names[i]);
+    return crop_coords;
 }
 
 void RandomBBoxCropReader::release() {
     _map_content.clear();
-    _sample_cnt = 0;
+    // The readers are released on every reset, the next epoch draws different crops
+    _epoch++;
 }
 
-RandomBBoxCropReader::RandomBBoxCropReader() : _rngs(128), _sample_cnt(0) {
+RandomBBoxCropReader::RandomBBoxCropReader() {
 }
@@ -44,18 +44,7 @@ void TFMetaDataReaderDetection::init(const MetaDataConfig &cfg, pMetaDataBatch m
 }
 
 bool TFMetaDataReaderDetection::exists(const std::string &_image_name) {
-    return _map_content.find(_image_name) != _map_content.end();
-}
-
-void TFMetaDataReaderDetection::add(std::string image_name, BoundingBoxCords bb_coords, Labels bb_labels, ImgSize image_size) {
-    if (exists(image_name)) {
-        auto it = _map_content.find(image_name);
-        it->second->get_bb_cords().push_back(bb_coords[0]);
-        it->second->get_labels().push_back(bb_labels[0]);
-        return;
-    }
-    pMetaDataBox info = std::make_shared<BoundingBox>(bb_coords, bb_labels, image_size);
-    _map_content.insert(pair<std::string, std::shared_ptr<BoundingBox>>(image_name, info));
+    return _store.find(_image_name) != nullptr;
 }
 
 void TFMetaDataReaderDetection::lookup(const std::vector<std::string> &image_names) {
@@ -67,32 +56,35 @@ void TFMetaDataReaderDetection::lookup(const std::vector<std::string> &image_nam
         _output->resize(image_names.size());
 
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto it = _map_content.find(image_name);
-
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_bb_cords_batch()[i] = it->second->get_bb_cords();
-        _output->get_labels_batch()[i] = it->second->get_labels();
-        _output->get_img_sizes_batch()[i] = it->second->get_img_size();
+        auto entry = _store.find(image_names[i]);
+        if (!entry)
+            THROW("ERROR: Given name not present in the map" + image_names[i])
+        auto boxes = _store.boxes(*entry);
+        auto labels = _store.labels(*entry);
+        _output->get_bb_cords_batch()[i].assign(boxes.begin(), boxes.end());
+        _output->get_labels_batch()[i].assign(labels.begin(), labels.end());
+        _output->get_img_sizes_batch()[i] = entry->img_size;
     }
 }
 
-void TFMetaDataReaderDetection::print_map_contents() {
-    BoundingBoxCords bb_coords;
-    Labels bb_labels;
+const std::map<std::string, std::shared_ptr<MetaData>> &TFMetaDataReaderDetection::get_map_content() {
+    if (_map_content.empty())
+        _store.build_map_content(_map_content, false);
+    return _map_content;
+}
 
+void TFMetaDataReaderDetection::print_map_contents() {
     std::cerr << "\nMap contents: \n";
-    for (auto &elem : _map_content) {
-        std::cerr << "Name :\t " << elem.first;
-        bb_coords = elem.second->get_bb_cords();
-        bb_labels = elem.second->get_labels();
-        std::cerr << "\nsize of the element  : " << bb_coords.size() << std::endl;
-        for (unsigned int i = 0; i < bb_coords.size(); i++) {
+    _store.for_each([&](const std::string &image_name, const FlatMetaDataStore::Entry &entry) {
+        auto bb_coords = _store.boxes(entry);
+        auto bb_labels = _store.labels(entry);
+        std::cerr << "Name :\t " << image_name;
+        std::cerr << "\nsize of the element  : " << bb_coords.size << std::endl;
+        for (unsigned int i = 0; i < bb_coords.size; i++) {
             std::cerr << " l : " << bb_coords[i].l << " t: :" << bb_coords[i].t << " r : " << bb_coords[i].r << " b: :" << bb_coords[i].b << std::endl;
             std::cerr << "Label Id : " << bb_labels[i] << std::endl;
         }
-    }
+    });
 }
 
 void TFMetaDataReaderDetection::read_record(std::ifstream &file_contents, uint file_size, std::vector<std::string> &_image_name,
@@ -140,8 +132,6 @@ void TFMetaDataReaderDetection::read_record(std::ifstream &file_contents, uint f
     single_feature = feature.at(user_xmin_key);
     size_b_xmin = single_feature.float_list().value().size();
 
-    BoundingBoxCords bb_coords;
-    Labels bb_labels;
     BoundingBoxCord box;
 
     sf_label = feature.at(user_label_key);
@@ -168,11 +158,7 @@ void TFMetaDataReaderDetection::read_record(std::ifstream &file_contents, uint f
         box.t = sf_ymin.float_list().value()[i] * image_height;
         box.r = sf_xmax.float_list().value()[i] * image_width;
         box.b = sf_ymax.float_list().value()[i] * image_height;
-        bb_coords.push_back(box);
-        bb_labels.push_back(label);
-        add(fname, bb_coords, bb_labels, img_size);
-        bb_coords.clear();
-        bb_labels.clear();
+        _store.add_annotation(fname, 0, img_size, box, label);
     }
     file_contents.read(footer_crc, sizeof(data_crc));
     if (!file_contents)
@@ -201,6 +187,16 @@ void TFMetaDataReaderDetection::read_all(const std::string &path) {
     filename_key = _feature_key_map.at(filename_key);
 
     read_files(path);
+    // The parsed boxes are cached next to the record folder, keyed by the record files and the feature keys
+    std::vector<std::string> record_paths;
+    for (auto &file_name : _file_names)
+        record_paths.push_back(path + file_name);
+    std::sort(record_paths.begin(), record_paths.end());  // readdir() order is not stable across runs
+    std::string cache_options = "TFDetection " + label_key + " " + xmin_key + " " + ymin_key + " " + xmax_key + " " + ymax_key + " " + filename_key;
+    std::string cache_path = FlatMetaDataStore::cache_path(path);
+    uint64_t source_key = FlatMetaDataStore::source_key(record_paths, cache_options);
+    if (_store.load(cache_path, source_key))
+        return;
     for (unsigned i = 0; i < _file_names.size(); i++) {
         std::string fname = path + _file_names[i];
         uint length;
@@ -215,6 +211,8 @@ void TFMetaDataReaderDetection::read_all(const std::string &path) {
         _last_rec = false;
         file_contents.close();
     }
+    _store.finalize();
+    _store.save(cache_path, source_key);
     // google::protobuf::ShutdownProtobufLibrary();
     // print_map_contents();
 }
@@ -224,10 +222,12 @@ void TFMetaDataReaderDetection::release(std::string _image_name) {
         WRN("ERROR: Given not present in the map" + _image_name);
         return;
     }
+    _store.erase(_image_name);
     _map_content.erase(_image_name);
 }
 
 void TFMetaDataReaderDetection::release() {
+    _store.clear();
     _map_content.clear();
 }
 
@@ -22,7 +22,7 @@ THE SOFTWARE.
 
 #ifdef ENABLE_WDS
 #include "meta_data/webdataset_meta_data_reader.h"
-#include <cassert>
+#include <thread>
 #include "pipeline/commons.h"
 #include "pipeline/exception.h"
 
@@ -34,17 +34,9 @@ inline bool isJPEG(const std::string &ext) {
     return lowerExt == "jpg" || lowerExt == "jpeg" || lowerExt == "jpe";
 }
 
-constexpr int create_version_number(int major, int minor, int patch = 0) {
-    if (major < 0 || minor < 0 || patch < 0) {
-        return -1;
-    }
-    return major * 1000 + minor * 10 + patch;
-}
-
 void WebDataSetMetaDataReader::init(const MetaDataConfig &cfg,
                                     pMetaDataBatch meta_data_batch) {
     _paths = cfg.path();
-    _wds_shards.reserve(_paths.size());
     _index_paths = cfg.index_path();
     _exts = cfg.exts();
     std::vector<std::string> elementsToRemove = {"jpg", "jpeg", "JPEG", "jpe"};
@@ -64,12 +56,6 @@ bool WebDataSetMetaDataReader::exists(const std::string &image_name) {
     return _map_content.find(image_name) != _map_content.end();
 }
 
-inline std::tuple<std::string, std::string>
-split_name(const std::string &file_path) {
-    size_t dot_pos = file_path.find('.', file_path.rfind('/') + 1);
-    return {file_path.substr(0, dot_pos), file_path.substr(dot_pos + 1)};
-}
-
 void WebDataSetMetaDataReader::add(std::string image_name,
                                    AsciiValues ascii_value) {
     pMetaDataAscii info = std::make_shared<AsciiValue>(ascii_value);
@@ -128,162 +114,6 @@ void WebDataSetMetaDataReader::lookup(
     }
 }
 
-void WebDataSetMetaDataReader::parse_sample_description(
-    std::vector<SampleDescription> &samples_container,
-    std::vector<ComponentDescription> &components_container,
-    std::ifstream &index_file, const std::string &index_path, int64_t line,
-    int index_version) {
-    samples_container.emplace_back();
-    samples_container.back().components = VectorView<ComponentDescription>(
-        components_container, components_container.size());
-    samples_container.back().line_number = line;
-
-    // Getting the components data
-    std::string components_metadata;
-    std::getline(index_file, components_metadata);
-    std::stringstream components_stream(components_metadata);
-
-    // Reading consecutive components
-    ComponentDescription component;
-    while (components_stream >> component.ext) {
-        if (index_version == create_version_number(1, 0)) {
-            if (!(components_stream >> component.offset >> component.size >>
-                  component.filename)) {
-                THROW(
-                    "Could not find all necessary component parameters "
-                    "(offset, size or filename). Every record in the index "
-                    "file should look like: `<ext> <offset> <size> "
-                    "<filename>`.");
-            }
-        } else {
-            if (!(components_stream >> component.offset >> component.size))
-                THROW(
-                    "Could not find all necessary component parameters "
-                    "(offset or size). Every record in the index file should "
-                    "look like: `<ext> <offset> <size>`");
-        }
-
-        if (component.filename.empty())  // Use line number as file number
-            component.filename = std::to_string(line);
-        else {
-            // Find the position of the last period
-            auto last_period_pos = component.filename.find_last_of('.');
-            // If a period is found, truncate everything after it
-            if (last_period_pos != std::string::npos) {
-                component.filename.erase(last_period_pos);
-            }
-        }
-
-        if (!(component.offset % kBlockSize == 0))
-            THROW(
-                "tar offset is not a multiple of tar block size kBlockSize, "
-                "perhaps the size value is exported before offset?");
-
-        components_container.emplace_back(std::move(component));
-        samples_container.back().components.num++;
-    }
-
-    if ((!samples_container.back().components.num))
-        THROW("No extensions provided for the sample");
-}
-
-inline int parse_index_version(const string& idx_version_in_str) {
-  const char* c_string_ptr = idx_version_in_str.c_str();
-  assert(*c_string_ptr == 'v');
-  c_string_ptr++;
-  auto major = atoi(c_string_ptr);
-  c_string_ptr = strchr(c_string_ptr, '.');
-  assert(c_string_ptr);
-  c_string_ptr++;
-  auto minor = atoi(c_string_ptr);
-  return create_version_number(major, minor);
-}
-
-void WebDataSetMetaDataReader::parse_index_files(
-    std::vector<SampleDescription> &samples_container,
-    std::vector<ComponentDescription> &components_container,
-    const std::string &index_path) {
-    std::ifstream index_file(index_path);
-    std::string global_meta;
-    getline(index_file, global_meta);
-    std::stringstream global_meta_stream(global_meta);
-    std::string index_version_str;
-    if (!(global_meta_stream >> index_version_str))
-        THROW("Unsupported version of the index file")
-
-    int index_version = parse_index_version(index_version_str);
-
-    int64_t sample_desc_num_signed;
-    if (!(global_meta_stream >> sample_desc_num_signed))
-        THROW("no sample count found")
-    if (!(sample_desc_num_signed > 0))
-        THROW("sample count must be positive")
-
-    const size_t sample_desc_num = sample_desc_num_signed;
-    samples_container.reserve(samples_container.size() + sample_desc_num);
-    for (size_t sample_index = 0; sample_index < sample_desc_num;
-         sample_index++) {
-        parse_sample_description(samples_container, components_container, index_file, index_path, sample_index + 1, index_version);
-    }
-}
-
-void WebDataSetMetaDataReader::parse_tar_files(
-    std::vector<SampleDescription> &samples_container,
-    std::vector<ComponentDescription> &components_container,
-    std::unique_ptr<std::ifstream> &tar_file) {
-    TarArchive tar_archive(std::move(tar_file));
-
-    std::string last_filename;
-    for (; !tar_archive.at_end_of_archive();
-         tar_archive.advance_to_next_file_in_tar()) {
-        if (tar_archive.get_current_file_type() == TarArchive::ENTRY_FILE) {
-            std::tie(last_filename, std::ignore) =
-                split_name(tar_archive.get_current_file_name());
-            break;
-        }
-    }
-    size_t last_components_size = components_container.size();
-    for (; !tar_archive.at_end_of_archive();
-         tar_archive.advance_to_next_file_in_tar()) {
-        if (tar_archive.get_current_file_type() != TarArchive::ENTRY_FILE) {
-            continue;
-        }
-
-        std::string basename, ext;
-        std::tie(basename, ext) = split_name(tar_archive.get_current_file_name());
-        if (basename.empty()) {
-            continue;
-        }
-
-        if (basename != last_filename) {
-            samples_container.emplace_back();
-            samples_container.back().components =
-                VectorView<ComponentDescription>(
-                    components_container, last_components_size,
-                    components_container.size() - last_components_size);
-            last_filename = basename;
-            last_components_size = components_container.size();
-        }
-
-        components_container.emplace_back();
-        components_container.back().size = tar_archive.get_current_file_size();
-        components_container.back().offset = tar_archive.get_current_archive_offset() + tar_archive.get_current_header_size();
-        components_container.back().ext = std::move(ext);
-        auto _last_id = basename;
-        auto last_slash_idx = _last_id.find_last_of("\\/");
-        if (std::string::npos != last_slash_idx) {
-            _last_id.erase(0, last_slash_idx + 1);
-        }
-        components_container.back().filename = _last_id;
-    }
-    samples_container.emplace_back();
-    samples_container.back().components = VectorView<ComponentDescription>(
-        components_container, last_components_size,
-        components_container.size() - last_components_size);
-
-    tar_file = tar_archive.release_file_stream();
-}
-
 void WebDataSetMetaDataReader::read_all(const std::string &folder_path) {
     uint ext_idx = 0;
     for (size_t output_index = 0; output_index < _exts.size(); output_index++) {
@@ -293,104 +123,53 @@ void WebDataSetMetaDataReader::read_all(const std::string &folder_path) {
         }
     }
 
-    std::string _folder_path;
-    std::string _full_path;
     std::vector<std::string> entry_name_list;
-    if (_index_paths.size() == 0) {
-        _folder_path = _paths;
-        if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
-            THROW("ERROR: Failed opening the directory at " + _folder_path);
-        _full_path = _folder_path;
+    auto list_folder = [this](const std::string &path, std::vector<std::string> &names) {
+        if ((_sub_dir = opendir(path.c_str())) == nullptr)
+            THROW("WebDatasetSourceReader :: ERROR: Failed opening the directory at " + path);
         while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
             if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
                 continue;
-            entry_name_list.push_back(entry_name);
+            names.push_back(_entity->d_name);
         }
-        std::sort(entry_name_list.begin(), entry_name_list.end());
-        _wds_shards.reserve(entry_name_list.size());
-        // Create n such std-streams for n paths
-        for (auto &path : entry_name_list)
-            _wds_shards.emplace_back(std::make_unique<std::ifstream>( folder_path + path, std::ios::binary));
-    } else {
-        _folder_path = _index_paths;
-        if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
-            THROW(
-                "WebDatasetSourceReader :: ERROR: Failed opening the "
-                "directory at " +
-                _folder_path);
-        _full_path = _folder_path;
-        while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
-            if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
-                continue;
-            _index_name_list.push_back(entry_name);
-        }
-        std::sort(_index_name_list.begin(), _index_name_list.end());
-        if ((_sub_dir = opendir( folder_path.c_str())) == nullptr)
-            THROW(
-                "WebDatasetSourceReader :: ERROR: Failed opening the "
-                "directory at " +
-                 folder_path);
-        _full_path =  folder_path;
-        while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
-            if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
-                continue;
-            entry_name_list.push_back(entry_name);
-        }
-        std::sort(entry_name_list.begin(), entry_name_list.end());
-        _wds_shards.reserve(entry_name_list.size());
-        for (auto &path : entry_name_list)
-            _wds_shards.emplace_back(std::make_unique<std::ifstream>( folder_path + path, std::ios::binary));
-    }
-    closedir(_sub_dir);
-
-    std::vector<SampleDescription> unfiltered_samples;
-    std::vector<ComponentDescription> unfiltered_components;
-
-    for (unsigned wds_shard_index = 0; wds_shard_index < entry_name_list.size();
-         ++wds_shard_index) {
-        unfiltered_samples.resize(0);
-        unfiltered_components.resize(0);
+        closedir(_sub_dir);
+        _sub_dir = nullptr;
+        std::sort(names.begin(), names.end());
+    };
+    if (_index_paths.size() != 0)
+        list_folder(_index_paths, _index_name_list);
+    list_folder(_index_paths.size() == 0 ? _paths : folder_path, entry_name_list);
+    if (_index_paths.size() != 0 && _index_name_list.size() < entry_name_list.size())
+        THROW("ERROR: Found " + TOSTR(_index_name_list.size()) + " index files for " + TOSTR(entry_name_list.size()) + " tar files");
+
+    // Every tar file is parsed and has its components read by one job, the tar file is only open for the duration of the job
+    std::vector<std::vector<std::pair<std::string, AsciiValues>>> shard_contents(entry_name_list.size());
+    auto read_tar_file_contents = [&](unsigned wds_shard_index) {
+        std::vector<SampleDescription> unfiltered_samples;
+        std::vector<ComponentDescription> unfiltered_components;
         if (_index_paths.size() == 0)
-            parse_tar_files(unfiltered_samples, unfiltered_components,
-                            _wds_shards[wds_shard_index]);
+            parse_tar_file(folder_path + entry_name_list[wds_shard_index], unfiltered_samples, unfiltered_components);
         else
-            parse_index_files(unfiltered_samples, unfiltered_components,
-                              _folder_path + _index_name_list[wds_shard_index]);
+            parse_index_file(_index_paths + _index_name_list[wds_shard_index], unfiltered_samples, unfiltered_components);
+        std::ifstream tar_file(folder_path + entry_name_list[wds_shard_index], std::ios::binary);
+        if (!tar_file.is_open())
+            THROW("ERROR: Failed to open the tar file " + folder_path + entry_name_list[wds_shard_index]);
 
-        // After parsing add the contents to the map
         for (auto &sample : unfiltered_samples) {
-            if (_missing_component_behaviour == MissingComponentsBehaviour::MISSING_COMPONENT_EMPTY) {  // empty_outputs
-                AsciiValues ascii_values;
-                ascii_values.resize(_ext_map.size());
-                std::string last_file_name;
-                for (auto &component : sample.components) {
-                    if (!isJPEG(component.ext)) {  // Add more components as we encounter
-                        _wds_shards[wds_shard_index]->seekg(component.offset, std::ios::beg);
-                        AsciiComponent ascii_component = std::make_shared<std::vector<uint8_t>>(component.size);
-                        _wds_shards[wds_shard_index]->read(reinterpret_cast<char*>(ascii_component->data()), component.size);
-                        ascii_values.at(_ext_map[component.ext]) = ascii_component;
-                    }
-                    last_file_name = component.filename;
+            AsciiValues ascii_values;
+            ascii_values.resize(_ext_map.size());
+            std::string last_file_name;
+            for (auto &component : sample.components) {
+                if (!isJPEG(component.ext)) {  // Add more components as we encounter
+                    tar_file.seekg(component.offset, std::ios::beg);
+                    AsciiComponent ascii_component = std::make_shared<std::vector<uint8_t>>(component.size);
+                    tar_file.read(reinterpret_cast<char*>(ascii_component->data()), component.size);
+                    ascii_values.at(_ext_map[component.ext]) = ascii_component;
                 }
-                add(last_file_name, ascii_values);
-                ascii_values.clear();
-            } else {
+                last_file_name = component.filename;
+            }
+            if (_missing_component_behaviour != MissingComponentsBehaviour::MISSING_COMPONENT_EMPTY) {  // empty_outputs keeps the samples with missing components
                 auto skip_sample = false;
-                AsciiValues ascii_values;
-                ascii_values.resize(_ext_map.size());
-                std::string last_file_name;
-                for (auto &component : sample.components) {
-                    if (!isJPEG(component.ext)) {  // Add more components as we encounter
-                        _wds_shards[wds_shard_index]->seekg(component.offset, std::ios::beg);
-                        AsciiComponent ascii_component = std::make_shared<std::vector<uint8_t>>(component.size);
-                        _wds_shards[wds_shard_index]->read(reinterpret_cast<char*>(ascii_component->data()), component.size);
-                        ascii_values.at(_ext_map[component.ext]) = ascii_component;
-                    }
-                    last_file_name = component.filename;
-                }
                 for (auto &ascii_component : ascii_values) {
                     if (ascii_component == nullptr) {
                         if (_missing_component_behaviour == MissingComponentsBehaviour::MISSING_COMPONENT_SKIP) {  // skipping sample
@@ -401,10 +180,24 @@ void WebDataSetMetaDataReader::read_all(const std::string &folder_path) {
                         }
                     }
                 }
-                if (skip_sample == false)
-                    add(last_file_name, ascii_values);
+                if (skip_sample)
+                    continue;
             }
+            shard_contents[wds_shard_index].emplace_back(std::move(last_file_name), std::move(ascii_values));
         }
+    };
+    {
+        size_t num_threads = std::max<size_t>(std::min<size_t>(std::thread::hardware_concurrency(), entry_name_list.size()), 1);
+        ThreadPool read_pool(num_threads);
+        std::vector<std::shared_future<void>> read_jobs;
+        for (unsigned wds_shard_index = 0; wds_shard_index < entry_name_list.size(); ++wds_shard_index)
+            read_jobs.push_back(read_pool.submit([&, wds_shard_index]() { read_tar_file_contents(wds_shard_index); }));
+        for (auto &job : read_jobs)
+            job.get();
     }
+    // After parsing add the contents to the map, in the order of the tar files
+    for (auto &contents : shard_contents)
+        for (auto &content : contents)
+            add(content.first, content.second);
 }
 #endif
@@ -116,6 +116,8 @@ void ParameterFactory::set_seed(unsigned seed) {
     _seed_vector.resize(MAX_SEEDS);
     std::seed_seq ss{seed};
     ss.generate(_seed_vector.begin(), _seed_vector.end());
+    // The parameters created after setting a seed get the same seeds in every pipeline
+    _seed_sequence_idx = 0;
 }
 
 IntParam* ParameterFactory::create_uniform_int_rand_param(int start, int end) {
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/cpu_features.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+#include "pipeline/log.h"
+
+CpuIsaLevel cpu_detected_isa_level() {
+    static const CpuIsaLevel level = [] {
+#if SIMD_X86
+        // __builtin_cpu_supports also checks that the OS saves the AVX registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return CpuIsaLevel::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return CpuIsaLevel::AVX2;
+        if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("ssse3"))
+            return CpuIsaLevel::SSE42;
+#endif
+        return CpuIsaLevel::SCALAR;
+    }();
+    return level;
+}
+
+static CpuIsaLevel select_isa_level() {
+    CpuIsaLevel level = cpu_detected_isa_level();
+    const char *env = std::getenv("ROCAL_CPU_ISA");
+    if (env && *env) {
+        std::string requested(env);
+        std::transform(requested.begin(), requested.end(), requested.begin(), [](unsigned char c) { return std::tolower(c); });
+        CpuIsaLevel override_level;
+        if (requested == "scalar") {
+            override_level = CpuIsaLevel::SCALAR;
+        } else if (requested == "sse4.2" || requested == "sse42") {
+            override_level = CpuIsaLevel::SSE42;
+        } else if (requested == "avx2") {
+            override_level = CpuIsaLevel::AVX2;
+        } else if (requested == "avx512") {
+            override_level = CpuIsaLevel::AVX512;
+        } else {
+            WRN("Unknown ROCAL_CPU_ISA value " + requested + ", expected scalar, sse4.2, avx2 or avx512")
+            override_level = level;
+        }
+        if (override_level > level) {
+            WRN("ROCAL_CPU_ISA " + requested + " is not supported by the CPU, using " + cpu_isa_name(level))
+        } else {
+            level = override_level;
+        }
+    }
+    INFO("SIMD kernels selected for " + std::string(cpu_isa_name(level)))
+    return level;
+}
+
+CpuIsaLevel cpu_isa_level() {
+    static const CpuIsaLevel level = select_isa_level();
+    return level;
+}
+
+const char *cpu_isa_name(CpuIsaLevel level) {
+    switch (level) {
+        case CpuIsaLevel::AVX512:
+            return "avx512";
+        case CpuIsaLevel::AVX2:
+            return "avx2";
+        case CpuIsaLevel::SSE42:
+            return "sse4.2";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/cpu_scheduler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "pipeline/log.h"
+
+CpuScheduler &CpuScheduler::instance() {
+    static CpuScheduler scheduler;
+    return scheduler;
+}
+
+size_t CpuScheduler::default_core_count() {
+    const unsigned minimum_cpu_thread_count = 2;
+    const unsigned default_smt_count = 2;
+    unsigned thread_count = std::thread::hardware_concurrency();
+    if (thread_count < minimum_cpu_thread_count) {
+        thread_count = minimum_cpu_thread_count;
+        WRN("hardware_concurrency() call failed, assuming rocAL can run " + TOSTR(thread_count) + " threads")
+    }
+    return thread_count / default_smt_count;
+}
+
+void CpuScheduler::set_core_budget(size_t core_budget) {
+    std::unique_lock<std::mutex> lock(_lock);
+    _core_budget = core_budget;
+}
+
+size_t CpuScheduler::core_budget() {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (_core_budget == 0)
+        _core_budget = default_core_count();
+    return _core_budget;
+}
+
+std::shared_ptr<ThreadPool> CpuScheduler::acquire_pool(const std::vector<unsigned> &cpu_ids) {
+    auto budget = core_budget();
+    std::unique_lock<std::mutex> lock(_lock);
+    auto &shared_pool = _pools[cpu_ids];
+    if (!shared_pool.pool) {
+        size_t num_threads = cpu_ids.empty() ? budget : std::min(budget, cpu_ids.size());
+        shared_pool.pool = std::make_shared<ThreadPool>(num_threads, cpu_ids);
+        LOG("Created a pool of " + TOSTR(num_threads) + " CPU worker threads")
+    }
+    shared_pool.pipelines++;
+    return shared_pool.pool;
+}
+
+void CpuScheduler::release_pool(const std::vector<unsigned> &cpu_ids) {
+    std::unique_lock<std::mutex> lock(_lock);
+    auto it = _pools.find(cpu_ids);
+    if (it == _pools.end())
+        return;
+    // The loaders may still hold the pool, the workers exit once the last of them releases it
+    if (--it->second.pipelines == 0)
+        _pools.erase(it);
+}
+
+size_t CpuScheduler::pipeline_thread_share(const std::vector<unsigned> &cpu_ids) {
+    std::unique_lock<std::mutex> lock(_lock);
+    auto it = _pools.find(cpu_ids);
+    if (it == _pools.end() || it->second.pipelines == 0)
+        return 1;
+    return std::max<size_t>(it->second.pool->num_threads() / it->second.pipelines, 1);
+}
+
+std::vector<unsigned> CpuScheduler::numa_node_cpus(int numa_node) {
+    std::vector<unsigned> cpu_ids;
+    if (numa_node < 0)
+        return cpu_ids;
+    // The list has the form "0-7,16-23"
+    std::ifstream cpu_list("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string range;
+    while (std::getline(cpu_list, range, ',')) {
+        unsigned first, last;
+        char dash;
+        std::istringstream range_stream(range);
+        if (!(range_stream >> first))
+            continue;
+        last = (range_stream >> dash >> last) ? last : first;
+        for (unsigned cpu_id = first; cpu_id <= last; cpu_id++)
+            cpu_ids.push_back(cpu_id);
+    }
+    return cpu_ids;
+}
@@ -27,8 +27,12 @@ THE SOFTWARE.
 #include <VX/vx_types.h>
 #include <cstring>
 #include <sched.h>
+#if !defined(WIN32) && !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 #include <half/half.hpp>
 #include "pipeline/master_graph.h"
+#include "pipeline/tensor_conversion.h"
 #include "parameters/parameter_factory.h"
 #include "device/ocl_setup.h"
 #include "pipeline/log.h"
@@ -36,6 +40,7 @@ THE SOFTWARE.
 #include "meta_data/meta_data_graph_factory.h"
 #include "meta_data/randombboxcrop_meta_data_reader_factory.h"
 #include "augmentations/node_copy.h"
+#include "augmentations/geometry_augmentations/node_resize.h"
 
 using half_float::half;
 
@@ -94,12 +99,15 @@ std::vector<std::vector<float>> &operator+=(std::vector<std::vector<float>> &des
 
 MasterGraph::~MasterGraph() {
     release();
+    _cpu_pool = nullptr;
+    CpuScheduler::instance().release_pool(_cpu_affinity);
 }
 
-MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type) : _ring_buffer(prefetch_queue_depth),
+MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type, bool deterministic_loader_order, const std::vector<unsigned> &cpu_affinity) : _ring_buffer(prefetch_queue_depth),
                                                                                                                                                                                      _graph(nullptr),
                                                                                                                                                                                      _affinity(affinity),
                                                                                                                                                                                      _cpu_num_threads(cpu_thread_count),
+                                                                                                                                                                                     _cpu_affinity(cpu_affinity),
                                                                                                                                                                                      _gpu_id(gpu_id),
                                                                                                                                                                                      _convert_time("Conversion Time", DBG_TIMING),
                                                                                                                                                                                      _process_time("Process Time", DBG_TIMING),
@@ -115,6 +123,7 @@ MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_t
                                                                                                                                                                                      _first_run(true),
                                                                                                                                                                                      _processing(false),
                                                                                                                                                                                      _prefetch_queue_depth(prefetch_queue_depth),
+                                                                                                                                                                                     _deterministic_loader_order(deterministic_loader_order),
 #if ENABLE_HIP
                                                                                                                                                                                      _box_encoder_gpu(nullptr),
 #endif
@@ -189,6 +198,7 @@ MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_t
         release();
         throw;
     }
+    _cpu_pool = CpuScheduler::instance().acquire_pool(_cpu_affinity);
 }
 
 MasterGraph::Status
@@ -231,15 +241,9 @@ void MasterGraph::decrease_image_count() {
 size_t
 MasterGraph::calculate_cpu_num_threads(size_t shard_count) {
     if (_cpu_num_threads <= 0) {
-        const unsigned minimum_cpu_thread_count = 2;
-        const unsigned default_smt_count = 2;
-        unsigned thread_count = std::thread::hardware_concurrency();
-        if (thread_count < minimum_cpu_thread_count) {
-            thread_count = minimum_cpu_thread_count;
-            WRN("hardware_concurrency() call failed, assuming rocAL can run " + TOSTR(thread_count) + " threads")
-        }
-        size_t core_count = thread_count / default_smt_count;
-        _cpu_num_threads = core_count / shard_count;
+        // The pipelines sharing the CPUs split the core budget of the process between them
+        size_t core_count = CpuScheduler::instance().pipeline_thread_share(_cpu_affinity);
+        _cpu_num_threads = std::max<size_t>(core_count / shard_count, 1);
     }
     // Use _cpu_num_threads if user has already passed non-negative num_threads
     return _cpu_num_threads;
@@ -247,7 +251,7 @@ MasterGraph::calculate_cpu_num_threads(size_t shard_count) {
 
 void MasterGraph::create_single_graph() {
     // Actual graph creating and calls into adding nodes to graph is deferred and is happening here to enable potential future optimizations
-    _graph = std::make_shared<Graph>(_context, _affinity, 0, _cpu_num_threads, _gpu_id);
+    _graph = std::make_shared<Graph>(_context, _affinity, 0, calculate_cpu_num_threads(1), _gpu_id);
     for (auto &node : _nodes) {
         // Any tensor not yet created can be created as virtual tensor
         for (auto &tensor : node->output())
@@ -264,7 +268,7 @@ void MasterGraph::create_multiple_graphs() {
     // Actual graph creating and calls into adding nodes to graph is deferred and is happening here to enable potential future optimizations
     // Creating a Graph instance for every loader module in the pipeline
     for (unsigned n = 0; n < _loaders_count; n++) {
-        _graphs.emplace_back(std::make_shared<Graph>(_context, _affinity, 0, _cpu_num_threads, _gpu_id));
+        _graphs.emplace_back(std::make_shared<Graph>(_context, _affinity, 0, calculate_cpu_num_threads(1), _gpu_id));
     }
     for (auto &node : _nodes) {
         // Any tensor not yet created can be created as virtual tensor
@@ -303,10 +307,32 @@ MasterGraph::build() {
         _loader_module = _loader_modules[0];
         create_single_graph();
     }
+    set_decode_size_hints();
     start_processing();
     return Status::OK;
 }
 
+void MasterGraph::set_decode_size_hints() {
+    // Loaders only feeding resize nodes can decode down to the largest resize output, the decoders supporting it scale in the DCT domain
+    // The batches prefetched while the graph was built are decoded before the hint is set
+    auto loader_module = _loader_modules.begin();
+    for (auto &root_node : _root_nodes) {
+        size_t width = 0, height = 0;
+        for (auto &next_node : root_node->next()) {
+            if (!std::dynamic_pointer_cast<ResizeNode>(next_node)) {
+                width = height = 0;
+                break;
+            }
+            auto max_shape = next_node->output()[0]->info().max_shape();
+            width = std::max(width, max_shape[0]);
+            height = std::max(height, max_shape[1]);
+        }
+        if (width && height)
+            (*loader_module)->set_decode_size_hint(width, height);
+        ++loader_module;
+    }
+}
+
 Tensor *
 MasterGraph::create_loader_output_tensor(const TensorInfo &info) {
     /*
@@ -449,9 +475,11 @@ MasterGraph::Status
 MasterGraph::reset() {
     // stop the internal processing thread so that the
     _processing = false;
+    wake_output_routine();
     _ring_buffer.unblock_writer();
     if (_output_thread.joinable())
         _output_thread.join();
+    stop_box_encode_stage();
     _ring_buffer.reset();
     _sequence_start_framenum_vec.clear();
     _sequence_frame_timestamps_vec.clear();
@@ -497,11 +525,27 @@ MasterGraph::timing() {
         Timing loader_time = loader_module->timing();
         t.decode_time += loader_time.decode_time;
         t.read_time += loader_time.read_time;
+        t.file_read_time += loader_time.file_read_time;
+        t.read_wait_time += loader_time.read_wait_time;
         t.process_time += loader_time.process_time;
+        t.compressed_buffer_size += loader_time.compressed_buffer_size;
     }
+#if !defined(WIN32) && !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        t.peak_rss = static_cast<long long unsigned>(usage.ru_maxrss) * 1024;  // Reported in kilobytes on Linux
+#endif
     t.process_time += _process_time.get_timing();
     t.copy_to_output += _convert_time.get_timing();
     t.bb_process_time += _bencode_time.get_timing();
+    if (_box_encode_queue) {
+        auto stage_stats = _box_encode_queue->stats();
+        t.bb_stage_stall_time += stage_stats.producer_stall_time;
+        t.bb_stage_idle_time += stage_stats.consumer_stall_time;
+        t.bb_stage_max_occupancy = stage_stats.max_occupancy;
+        t.bb_stage_occupancy_sum = stage_stats.occupancy_sum;
+        t.bb_stage_batches = stage_stats.batches;
+    }
     return t;
 }
 
@@ -672,182 +716,27 @@ MasterGraph::to_tensor(void *out_ptr, RocalTensorlayout format, float multiplier
 #endif
     if ((output_tensor_info.mem_type() == RocalMemType::HOST)) {
         if (output_mem_type == RocalOutputMemType::ROCAL_MEMCPY_HOST) {
-            float multiplier[3] = {multiplier0, multiplier1, multiplier2};
-            float offset[3] = {offset0, offset1, offset2};
+            TensorConversionParams params;
+            params.layout = format;
+            params.data_type = output_data_type;
+            params.multiplier[0] = multiplier0, params.multiplier[1] = multiplier1, params.multiplier[2] = multiplier2;
+            params.offset[0] = offset0, params.offset[1] = offset1, params.offset[2] = offset2;
+            params.reverse_channels = reverse_channels;
+            const size_t output_elem_size = (output_data_type == RocalTensorDataType::FP16) ? sizeof(half) : sizeof(float);
             size_t dest_buf_offset_start = 0;
 
             auto output_buffers = _ring_buffer.get_read_buffers().first;
             auto num_threads = _cpu_num_threads * 2;
             for (auto &&out_tensor : output_buffers) {
-                unsigned int single_tensor_size = w * c * h;
-                unsigned int channel_size = max_roi_width * max_roi_height;
-                unsigned int output_single_tensor_size = max_roi_height * max_roi_width * c;
-                unsigned int input_width_stride = w * c;
+                size_t single_tensor_size = w * c * h;
+                size_t output_single_tensor_size = max_roi_height * max_roi_width * c;
 #pragma omp parallel for num_threads(num_threads)
                 for (unsigned int batch_count = 0; batch_count < n; batch_count++) {
                     size_t dest_buf_offset = dest_buf_offset_start + output_single_tensor_size * batch_count;
-                    auto in_buffer = (unsigned char *)out_tensor + single_tensor_size * batch_count;
-
-                    if (format == RocalTensorlayout::NHWC) {
-                        if (output_data_type == RocalTensorDataType::FP32) {
-                            float *output_tensor_32 = static_cast<float *>(out_ptr);
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? static_cast<float>(in_buffer[i * c + c - channel_idx - 1])
-                                                                                    : static_cast<float>(in_buffer[i * c + channel_idx]));
-                            }
-                        } else if (output_data_type == RocalTensorDataType::FP16) {
-                            half *output_tensor_16 = static_cast<half *>(out_ptr);
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_16[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? (half)(in_buffer[i * c + c - channel_idx - 1])
-                                                                                    : (half)(in_buffer[i * c + channel_idx]));
-                            }
-                        }
-                    }
-                    if (format == RocalTensorlayout::NCHW) {
-                        if (output_data_type == RocalTensorDataType::FP32) {
-                            float *output_tensor_32 = static_cast<float *>(out_ptr);
-                            if (c != 3) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + i] = offset[0] + multiplier[0] * static_cast<float>(in_buffer[c * i]);
-                            } else {
-#if (ENABLE_SIMD && __AVX2__)
-                                float *B_buf = output_tensor_32 + dest_buf_offset;
-                                float *G_buf = B_buf + channel_size;
-                                float *R_buf = G_buf + channel_size;
-
-                                __m256i mask_B, mask_G, mask_R;
-                                if (reverse_channels) {
-                                    mask_B = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_R = avx_pkdMaskB;
-                                } else {
-                                    mask_R = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_B = avx_pkdMaskB;
-                                }
-                                __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                                __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                                __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                                __m256 padd0 = _mm256_set1_ps(offset0);
-                                __m256 padd1 = _mm256_set1_ps(offset1);
-                                __m256 padd2 = _mm256_set1_ps(offset2);
-                                uint alignedLength = (max_roi_width & ~7);  // multiple of 8
-
-                                __m256 fR, fG, fB;
-                                for (uint row = 0; row < max_roi_height; row++) {
-                                    unsigned char *in_buffer_row = reinterpret_cast<unsigned char *>(in_buffer) + (row * input_width_stride);
-                                    uint col = 0;
-                                    for (; col < alignedLength; col += 8) {
-                                        __m256i pix0 = _mm256_loadu_si256((const __m256i *)in_buffer_row);
-                                        pix0 = _mm256_permutevar8x32_epi32(pix0, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
-                                        fB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_R));
-                                        fG = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_G));
-                                        fR = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_B));
-                                        fB = _mm256_fmadd_ps(fB, pmul0, padd0);
-                                        fG = _mm256_fmadd_ps(fG, pmul1, padd1);
-                                        fR = _mm256_fmadd_ps(fR, pmul2, padd2);
-                                        _mm256_storeu_ps(B_buf, fB);
-                                        _mm256_storeu_ps(G_buf, fG);
-                                        _mm256_storeu_ps(R_buf, fR);
-                                        B_buf += 8;
-                                        G_buf += 8;
-                                        R_buf += 8;
-                                        in_buffer_row += 24;
-                                    }
-                                    for (; col < max_roi_width; col++, in_buffer_row += 3) {
-                                        *B_buf++ = (in_buffer_row[0] * multiplier0) + offset0;
-                                        *G_buf++ = (in_buffer_row[1] * multiplier1) + offset1;
-                                        *R_buf++ = (in_buffer_row[2] * multiplier2) + offset1;
-                                    }
-                                }
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] * (reverse_channels ? static_cast<float>(in_buffer[(c * i + c - channel_idx - 1)]) : static_cast<float>(in_buffer[(c * i + channel_idx)]));
-                                }
-#endif
-                            }
-                        } else if (output_data_type == RocalTensorDataType::FP16) {
-                            half *output_tensor_16 = static_cast<half *>(out_ptr);
-                            if (c != 3) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_16[dest_buf_offset + i] = offset[0] + multiplier[0] * (half)in_buffer[c * i];
-                            } else {
-#if (ENABLE_SIMD && __AVX2__)
-                                half *B_buf_16 = output_tensor_16 + dest_buf_offset;
-                                half *G_buf_16 = B_buf_16 + channel_size;
-                                half *R_buf_16 = G_buf_16 + channel_size;
-
-                                __m256i mask_B, mask_G, mask_R;
-                                if (reverse_channels) {
-                                    mask_B = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_R = avx_pkdMaskB;
-                                } else {
-                                    mask_R = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_B = avx_pkdMaskB;
-                                }
-                                __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                                __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                                __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                                __m256 padd0 = _mm256_set1_ps(offset0);
-                                __m256 padd1 = _mm256_set1_ps(offset1);
-                                __m256 padd2 = _mm256_set1_ps(offset2);
-                                uint alignedLength = (max_roi_width & ~7);  // multiple of 8
-
-                                __m256 fR, fG, fB;
-                                __m128i tempR, tempG, tempB;
-                                for (uint row = 0; row < max_roi_height; row++) {
-                                    unsigned char *in_buffer_row = reinterpret_cast<unsigned char *>(in_buffer) + (row * input_width_stride);
-                                    uint col = 0;
-                                    for (; col < alignedLength; col += 8) {
-                                        __m256i pix0 = _mm256_loadu_si256((const __m256i *)in_buffer_row);
-                                        pix0 = _mm256_permutevar8x32_epi32(pix0, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
-                                        fB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_R));
-                                        fG = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_G));
-                                        fR = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_B));
-                                        fB = _mm256_fmadd_ps(fB, pmul0, padd0);
-                                        fG = _mm256_fmadd_ps(fG, pmul1, padd1);
-                                        fR = _mm256_fmadd_ps(fR, pmul2, padd2);
-                                        tempB = _mm256_cvtps_ph(fB, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        tempG = _mm256_cvtps_ph(fG, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        tempR = _mm256_cvtps_ph(fR, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        _mm_storeu_si128((__m128i *)B_buf_16, tempB);
-                                        _mm_storeu_si128((__m128i *)G_buf_16, tempG);
-                                        _mm_storeu_si128((__m128i *)R_buf_16, tempR);
-                                        B_buf_16 += 8;
-                                        G_buf_16 += 8;
-                                        R_buf_16 += 8;
-                                        in_buffer_row += 24;
-                                    }
-                                    for (; col < max_roi_width; col++, in_buffer_row += 3) {
-                                        *B_buf_16++ = (half)(in_buffer_row[0] * multiplier0) + offset0;
-                                        *G_buf_16++ = (half)(in_buffer_row[1] * multiplier1) + offset1;
-                                        *R_buf_16++ = (half)(in_buffer_row[2] * multiplier2) + offset2;
-                                    }
-                                }
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_16[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] *
-                                                                      (reverse_channels ? (half)(in_buffer[(c * i + c - channel_idx - 1)])
-                                                                                        : (half)(in_buffer[(c * i + channel_idx)]));
-                                }
-#endif
-                            }
-                        }
-                    }  // NCHW or NHWC
-                }      // for loop batch
-
+                    auto in_buffer = static_cast<unsigned char *>(out_tensor) + single_tensor_size * batch_count;
+                    convert_interleaved_image(in_buffer, w * c, max_roi_height, max_roi_width, c,
+                                              static_cast<unsigned char *>(out_ptr) + dest_buf_offset * output_elem_size, params);
+                }
                 dest_buf_offset_start += single_output_tensor_size;
             }
         }
@@ -931,13 +820,33 @@ MasterGraph::get_output_tensors() {
     auto read_buffers = _ring_buffer.get_read_buffers();
     auto output_ptr = read_buffers.first;
     auto roi_ptr = read_buffers.second;
+    auto read_slot = _ring_buffer.read_slot();
     for (unsigned i = 0; i < _internal_tensor_list.size(); i++) {
         _output_tensor_list[i]->set_mem_handle(output_ptr[i]);
         _output_tensor_list[i]->set_roi(roi_ptr[i]);
+        _output_tensor_list[i]->set_lease_provider([this, read_slot] { return _ring_buffer.lease(read_slot); });
     }
     return &_output_tensor_list;
 }
 
+void MasterGraph::set_output_buffers(unsigned output_idx, const std::vector<void *> &buffers, size_t buffer_size) {
+    if (output_idx >= _internal_tensor_list.size())
+        THROW("Output buffers given for output " + TOSTR(output_idx) + " of a pipeline with " + TOSTR(_internal_tensor_list.size()) + " outputs")
+    if (buffers.size() != _prefetch_queue_depth)
+        THROW("One output buffer per prefetch queue slot is needed, " + TOSTR(buffers.size()) + " given for a prefetch queue depth of " + TOSTR(_prefetch_queue_depth))
+    auto output_size = _internal_tensor_list[output_idx]->info().data_size();
+    if (buffer_size < output_size)
+        THROW("Output buffers of " + TOSTR(buffer_size) + " bytes are smaller than output " + TOSTR(output_idx) + " of " + TOSTR(output_size) + " bytes")
+    // The graph writes each batch into the buffer of the ring buffer slot it is assigned to, the slot index is the buffer index
+    _ring_buffer.set_external_sub_buffers(output_idx, buffers);
+}
+
+int MasterGraph::output_buffer_index() {
+    if (_first_run || _ring_buffer.empty())
+        return -1;
+    return _ring_buffer.read_slot();
+}
+
 bool MasterGraph::is_out_of_data() {
     // If any of the loader module's remaining count is less than the batch size, return loader out of data
     for (auto& loader_module : _loader_modules) {
@@ -955,15 +864,19 @@ void MasterGraph::output_routine() {
             if (_loader_module->remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)) {
                 // If the internal process routine ,output_routine(), has finished processing all the images, and last
                 // processed images stored in the _ring_buffer will be consumed by the user when it calls the run() func
+                // The batches still in the box encode stage have to reach the ring buffer before the user is told there is nothing left
+                if (_box_encode_queue)
+                    _box_encode_queue->wait_until_drained();
                 notify_user_thread();
                 // the following call is required in case the ring buffer is waiting for more data to be loaded and there is no more data to process.
                 _ring_buffer.release_if_empty();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                wait_for_loader_data();
                 continue;
             }
             _rb_block_if_full_time.start();
-            // _ring_buffer.get_write_buffers() is blocking and blocks here until user uses processed image by calling run() and frees space in the ring_buffer
-            auto write_buffers = _ring_buffer.get_write_buffers();
+            // _ring_buffer.reserve_write_slot() is blocking and blocks here until user uses processed image by calling run() and frees space in the ring_buffer
+            auto write_slot = _ring_buffer.reserve_write_slot();
+            auto write_buffers = _ring_buffer.get_write_buffers(write_slot);
             auto write_output_buffers = write_buffers.first;
             _rb_block_if_full_time.end();
 
@@ -1020,36 +933,72 @@ void MasterGraph::output_routine() {
             auto write_roi_buffers = write_buffers.second;   // Obtain ROI buffers from ring buffer
             for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
                 _internal_tensor_list[idx]->copy_roi(write_roi_buffers[idx]);   // Copy ROI from internal tensor's buffer to ring buffer
-            _bencode_time.start();
-            if (_is_box_encoder) {
-                auto bbox_encode_write_buffers = _ring_buffer.get_box_encode_write_buffers();
-#if ENABLE_HIP
-                if (_mem_type == RocalMemType::HIP) {
-                    // get bbox encoder read buffers
-                    if (_box_encoder_gpu) _box_encoder_gpu->Run(output_meta_data, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
-                } else
-#endif
-                    _meta_data_graph->update_box_encoder_meta_data(&_anchors, output_meta_data, _criteria, _offset, _scale, _means, _stds, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
-            }
-            if (_is_box_iou_matcher) {
-                int *matches_write_buffer = reinterpret_cast<int *>(_ring_buffer.get_meta_write_buffers()[2]);
-                _meta_data_graph->update_box_iou_matcher(_iou_matcher_info, matches_write_buffer, output_meta_data);
-            }
-            _bencode_time.end();
 #ifdef ROCAL_VIDEO
             _sequence_start_framenum_vec.insert(_sequence_start_framenum_vec.begin(), _loader_module->get_sequence_start_frame_number());
             _sequence_frame_timestamps_vec.insert(_sequence_frame_timestamps_vec.begin(), _loader_module->get_sequence_frame_timestamps());
 #endif
-            _ring_buffer.set_meta_data(full_batch_data_names, output_meta_data);
-            _ring_buffer.push();  // The data and metadata is now stored in output the ring_buffer, increases it's level by 1
+            BoxEncodeJob job{write_slot, full_batch_data_names, output_meta_data};
+            if (_box_encode_queue) {
+                // The box encode stage finishes this batch while the next one is loaded and processed
+                _box_encode_queue->push(std::move(job));
+            } else {
+                box_encode_and_push(job);
+            }
         }
     } catch (const std::exception &e) {
         ERR("Exception thrown in the process routine: " + STR(e.what()) + STR("\n"));
         _processing = false;
+        if (_box_encode_queue)
+            _box_encode_queue->close();
         _ring_buffer.release_all_blocked_calls();
     }
 }
 
+void MasterGraph::box_encode_and_push(BoxEncodeJob &job) {
+    _bencode_time.start();
+    if (_is_box_encoder) {
+        auto bbox_encode_write_buffers = _ring_buffer.get_box_encode_write_buffers(job.slot);
+#if ENABLE_HIP
+        if (_mem_type == RocalMemType::HIP) {
+            // get bbox encoder read buffers
+            if (_box_encoder_gpu) _box_encoder_gpu->Run(job.meta_data, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
+        } else
+#endif
+            _meta_data_graph->update_box_encoder_meta_data(_anchor_store, job.meta_data, _criteria, _offset, _scale, _means, _stds, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
+    }
+    if (_is_box_iou_matcher) {
+        int *matches_write_buffer = reinterpret_cast<int *>(_ring_buffer.get_meta_write_buffers(job.slot)[2]);
+        _meta_data_graph->update_box_iou_matcher(_iou_matcher_info, matches_write_buffer, job.meta_data);
+    }
+    _bencode_time.end();
+    _ring_buffer.set_meta_data(std::move(job.names), job.meta_data, job.slot);
+    _ring_buffer.push();  // The data and metadata is now stored in output the ring_buffer, increases it's level by 1
+}
+
+void MasterGraph::box_encode_routine() {
+    INFO("Box encode stage started")
+    try {
+        BoxEncodeJob job;
+        while (_box_encode_queue->pop(job)) {
+            box_encode_and_push(job);
+            _box_encode_queue->task_done();
+        }
+    } catch (const std::exception &e) {
+        ERR("Exception thrown in the box encode stage: " + STR(e.what()) + STR("\n"));
+        _processing = false;
+        _box_encode_queue->close();
+        _ring_buffer.release_all_blocked_calls();
+        wake_output_routine();
+    }
+}
+
+void MasterGraph::stop_box_encode_stage() {
+    if (_box_encode_queue)
+        _box_encode_queue->close();
+    if (_box_encode_thread.joinable())
+        _box_encode_thread.join();
+}
+
 void MasterGraph::output_routine_multiple_loaders() {
     INFO("Output routine for multiple loaders started with " + TOSTR(_remaining_count) + " to load");
     try {
@@ -1060,7 +1009,7 @@ void MasterGraph::output_routine_multiple_loaders() {
                 notify_user_thread();
                 // the following call is required in case the ring buffer is waiting for more data to be loaded and there is no more data to process.
                 _ring_buffer.release_if_empty();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                wait_for_loader_data();
                 continue;
             }
             _rb_block_if_full_time.start();
@@ -1108,16 +1057,29 @@ void MasterGraph::output_routine_multiple_loaders() {
 
 void MasterGraph::start_processing() {
     _processing = true;
+    _output_routine_woken = false;  // The output thread is not running yet, any wake up issued before the restart is stale
     _remaining_count = _loader_modules[0]->remaining_count();
     for (int i = 1; i < _loaders_count; i++) {
         // Stores the least remaining count value of all loaders
         _remaining_count = std::min(_remaining_count, static_cast<int>(_loader_modules[i]->remaining_count()));
     }
     if (_loaders_count == 1) {
+        // CPU box encoding / IoU matching runs as a separate stage so that it overlaps with the graph processing of the next batch
+        bool cpu_box_encode = (_is_box_encoder && _mem_type == RocalMemType::HOST) || _is_box_iou_matcher;
+        if (cpu_box_encode) {
+            if (!_box_encode_queue)
+                _box_encode_queue = std::make_unique<PipelineStageQueue<BoxEncodeJob>>("Box encode", BOX_ENCODE_STAGE_DEPTH);
+            else
+                _box_encode_queue->reopen();
+            _box_encode_thread = std::thread(&MasterGraph::box_encode_routine, this);
+            ThreadPool::set_thread_affinity(_box_encode_thread, _cpu_affinity);
+        }
         _output_thread = std::thread(&MasterGraph::output_routine, this);
     } else {
         _output_thread = std::thread(&MasterGraph::output_routine_multiple_loaders, this);
     }
+    // The OpenMP threads the graph processing starts from this thread inherit its affinity
+    ThreadPool::set_thread_affinity(_output_thread, _cpu_affinity);
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #else
 //  Changing thread scheduling policy and it's priority does not help on latest Ubuntu builds
@@ -1135,10 +1097,12 @@ void MasterGraph::start_processing() {
 
 void MasterGraph::stop_processing() {
     _processing = false;
+    wake_output_routine();
     _ring_buffer.unblock_reader();
     _ring_buffer.unblock_writer();
     if (_output_thread.joinable())
         _output_thread.join();
+    stop_box_encode_stage();
 }
 
 TensorListVector* MasterGraph::create_coco_meta_data_reader(const char *source_path, bool is_output, MetaDataReaderType reader_type, MetaDataType metadata_type, bool ltrb_bbox, bool is_box_encoder, bool avoid_class_remapping, bool aspect_ratio_grouping, bool is_box_iou_matcher, float sigma, unsigned pose_output_width, unsigned pose_output_height) {
@@ -1153,6 +1117,7 @@ TensorListVector* MasterGraph::create_coco_meta_data_reader(const char *source_p
     config.set_out_img_width(pose_output_width);
     config.set_out_img_height(pose_output_height);
     _meta_data_graph = create_meta_data_graph(config);
+    _meta_data_graph->set_cpu_pool(_cpu_pool);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
     if (!ltrb_bbox) _augmented_meta_data->set_xywh_bbox();
@@ -1218,6 +1183,7 @@ TensorListVector* MasterGraph::create_tf_record_meta_data_reader(const char *sou
 
     MetaDataConfig config(label_type, reader_type, source_path, feature_key_map);
     _meta_data_graph = create_meta_data_graph(config);
+    _meta_data_graph->set_cpu_pool(_cpu_pool);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
 
@@ -1362,6 +1328,7 @@ TensorListVector* MasterGraph::create_mxnet_label_reader(const char *source_path
 
     MetaDataConfig config(MetaDataType::Label, MetaDataReaderType::MXNET_META_DATA_READER, source_path);
     _meta_data_graph = create_meta_data_graph(config);
+    _meta_data_graph->set_cpu_pool(_cpu_pool);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
     std::vector<size_t> dims = {1};
@@ -1405,6 +1372,7 @@ void MasterGraph::box_encoder(std::vector<float> &anchors, float criteria, const
 #endif
     _offset = offset;
     _anchors = anchors;
+    _anchor_store.init(_anchors);
     _scale = scale;
     _means = means;
     _stds = stds;
@@ -1418,6 +1386,7 @@ TensorListVector* MasterGraph::create_caffe2_lmdb_record_meta_data_reader(const
 
     MetaDataConfig config(label_type, reader_type, source_path);
     _meta_data_graph = create_meta_data_graph(config);
+    _meta_data_graph->set_cpu_pool(_cpu_pool);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
     if (reader_type == MetaDataReaderType::CAFFE2_META_DATA_READER) {
@@ -1466,6 +1435,7 @@ TensorListVector* MasterGraph::create_caffe_lmdb_record_meta_data_reader(const c
 
     MetaDataConfig config(label_type, reader_type, source_path);
     _meta_data_graph = create_meta_data_graph(config);
+    _meta_data_graph->set_cpu_pool(_cpu_pool);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
     if (reader_type == MetaDataReaderType::CAFFE_META_DATA_READER) {
@@ -1543,7 +1513,8 @@ void MasterGraph::box_iou_matcher(std::vector<float> &anchors,
     if (!_is_box_iou_matcher)
         THROW("Box IOU matcher variable not set cannot return matched idx")
     _anchors = anchors;                     // Uses existing _anchors variable used for box encoder
-    _iou_matcher_info.anchors = &_anchors;
+    _anchor_store.init(_anchors);
+    _iou_matcher_info.anchors = &_anchor_store;
     _iou_matcher_info.high_threshold = high_threshold;
     _iou_matcher_info.low_threshold = low_threshold;
     _iou_matcher_info.allow_low_quality_matches = allow_low_quality_matches;
@@ -1567,7 +1538,7 @@ TensorList *MasterGraph::labels_meta_data() {
     if (_ring_buffer.level() == 0)
         THROW("No meta data has been loaded")
     auto meta_data_buffers = (unsigned char *)_ring_buffer.get_meta_read_buffers()[0];  // Get labels buffer from ring buffer
-    auto labels = _ring_buffer.get_meta_data().second->get_labels_batch();
+    auto &labels = _ring_buffer.get_meta_data().second->read_labels_batch();
     for (unsigned i = 0; i < _labels_tensor_list.size(); i++) {
         _labels_tensor_list[i]->set_dims({labels[i].size()});
         _labels_tensor_list[i]->set_mem_handle((void *)meta_data_buffers);
@@ -1610,7 +1581,7 @@ TensorList *MasterGraph::bbox_meta_data() {
     if (_ring_buffer.level() == 0)
         THROW("No meta data has been loaded")
     auto meta_data_buffers = (unsigned char *)_ring_buffer.get_meta_read_buffers()[1];  // Get bbox buffer from ring buffer
-    auto bbox_cords = _ring_buffer.get_meta_data().second->get_bb_cords_batch();
+    auto &bbox_cords = _ring_buffer.get_meta_data().second->read_bb_cords_batch();
     for (unsigned i = 0; i < _bbox_tensor_list.size(); i++) {
         _bbox_tensor_list[i]->set_dims({bbox_cords[i].size(), 4});
         _bbox_tensor_list[i]->set_mem_handle((void *)meta_data_buffers);
@@ -1636,6 +1607,23 @@ TensorList *MasterGraph::mask_meta_data() {
     return &_mask_tensor_list;
 }
 
+std::pair<void *, const std::vector<size_t> *> MasterGraph::collated_meta_data(unsigned buffer_idx) {
+    if (!_meta_data_reader && _loaders_count > 1)
+        THROW("Metadata reader is not compatible with multiple loaders")
+    if (_external_source_reader)
+        THROW("Collated metadata is not supported with the external source reader")
+    if (_ring_buffer.level() == 0)
+        THROW("No meta data has been loaded")
+    // copy_data() already collates the samples in the ring buffer, only the offsets are computed here
+    auto meta_data_buffers = _ring_buffer.get_meta_read_buffers();
+    if (buffer_idx >= meta_data_buffers.size())
+        THROW("Metadata buffer " + TOSTR(buffer_idx) + " requested, the reader outputs " + TOSTR(meta_data_buffers.size()))
+    auto meta_data = _ring_buffer.get_meta_data().second;
+    if (!meta_data)
+        THROW("No meta data has been loaded for this batch")
+    return std::make_pair(meta_data_buffers[buffer_idx], &meta_data->get_sample_offsets(buffer_idx));
+}
+
 TensorList *MasterGraph::matched_index_meta_data() {
     if (!_meta_data_reader && _loaders_count > 1)
         THROW("Metadata reader is not compatible with multiple loaders")
@@ -1661,6 +1649,20 @@ bool MasterGraph::no_more_processed_data() {
     return (_output_routine_finished_processing && _ring_buffer.empty());
 }
 
+void MasterGraph::wait_for_loader_data() {
+    std::unique_lock<std::mutex> lock(_output_routine_lock);
+    _output_routine_wakeup.wait(lock, [this] { return _output_routine_woken || !_processing; });
+    _output_routine_woken = false;
+}
+
+void MasterGraph::wake_output_routine() {
+    {
+        std::unique_lock<std::mutex> lock(_output_routine_lock);
+        _output_routine_woken = true;
+    }
+    _output_routine_wakeup.notify_all();
+}
+
 MasterGraph::Status
 MasterGraph::copy_out_tensor_planar(void *out_ptr, RocalTensorlayout format, float multiplier0, float multiplier1,
                                     float multiplier2, float offset0, float offset1, float offset2, bool reverse_channels, RocalTensorDataType output_data_type) {
@@ -1681,126 +1683,23 @@ MasterGraph::copy_out_tensor_planar(void *out_ptr, RocalTensorlayout format, flo
         const size_t c = dims[1];
         const size_t h = dims[2];
         const size_t w = dims[3];
-        float multiplier[3] = {multiplier0, multiplier1, multiplier2};
-        float offset[3] = {offset0, offset1, offset2};
+        TensorConversionParams params;
+        params.layout = format;
+        params.data_type = output_data_type;
+        params.multiplier[0] = multiplier0, params.multiplier[1] = multiplier1, params.multiplier[2] = multiplier2;
+        params.offset[0] = offset0, params.offset[1] = offset1, params.offset[2] = offset2;
+        params.reverse_channels = reverse_channels;
+        const size_t output_elem_size = (output_data_type == RocalTensorDataType::FP16) ? sizeof(half) : sizeof(float);
         size_t dest_buf_offset = 0;
 
         auto output_buffers = _ring_buffer.get_read_buffers().first;
-
+        auto num_threads = _cpu_num_threads * 2;
         for (auto &&out_tensor : output_buffers) {
+#pragma omp parallel for num_threads(num_threads)
             for (unsigned batch = 0; batch < n; batch++) {
-                const size_t batch_offset = w * h * c * batch;
-                auto channel_size = w * h;
-                auto in_buffer = (unsigned char *)out_tensor + batch_offset;
-                if (format == RocalTensorlayout::NHWC) {
-                    if (output_data_type == RocalTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_32[dest_buf_offset + channel_idx + i * c] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? static_cast<float>(in_buffer[i +
-                                                                                                               (c - channel_idx -
-                                                                                                                1) *
-                                                                                                                   channel_size])
-                                                                                : static_cast<float>(in_buffer[i + channel_idx *
-                                                                                                                       channel_size]));
-                    } else if (output_data_type == RocalTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx + i * c] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? static_cast<half>(in_buffer[(c - channel_idx - 1) * channel_size + i])
-                                                                                : static_cast<half>(in_buffer[channel_idx * channel_size + i]));
-                    }
-                }
-                if (format == RocalTensorlayout::NCHW) {
-                    if (output_data_type == RocalTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        // output_tensor_32 += batch_offset;
-                        if (c != 3) {
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? (float)(in_buffer[(c - channel_idx - 1) * channel_size + i])
-                                                                                    : (float)(in_buffer[channel_idx * channel_size + i]));
-                        } else {
-#if (ENABLE_SIMD && __AVX2__)
-
-                            float *B_buf = output_tensor_32 + dest_buf_offset;
-                            float *G_buf = B_buf + channel_size;
-                            float *R_buf = G_buf + channel_size;
-                            unsigned char *in_buffer_R = in_buffer;
-                            unsigned char *in_buffer_G = in_buffer + channel_size;
-                            unsigned char *in_buffer_B = in_buffer_G + channel_size;
-
-                            __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                            __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                            __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                            __m256 padd0 = _mm256_set1_ps(offset0);
-                            __m256 padd1 = _mm256_set1_ps(offset1);
-                            __m256 padd2 = _mm256_set1_ps(offset2);
-                            unsigned int alignedLength = (channel_size & ~7);  // multiple of 8
-                            unsigned int i = 0;
-
-                            __m256 fR, fG, fB;
-                            for (; i < alignedLength; i += 8) {
-                                __m128i pixR, pixG, pixB;
-                                if (reverse_channels) {
-                                    pixB = _mm_loadl_epi64((const __m128i *)in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *)in_buffer_G);
-                                    pixR = _mm_loadl_epi64((const __m128i *)in_buffer_B);
-                                } else {
-                                    pixR = _mm_loadl_epi64((const __m128i *)in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *)in_buffer_G);
-                                    pixB = _mm_loadl_epi64((const __m128i *)in_buffer_B);
-                                }
-                                fB = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixR));
-                                fG = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixG));
-                                fR = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixB));
-                                fB = _mm256_mul_ps(fB, pmul0);
-                                fG = _mm256_mul_ps(fG, pmul1);
-                                fR = _mm256_mul_ps(fR, pmul2);
-                                fB = _mm256_add_ps(fB, padd0);
-                                fG = _mm256_add_ps(fG, padd1);
-                                fR = _mm256_add_ps(fR, padd2);
-                                _mm256_storeu_ps(B_buf, fB);
-                                _mm256_storeu_ps(G_buf, fG);
-                                _mm256_storeu_ps(R_buf, fR);
-                                B_buf += 8;
-                                G_buf += 8;
-                                R_buf += 8;
-                                in_buffer_R += 8, in_buffer_G += 8, in_buffer_B += 8;
-                            }
-                            for (; i < channel_size; i++) {
-                                *B_buf++ = (*in_buffer_R++ * multiplier0) + offset0;
-                                *G_buf++ = (*in_buffer_G++ * multiplier1) + offset1;
-                                *R_buf++ = (*in_buffer_B++ * multiplier2) + offset1;
-                            }
-
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] * (reverse_channels ? (float)(in_buffer[i + (c - channel_idx - 1) * channel_size]) : (float)(in_buffer[i + channel_idx * channel_size]));
-#endif
-                        }
-                    } else if (output_data_type == RocalTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx * channel_size + i] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? (half)(in_buffer[i +
-                                                                                                   (c - channel_idx -
-                                                                                                    1) *
-                                                                                                       channel_size])
-                                                                                : (half)(in_buffer[i + channel_idx *
-                                                                                                           channel_size]));
-                    }
-                }
+                const size_t batch_offset = dest_buf_offset + w * h * c * batch;
+                auto in_buffer = static_cast<unsigned char *>(out_tensor) + w * h * c * batch;
+                convert_planar_image(in_buffer, h, w, c, static_cast<unsigned char *>(out_ptr) + batch_offset * output_elem_size, params);
             }
             dest_buf_offset += single_output_tensor_size;
         }
@@ -1847,6 +1746,7 @@ void MasterGraph::feed_external_input(const std::vector<std::string>& input_imag
     if (!_loader_module)
         THROW("Loader module does not exist")
     _loader_module->feed_external_input(input_images_names, input_buffer, roi_xywh, max_width, max_height, channels, mode, eos);
+    wake_output_routine();
 
     if (is_labels) {
         if (_labels_tensor_list.size() == 0) {  // Labels tensor list is initialized only once for the pipeline
@@ -20,6 +20,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
+
 #include "pipeline/ring_buffer.h"
 #include "device/device_manager.h"
 
@@ -29,7 +31,9 @@ RingBuffer::RingBuffer(unsigned buffer_depth) : BUFF_DEPTH(buffer_depth),
                                                 _dev_roi_buffers(buffer_depth),
                                                 _host_roi_buffers(buffer_depth),
                                                 _dev_bbox_buffer(buffer_depth),
-                                                _dev_labels_buffer(buffer_depth) {
+                                                _dev_labels_buffer(buffer_depth),
+                                                _leases(std::make_shared<RingBufferLeases>(buffer_depth)) {
+    _leases->owner = this;
     reset();
 }
 
@@ -44,12 +48,16 @@ void RingBuffer::block_if_empty() {
 
 void RingBuffer::block_if_full() {
     std::unique_lock<std::mutex> lock(_lock);
-    // Write the whole buffer except for the last spot which is being read by the reader thread
-    if (full()) {
-        if (_dont_block)
-            return;
-        _wait_for_unload.wait(lock);
-    }
+    wait_for_write_slot(lock, _write_ptr, 0);
+}
+
+void RingBuffer::wait_for_write_slot(std::unique_lock<std::mutex> &lock, size_t slot, size_t reserved) {
+    auto unblock_count = _writer_unblock_count;
+    // Write the whole buffer except for the last spot which is being read by the reader thread, and never over a slot the user still holds a lease on
+    _wait_for_unload.wait(lock, [&] {
+        return _dont_block || _writer_unblock_count != unblock_count ||
+               ((_level + reserved) < BUFF_DEPTH - 1 && _leases->count[slot] == 0);
+    });
 }
 
 std::pair<std::vector<void *>, std::vector<unsigned *>> RingBuffer::get_read_buffers() {
@@ -68,16 +76,24 @@ std::pair<void *, void *> RingBuffer::get_box_encode_read_buffers() {
 
 std::pair<std::vector<void *>, std::vector<unsigned *>> RingBuffer::get_write_buffers() {
     block_if_full();
+    return get_write_buffers(_write_ptr);
+}
+
+std::pair<std::vector<void *>, std::vector<unsigned *>> RingBuffer::get_write_buffers(size_t slot) {
     if ((_mem_type == RocalMemType::OCL) || (_mem_type == RocalMemType::HIP))
-        return std::make_pair(_dev_sub_buffer[_write_ptr], _dev_roi_buffers[_write_ptr]);
-    return std::make_pair(_host_sub_buffers[_write_ptr], _host_roi_buffers[_write_ptr]);
+        return std::make_pair(_dev_sub_buffer[slot], _dev_roi_buffers[slot]);
+    return std::make_pair(_host_sub_buffers[slot], _host_roi_buffers[slot]);
 }
 
 std::pair<void *, void *> RingBuffer::get_box_encode_write_buffers() {
     block_if_full();
+    return get_box_encode_write_buffers(_write_ptr);
+}
+
+std::pair<void *, void *> RingBuffer::get_box_encode_write_buffers(size_t slot) {
     if ((_mem_type == RocalMemType::OCL) || (_mem_type == RocalMemType::HIP))
-        return std::make_pair(_dev_bbox_buffer[_write_ptr], _dev_labels_buffer[_write_ptr]);
-    return std::make_pair(_host_meta_data_buffers[_write_ptr][1], _host_meta_data_buffers[_write_ptr][0]);
+        return std::make_pair(_dev_bbox_buffer[slot], _dev_labels_buffer[slot]);
+    return std::make_pair(_host_meta_data_buffers[slot][1], _host_meta_data_buffers[slot][0]);
 }
 
 std::vector<void *> RingBuffer::get_meta_read_buffers() {
@@ -90,6 +106,48 @@ std::vector<void *> RingBuffer::get_meta_write_buffers() {
     return _host_meta_data_buffers[_write_ptr];
 }
 
+std::vector<void *> RingBuffer::get_meta_write_buffers(size_t slot) {
+    return _host_meta_data_buffers[slot];
+}
+
+size_t RingBuffer::reserve_write_slot() {
+    std::unique_lock<std::mutex> lock(_lock);
+    // Same rule as block_if_full(), the slots already reserved count as written
+    size_t slot = (_write_ptr + _reserved) % BUFF_DEPTH;
+    wait_for_write_slot(lock, slot, _reserved);
+    _reserved++;
+    return slot;
+}
+
+std::shared_ptr<void> RingBuffer::lease(size_t slot) {
+    if (slot >= BUFF_DEPTH)
+        THROW("Lease requested on slot " + TOSTR(slot) + " of a ring buffer of depth " + TOSTR(BUFF_DEPTH))
+    auto leases = _leases;
+    if (leases->count[slot]++ == 0) {
+        size_t leased_slots = std::count_if(leases->count.begin(), leases->count.end(), [](const std::atomic<unsigned> &count) { return count > 0; });
+        if (leased_slots >= BUFF_DEPTH - 1)
+            WRN("All the ring buffer slots are leased, the pipeline stalls until one of the exported batches is released")
+    }
+    return std::shared_ptr<void>(leases.get(), [leases, slot](void *) {
+        std::unique_lock<std::mutex> lock(leases->lock);
+        if (--leases->count[slot] > 0)
+            return;
+        if (leases->owner) {
+            leases->owner->notify_lease_released();
+        } else {
+            for (auto buffer : leases->orphaned[slot])
+                free(buffer);
+            leases->orphaned[slot].clear();
+        }
+    });
+}
+
+void RingBuffer::notify_lease_released() {
+    // Taking the lock makes sure a writer that found the slot leased is already waiting
+    { std::unique_lock<std::mutex> lock(_lock); }
+    _wait_for_unload.notify_all();
+}
+
 void RingBuffer::unblock_reader() {
     // Wake up the reader thread in case it's waiting for a load
     _wait_for_load.notify_all();
@@ -106,6 +164,10 @@ void RingBuffer::release_if_empty() {
 }
 
 void RingBuffer::unblock_writer() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _writer_unblock_count++;
+    }
     // Wake up the writer thread in case it's waiting for an unload
     _wait_for_unload.notify_all();
 }
@@ -132,6 +194,10 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
 
             _dev_sub_buffer[buffIdx].resize(sub_buffer_count);
             for (unsigned sub_idx = 0; sub_idx < sub_buffer_count; sub_idx++) {
+                if (is_external(sub_idx)) {
+                    _dev_sub_buffer[buffIdx][sub_idx] = _external_sub_buffers[sub_idx][buffIdx];
+                    continue;
+                }
                 _dev_sub_buffer[buffIdx][sub_idx] = clCreateBuffer(dev_ocl->context, flags, _sub_buffer_size[sub_idx], NULL, &err);
 
                 if (err) {
@@ -155,7 +221,11 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
             _dev_sub_buffer[buffIdx].resize(sub_buffer_count);
             _dev_roi_buffers[buffIdx].resize(sub_buffer_count);
             for (unsigned sub_idx = 0; sub_idx < sub_buffer_count; sub_idx++) {
-                hipError_t err = hipMalloc(&_dev_sub_buffer[buffIdx][sub_idx], _sub_buffer_size[sub_idx]);
+                hipError_t err = hipSuccess;
+                if (is_external(sub_idx))
+                    _dev_sub_buffer[buffIdx][sub_idx] = _external_sub_buffers[sub_idx][buffIdx];
+                else
+                    err = hipMalloc(&_dev_sub_buffer[buffIdx][sub_idx], _sub_buffer_size[sub_idx]);
                 // printf("allocated HIP device buffer <%d, %d, %d, %p>\n", buffIdx, sub_idx, _sub_buffer_size[sub_idx], _dev_sub_buffer[buffIdx][sub_idx]);
                 if (err != hipSuccess) {
                     _dev_sub_buffer.clear();
@@ -176,7 +246,10 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
             _host_sub_buffers[buffIdx].resize(sub_buffer_count);
             _host_roi_buffers[buffIdx].resize(sub_buffer_count);
             for (size_t sub_buff_idx = 0; sub_buff_idx < sub_buffer_count; sub_buff_idx++) {
-                _host_sub_buffers[buffIdx][sub_buff_idx] = aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_sub_buffer_size[sub_buff_idx] / MEM_ALIGNMENT + 1));
+                if (is_external(sub_buff_idx))
+                    _host_sub_buffers[buffIdx][sub_buff_idx] = _external_sub_buffers[sub_buff_idx][buffIdx];
+                else
+                    _host_sub_buffers[buffIdx][sub_buff_idx] = aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_sub_buffer_size[sub_buff_idx] / MEM_ALIGNMENT + 1));
                 _host_roi_buffers[buffIdx][sub_buff_idx] = static_cast<unsigned *>(malloc(roi_buffer_size[sub_buff_idx]));  // Allocate HOST ROI buffers
             }
         }
@@ -262,6 +335,18 @@ void RingBuffer::init_metadata(RocalMemType mem_type, std::vector<size_t> &sub_b
     }
 }
 
+void RingBuffer::set_external_sub_buffers(size_t sub_buffer_idx, const std::vector<void *> &buffers) {
+    if (!_sub_buffer_size.empty())
+        THROW("External buffers have to be set before the ring buffer is initialized")
+    if (buffers.size() != BUFF_DEPTH)
+        THROW("Ring buffer of depth " + TOSTR(BUFF_DEPTH) + " needs one external buffer per slot, " + TOSTR(buffers.size()) + " were given")
+    if (std::find(buffers.begin(), buffers.end(), nullptr) != buffers.end())
+        THROW("Null external buffer given for sub buffer " + TOSTR(sub_buffer_idx))
+    if (sub_buffer_idx >= _external_sub_buffers.size())
+        _external_sub_buffers.resize(sub_buffer_idx + 1);
+    _external_sub_buffers[sub_buffer_idx] = buffers;
+}
+
 void RingBuffer::push() {
     // pushing and popping to and from image and metadata buffer should be atomic so that their level stays the same at all times
     std::unique_lock<std::mutex> lock(_names_buff_lock);
@@ -282,17 +367,21 @@ void RingBuffer::reset() {
     _write_ptr = 0;
     _read_ptr = 0;
     _level = 0;
+    _reserved = 0;
     _dont_block = false;
     while (!_meta_ring_buffer.empty())
         _meta_ring_buffer.pop();
 }
 
 void RingBuffer::release_gpu_res() {
+    for (size_t slot = 0; slot < BUFF_DEPTH; slot++)
+        if (_leases->count[slot] > 0 && _mem_type != RocalMemType::HOST)
+            WRN("Device buffers of ring buffer slot " + TOSTR(slot) + " are released while still leased")
 #if ENABLE_HIP
     if (_mem_type == RocalMemType::HIP) {
         for (size_t buffIdx = 0; buffIdx < _dev_sub_buffer.size(); buffIdx++) {
             for (unsigned sub_buf_idx = 0; sub_buf_idx < _dev_sub_buffer[buffIdx].size(); sub_buf_idx++) {
-                if (_dev_sub_buffer[buffIdx][sub_buf_idx])
+                if (_dev_sub_buffer[buffIdx][sub_buf_idx] && !is_external(sub_buf_idx))
                     if (hipFree((void *)_dev_sub_buffer[buffIdx][sub_buf_idx]) != hipSuccess) {
                         // printf("Error Freeing device buffer <%d, %d, %p>\n", buffIdx, sub_buf_idx, _dev_sub_buffer[buffIdx][sub_buf_idx]);
                         ERR("Could not release hip memory in the ring buffer")
@@ -318,7 +407,7 @@ void RingBuffer::release_gpu_res() {
         if (_mem_type == RocalMemType::OCL) {
             for (size_t buffIdx = 0; buffIdx < _dev_sub_buffer.size(); buffIdx++) {
                 for (unsigned sub_buf_idx = 0; sub_buf_idx < _dev_sub_buffer[buffIdx].size(); sub_buf_idx++) {
-                    if (_dev_sub_buffer[buffIdx][sub_buf_idx])
+                    if (_dev_sub_buffer[buffIdx][sub_buf_idx] && !is_external(sub_buf_idx))
                         if (clReleaseMemObject((cl_mem)_dev_sub_buffer[buffIdx][sub_buf_idx]) != CL_SUCCESS)
                             ERR("Could not release ocl memory in the ring buffer")
                 }
@@ -336,10 +425,26 @@ void RingBuffer::release_gpu_res() {
 }
 
 RingBuffer::~RingBuffer() {
+    {
+        // The host buffers of the slots still leased are freed when their last lease is released
+        std::unique_lock<std::mutex> lock(_leases->lock);
+        _leases->owner = nullptr;
+        for (size_t slot = 0; slot < BUFF_DEPTH; slot++) {
+            if (_leases->count[slot] == 0 || slot >= _host_sub_buffers.size())
+                continue;
+            if (_mem_type == RocalMemType::HOST) {
+                for (size_t sub_buf_idx = 0; sub_buf_idx < _host_sub_buffers[slot].size(); sub_buf_idx++) {
+                    if (!is_external(sub_buf_idx))
+                        _leases->orphaned[slot].push_back(_host_sub_buffers[slot][sub_buf_idx]);
+                    _host_sub_buffers[slot][sub_buf_idx] = nullptr;
+                }
+            }
+        }
+    }
     if (_mem_type == RocalMemType::HOST) {
         for (unsigned buffIdx = 0; buffIdx < _host_sub_buffers.size(); buffIdx++) {
             for (unsigned sub_buf_idx = 0; sub_buf_idx < _host_sub_buffers[buffIdx].size(); sub_buf_idx++) {
-                if (_host_sub_buffers[buffIdx][sub_buf_idx])
+                if (_host_sub_buffers[buffIdx][sub_buf_idx] && !is_external(sub_buf_idx))
                     free(_host_sub_buffers[buffIdx][sub_buf_idx]);
                 if (_host_roi_buffers[buffIdx][sub_buf_idx])
                     free(_host_roi_buffers[buffIdx][sub_buf_idx]);
@@ -381,12 +486,18 @@ void RingBuffer::increment_write_ptr() {
     std::unique_lock<std::mutex> lock(_lock);
     _write_ptr = (_write_ptr + 1) % BUFF_DEPTH;
     _level++;
+    if (_reserved > 0)
+        _reserved--;
     lock.unlock();
     // Wake up the reader thread (in case waiting) since there is a new load to be read
     _wait_for_load.notify_all();
 }
 
 void RingBuffer::set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data) {
+    set_meta_data(std::move(names), meta_data, _write_ptr);
+}
+
+void RingBuffer::set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data, size_t slot) {
     if (meta_data == nullptr)
         _last_image_meta_data = std::make_pair(std::move(names), pMetaDataBatch());
     else {
@@ -394,20 +505,24 @@ void RingBuffer::set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data) {
         if (!_box_encoder) {
             auto actual_buffer_size = meta_data->get_buffer_size();
             for (unsigned i = 0; i < actual_buffer_size.size(); i++) {
-                if (actual_buffer_size[i] > _meta_data_sub_buffer_size[_write_ptr][i])
-                    rellocate_meta_data_buffer(_host_meta_data_buffers[_write_ptr][i], actual_buffer_size[i], i);
+                if (actual_buffer_size[i] > _meta_data_sub_buffer_size[slot][i])
+                    rellocate_meta_data_buffer(_host_meta_data_buffers[slot][i], actual_buffer_size[i], i, slot);
             }
-            meta_data->copy_data(_host_meta_data_buffers[_write_ptr]);
+            meta_data->copy_data(_host_meta_data_buffers[slot]);
         }
     }
 }
 
 void RingBuffer::rellocate_meta_data_buffer(void *buffer, size_t buffer_size, unsigned buff_idx) {
+    rellocate_meta_data_buffer(buffer, buffer_size, buff_idx, _write_ptr);
+}
+
+void RingBuffer::rellocate_meta_data_buffer(void *buffer, size_t buffer_size, unsigned buff_idx, size_t slot) {
     void *new_ptr = realloc(buffer, buffer_size);
     if (buffer == nullptr)
         THROW("Metadata ring buffer reallocation failed")
-    _host_meta_data_buffers[_write_ptr][buff_idx] = new_ptr;
-    _meta_data_sub_buffer_size[_write_ptr][buff_idx] = buffer_size;
+    _host_meta_data_buffers[slot][buff_idx] = new_ptr;
+    _meta_data_sub_buffer_size[slot][buff_idx] = buffer_size;
 }
 
 MetaDataNamePair &RingBuffer::get_meta_data() {
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #endif
 #include <vx_ext_amd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 #include "pipeline/commons.h"
@@ -140,6 +141,48 @@ void TensorInfo::reallocate_tensor_sample_rate_buffers() {
     _sample_rates = std::make_shared<std::vector<float>>(_batch_size);
 }
 
+// Origin and size of the ROI of a sample, clamped to the max shape of the tensor
+static void roi_extent(const Roi2DCords &roi, RocalROIType roi_type, const std::vector<size_t> &max_shape,
+                       size_t &x, size_t &y, size_t &width, size_t &height) {
+    if (roi_type == RocalROIType::LTRB) {
+        x = roi.ltrb.l;
+        y = roi.ltrb.t;
+        width = roi.ltrb.r - roi.ltrb.l + 1;
+        height = roi.ltrb.b - roi.ltrb.t + 1;
+    } else {
+        x = roi.xywh.x;
+        y = roi.xywh.y;
+        width = roi.xywh.w;
+        height = roi.xywh.h;
+    }
+    x = std::min(x, max_shape[0]);
+    y = std::min(y, max_shape[1]);
+    width = std::min(width, max_shape[0] - x);
+    height = std::min(height, max_shape[1] - y);
+}
+
+void TensorInfo::set_packed(bool packed) {
+    if (packed && !(_is_image && (_layout == RocalTensorlayout::NHWC || _layout == RocalTensorlayout::NCHW)))
+        THROW("Packed layout is only supported for NHWC and NCHW image tensors")
+    _is_packed = packed;
+}
+
+std::vector<size_t> TensorInfo::sample_offsets() {
+    std::vector<size_t> offsets(_batch_size + 1, 0);
+    if (!_is_packed) {
+        for (unsigned i = 0; i <= _batch_size; i++)
+            offsets[i] = i * _strides[0];
+        return offsets;
+    }
+    const Roi2DCords *roi = _roi.get_2D_roi();
+    for (unsigned i = 0; i < _batch_size; i++) {
+        size_t x, y, width, height;
+        roi_extent(roi[i], _roi_type, _max_shape, x, y, width, height);
+        offsets[i + 1] = offsets[i] + width * height * _channels * _data_type_size;
+    }
+    return offsets;
+}
+
 TensorInfo::TensorInfo()
     : _type(Type::UNKNOWN),
       _num_of_dims(0),
@@ -383,6 +426,8 @@ void Tensor::create_roi_tensor_from_handle(void **handle) {
 #if ENABLE_OPENCL
 unsigned Tensor::copy_data(cl_command_queue queue, unsigned char *user_buffer, bool sync) {
     if (_info._type != TensorInfo::Type::HANDLE) return 0;
+    if (_info.is_packed())
+        THROW("copy_data: packed tensors cannot be copied through an OpenCL queue")
 
     if (_info._mem_type == RocalMemType::OCL) {
         cl_int status;
@@ -399,6 +444,15 @@ unsigned Tensor::copy_data(cl_command_queue queue, unsigned char *user_buffer, b
 #elif ENABLE_HIP
 unsigned Tensor::copy_data(hipStream_t stream, void *host_memory, bool sync) {
     if (_info._type != TensorInfo::Type::HANDLE) return 0;
+    if (_info.is_packed()) {
+        copy_packed_data(host_memory, RocalOutputMemType::ROCAL_MEMCPY_HOST, stream);
+        if (sync && _info._mem_type == RocalMemType::HIP) {
+            hipError_t status;
+            if ((status = hipStreamSynchronize(stream)))
+                THROW("copy_data::hipStreamSynchronize failed: " + TOSTR(status))
+        }
+        return 0;
+    }
 
     if (_info._mem_type == RocalMemType::HIP) {
         // copy from device to host
@@ -418,6 +472,7 @@ unsigned Tensor::copy_data(hipStream_t stream, void *host_memory, bool sync) {
 
 unsigned Tensor::copy_data(void *user_buffer, RocalOutputMemType external_mem_type) {
     if (_mem_handle == nullptr) return 0;
+    if (_info.is_packed()) return copy_packed_data(user_buffer, external_mem_type);
     if (external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU) {
 #if ENABLE_HIP
         if (_info._mem_type == RocalMemType::HIP) {
@@ -475,6 +530,69 @@ unsigned Tensor::copy_data(void *user_buffer, uint x_offset, uint y_offset, uint
     return 0;
 }
 
+#if ENABLE_HIP
+unsigned Tensor::copy_packed_data(void *user_buffer, RocalOutputMemType external_mem_type, hipStream_t stream) {
+#else
+unsigned Tensor::copy_packed_data(void *user_buffer, RocalOutputMemType external_mem_type) {
+#endif
+    if (external_mem_type != RocalOutputMemType::ROCAL_MEMCPY_HOST && external_mem_type != RocalOutputMemType::ROCAL_MEMCPY_GPU)
+        THROW("copy_data requested mem type not supported")
+#if ENABLE_HIP
+    hipMemcpyKind copy_kind;
+    if (_info._mem_type == RocalMemType::HIP)
+        copy_kind = (external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU) ? hipMemcpyDeviceToDevice : hipMemcpyDeviceToHost;
+    else
+        copy_kind = (external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU) ? hipMemcpyHostToDevice : hipMemcpyHostToHost;
+#else
+    if (_info._mem_type != RocalMemType::HOST || external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU)
+        THROW("copy_data failed as HIP is not supported")
+#endif
+    // Copies rows of row_bytes from a source with a pitch of src_pitch to contiguous rows
+    auto copy_rows = [&](unsigned char *dst, const unsigned char *src, size_t row_bytes, size_t src_pitch, size_t rows) {
+        if (!row_bytes || !rows) return;
+#if ENABLE_HIP
+        if (copy_kind != hipMemcpyHostToHost) {
+            hipError_t status;
+            if (stream)
+                status = hipMemcpy2DAsync(dst, row_bytes, src, src_pitch, row_bytes, rows, copy_kind, stream);
+            else
+                status = hipMemcpy2D(dst, row_bytes, src, src_pitch, row_bytes, rows, copy_kind);
+            if (status)
+                THROW("copy_data::hipMemcpy2D failed: " + TOSTR(status))
+            return;
+        }
+#endif
+        if (row_bytes == src_pitch) {
+            memcpy(dst, src, row_bytes * rows);
+            return;
+        }
+        for (size_t row = 0; row < rows; row++, dst += row_bytes, src += src_pitch)
+            memcpy(dst, src, row_bytes);
+    };
+    auto offsets = _info.sample_offsets();
+    auto strides = _info.strides();
+    auto max_shape = _info.max_shape();
+    auto channels = _info.get_channels();
+    auto dtype_size = _info.data_type_size();
+    const Roi2DCords *roi = _info.roi().get_2D_roi();
+    auto src_base = static_cast<const unsigned char *>(_mem_handle);
+    auto dst_base = static_cast<unsigned char *>(user_buffer);
+    for (unsigned i = 0; i < _info.batch_size(); i++) {
+        size_t x, y, width, height;
+        roi_extent(roi[i], _info.roi_type(), max_shape, x, y, width, height);
+        auto src = src_base + i * strides[0];
+        auto dst = dst_base + offsets[i];
+        if (_info.layout() == RocalTensorlayout::NHWC) {
+            copy_rows(dst, src + y * strides[1] + x * strides[2], width * channels * dtype_size, strides[1], height);
+        } else {  // NCHW, the channel planes of a sample follow each other
+            size_t plane_size = width * height * dtype_size;
+            for (size_t c = 0; c < channels; c++)
+                copy_rows(dst + c * plane_size, src + c * strides[1] + y * strides[2] + x * strides[3], width * dtype_size, strides[2], height);
+        }
+    }
+    return 0;
+}
+
 int Tensor::swap_handle(void *handle) {
     vx_status status;
     if ((status = vxSwapTensorHandle(_vx_handle, handle, nullptr)) != VX_SUCCESS) {
@@ -0,0 +1,410 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/tensor_conversion.h"
+
+#include <algorithm>
+#include <cstring>
+#include <half/half.hpp>
+#include <type_traits>
+#include <vector>
+
+#include "pipeline/cpu_features.h"
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+using half_float::half;
+
+namespace {
+
+// Channels past the third reuse the parameters of the third one
+inline size_t param_index(size_t channel) { return std::min<size_t>(channel, 2); }
+
+inline size_t source_channel(size_t channel, size_t channels, bool reverse_channels) {
+    return reverse_channels ? channels - channel - 1 : channel;
+}
+
+// Handles any layout and channel count, input pixel (row, col) channel k is at in[row * row_stride + col * pixel_stride + k * channel_stride]
+template <typename T>
+void convert_scalar(const uint8_t *in, size_t row_stride, size_t pixel_stride, size_t channel_stride, size_t height, size_t width,
+                    size_t channels, T *out, const TensorConversionParams &params) {
+    const bool planar_output = params.layout == RocalTensorlayout::NCHW;
+    const size_t out_pixel_stride = planar_output ? 1 : channels;
+    for (size_t channel = 0; channel < channels; channel++) {
+        const float mul = params.multiplier[param_index(channel)];
+        const float add = params.offset[param_index(channel)];
+        const uint8_t *in_channel = in + source_channel(channel, channels, params.reverse_channels) * channel_stride;
+        T *out_channel = planar_output ? out + channel * height * width : out + channel;
+        for (size_t row = 0; row < height; row++) {
+            const uint8_t *in_row = in_channel + row * row_stride;
+            T *out_row = out_channel + row * width * out_pixel_stride;
+            for (size_t col = 0; col < width; col++)
+                out_row[col * out_pixel_stride] = static_cast<T>(in_row[col * pixel_stride] * mul + add);
+        }
+    }
+}
+
+#if SIMD_X86
+// Multipliers and offsets of 48 consecutive values of a packed 1 or 3 channel row, 48 is a multiple of both periods and of the vector widths
+struct ValuePattern {
+    float mul[48];
+    float add[48];
+    ValuePattern(const float *multiplier, const float *offset, size_t period) {
+        for (size_t i = 0; i < 48; i++) {
+            mul[i] = multiplier[i % period];
+            add[i] = offset[i % period];
+        }
+    }
+};
+
+// pshufb masks moving the bytes of 16 RGB pixels between the interleaved order (3 vectors) and the planar order (1 vector per channel)
+struct RgbShuffleMasks {
+    alignas(16) int8_t deinterleave[3][3][16];  // [channel][interleaved vector]
+    alignas(16) int8_t interleave[3][3][16];    // [interleaved vector][channel]
+    RgbShuffleMasks() {
+        for (int channel = 0; channel < 3; channel++) {
+            for (int vec = 0; vec < 3; vec++) {
+                for (int j = 0; j < 16; j++) {
+                    int pos = 3 * j + channel - 16 * vec;  // Byte of pixel j in the interleaved vector
+                    deinterleave[channel][vec][j] = (pos >= 0 && pos < 16) ? pos : -128;
+                    int byte = 16 * vec + j;  // Interleaved byte written by lane j
+                    interleave[vec][channel][j] = (byte % 3 == channel) ? byte / 3 : -128;
+                }
+            }
+        }
+    }
+};
+
+const RgbShuffleMasks &rgb_shuffle_masks() {
+    static const RgbShuffleMasks masks;
+    return masks;
+}
+
+SIMD_TARGET_SSE42 inline __m128 load4(const uint8_t *in) {
+    int32_t pixels;
+    memcpy(&pixels, in, sizeof(pixels));
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixels)));
+}
+
+SIMD_TARGET_AVX2 inline __m256 load8(const uint8_t *in) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)in)));
+}
+SIMD_TARGET_AVX2 inline void store8(float *out, __m256 value) { _mm256_storeu_ps(out, value); }
+SIMD_TARGET_AVX2 inline void store8(half *out, __m256 value) {
+    _mm_storeu_si128((__m128i *)out, _mm256_cvtps_ph(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+SIMD_TARGET_AVX512 inline __m512 load16(const uint8_t *in) {
+    return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)in)));
+}
+SIMD_TARGET_AVX512 inline void store16(float *out, __m512 value) { _mm512_storeu_ps(out, value); }
+SIMD_TARGET_AVX512 inline void store16(half *out, __m512 value) {
+    _mm256_storeu_si256((__m256i *)out, _mm512_cvtps_ph(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+// Converts count packed values, value i uses lane i % 48 of the pattern
+SIMD_TARGET_SSE42 void convert_values_sse42(const uint8_t *in, float *out, size_t count, const ValuePattern &pattern) {
+    const __m128 pmul0 = _mm_loadu_ps(pattern.mul), pmul1 = _mm_loadu_ps(pattern.mul + 4), pmul2 = _mm_loadu_ps(pattern.mul + 8);
+    const __m128 padd0 = _mm_loadu_ps(pattern.add), padd1 = _mm_loadu_ps(pattern.add + 4), padd2 = _mm_loadu_ps(pattern.add + 8);
+    size_t i = 0;
+    for (; i + 12 <= count; i += 12) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(load4(in + i), pmul0), padd0));
+        _mm_storeu_ps(out + i + 4, _mm_add_ps(_mm_mul_ps(load4(in + i + 4), pmul1), padd1));
+        _mm_storeu_ps(out + i + 8, _mm_add_ps(_mm_mul_ps(load4(in + i + 8), pmul2), padd2));
+    }
+    for (; i < count; i++)
+        out[i] = in[i] * pattern.mul[i % 12] + pattern.add[i % 12];
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 void convert_values_avx2(const uint8_t *in, T *out, size_t count, const ValuePattern &pattern) {
+    const __m256 pmul0 = _mm256_loadu_ps(pattern.mul), pmul1 = _mm256_loadu_ps(pattern.mul + 8), pmul2 = _mm256_loadu_ps(pattern.mul + 16);
+    const __m256 padd0 = _mm256_loadu_ps(pattern.add), padd1 = _mm256_loadu_ps(pattern.add + 8), padd2 = _mm256_loadu_ps(pattern.add + 16);
+    size_t i = 0;
+    for (; i + 24 <= count; i += 24) {
+        store8(out + i, _mm256_fmadd_ps(load8(in + i), pmul0, padd0));
+        store8(out + i + 8, _mm256_fmadd_ps(load8(in + i + 8), pmul1, padd1));
+        store8(out + i + 16, _mm256_fmadd_ps(load8(in + i + 16), pmul2, padd2));
+    }
+    for (; i < count; i++)
+        out[i] = static_cast<T>(in[i] * pattern.mul[i % 24] + pattern.add[i % 24]);
+}
+
+template <typename T>
+SIMD_TARGET_AVX512 void convert_values_avx512(const uint8_t *in, T *out, size_t count, const ValuePattern &pattern) {
+    const __m512 pmul0 = _mm512_loadu_ps(pattern.mul), pmul1 = _mm512_loadu_ps(pattern.mul + 16), pmul2 = _mm512_loadu_ps(pattern.mul + 32);
+    const __m512 padd0 = _mm512_loadu_ps(pattern.add), padd1 = _mm512_loadu_ps(pattern.add + 16), padd2 = _mm512_loadu_ps(pattern.add + 32);
+    size_t i = 0;
+    for (; i + 48 <= count; i += 48) {
+        store16(out + i, _mm512_fmadd_ps(load16(in + i), pmul0, padd0));
+        store16(out + i + 16, _mm512_fmadd_ps(load16(in + i + 16), pmul1, padd1));
+        store16(out + i + 32, _mm512_fmadd_ps(load16(in + i + 32), pmul2, padd2));
+    }
+    convert_values_avx2(in + i, out + i, count - i, pattern);  // i is a multiple of 48, the rest starts at lane 0
+}
+
+template <typename T>
+void convert_values(CpuIsaLevel isa, const uint8_t *in, T *out, size_t count, const ValuePattern &pattern) {
+    if (isa == CpuIsaLevel::AVX512) {
+        convert_values_avx512(in, out, count, pattern);
+    } else if (isa == CpuIsaLevel::AVX2) {
+        convert_values_avx2(in, out, count, pattern);
+    } else {
+        if constexpr (std::is_same<T, float>::value)
+            convert_values_sse42(in, out, count, pattern);
+    }
+}
+
+// Swaps the first and the third channel of a row of RGB pixels, out needs 16 bytes of padding
+SIMD_TARGET_SSE42 void reverse_rgb_row(const uint8_t *in, uint8_t *out, size_t width) {
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    size_t col = 0;
+    // Each 16 bytes load reverses 5 pixels, the 16th byte is overwritten by the next store
+    for (; col + 6 <= width; col += 5)
+        _mm_storeu_si128((__m128i *)(out + col * 3), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + col * 3)), mask));
+    for (; col < width; col++) {
+        out[col * 3] = in[col * 3 + 2];
+        out[col * 3 + 1] = in[col * 3 + 1];
+        out[col * 3 + 2] = in[col * 3];
+    }
+}
+
+SIMD_TARGET_SSE42 inline void deinterleave_rgb16(const uint8_t *in, const __m128i (&masks)[3][3], __m128i (&planes)[3]) {
+    const __m128i vec0 = _mm_loadu_si128((const __m128i *)in);
+    const __m128i vec1 = _mm_loadu_si128((const __m128i *)(in + 16));
+    const __m128i vec2 = _mm_loadu_si128((const __m128i *)(in + 32));
+    for (int channel = 0; channel < 3; channel++)
+        planes[channel] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vec0, masks[channel][0]), _mm_shuffle_epi8(vec1, masks[channel][1])),
+                                       _mm_shuffle_epi8(vec2, masks[channel][2]));
+}
+
+SIMD_TARGET_SSE42 inline void load_masks(const int8_t (&src)[3][3][16], __m128i (&masks)[3][3]) {
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            masks[i][j] = _mm_load_si128((const __m128i *)src[i][j]);
+}
+
+// Converts a row of RGB pixels to the rows of the three output planes
+SIMD_TARGET_SSE42 void convert_rgb_row_to_planes_sse42(const uint8_t *in, float *const (&out)[3], size_t width, const TensorConversionParams &params) {
+    __m128i masks[3][3];
+    load_masks(rgb_shuffle_masks().deinterleave, masks);
+    size_t src[3];
+    __m128 pmul[3], padd[3];
+    for (size_t k = 0; k < 3; k++) {
+        src[k] = source_channel(k, 3, params.reverse_channels);
+        pmul[k] = _mm_set1_ps(params.multiplier[k]);
+        padd[k] = _mm_set1_ps(params.offset[k]);
+    }
+    size_t col = 0;
+    for (; col + 16 <= width; col += 16, in += 48) {
+        __m128i planes[3];
+        deinterleave_rgb16(in, masks, planes);
+        for (size_t k = 0; k < 3; k++) {
+            const __m128i pix = planes[src[k]];
+            _mm_storeu_ps(out[k] + col, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(pix)), pmul[k]), padd[k]));
+            _mm_storeu_ps(out[k] + col + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(pix, 4))), pmul[k]), padd[k]));
+            _mm_storeu_ps(out[k] + col + 8, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(pix, 8))), pmul[k]), padd[k]));
+            _mm_storeu_ps(out[k] + col + 12, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(pix, 12))), pmul[k]), padd[k]));
+        }
+    }
+    for (; col < width; col++, in += 3)
+        for (size_t k = 0; k < 3; k++)
+            out[k][col] = in[src[k]] * params.multiplier[k] + params.offset[k];
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 void convert_rgb_row_to_planes_avx2(const uint8_t *in, T *const (&out)[3], size_t width, const TensorConversionParams &params) {
+    __m128i masks[3][3];
+    load_masks(rgb_shuffle_masks().deinterleave, masks);
+    size_t src[3];
+    __m256 pmul[3], padd[3];
+    for (size_t k = 0; k < 3; k++) {
+        src[k] = source_channel(k, 3, params.reverse_channels);
+        pmul[k] = _mm256_set1_ps(params.multiplier[k]);
+        padd[k] = _mm256_set1_ps(params.offset[k]);
+    }
+    size_t col = 0;
+    for (; col + 16 <= width; col += 16, in += 48) {
+        __m128i planes[3];
+        deinterleave_rgb16(in, masks, planes);
+        for (size_t k = 0; k < 3; k++) {
+            const __m128i pix = planes[src[k]];
+            store8(out[k] + col, _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pix)), pmul[k], padd[k]));
+            store8(out[k] + col + 8, _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(pix, 8))), pmul[k], padd[k]));
+        }
+    }
+    for (; col < width; col++, in += 3)
+        for (size_t k = 0; k < 3; k++)
+            out[k][col] = static_cast<T>(in[src[k]] * params.multiplier[k] + params.offset[k]);
+}
+
+template <typename T>
+SIMD_TARGET_AVX512 void convert_rgb_row_to_planes_avx512(const uint8_t *in, T *const (&out)[3], size_t width, const TensorConversionParams &params) {
+    __m128i masks[3][3];
+    load_masks(rgb_shuffle_masks().deinterleave, masks);
+    size_t src[3];
+    __m512 pmul[3], padd[3];
+    for (size_t k = 0; k < 3; k++) {
+        src[k] = source_channel(k, 3, params.reverse_channels);
+        pmul[k] = _mm512_set1_ps(params.multiplier[k]);
+        padd[k] = _mm512_set1_ps(params.offset[k]);
+    }
+    size_t col = 0;
+    for (; col + 16 <= width; col += 16, in += 48) {
+        __m128i planes[3];
+        deinterleave_rgb16(in, masks, planes);
+        for (size_t k = 0; k < 3; k++)
+            store16(out[k] + col, _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(planes[src[k]])), pmul[k], padd[k]));
+    }
+    for (; col < width; col++, in += 3)
+        for (size_t k = 0; k < 3; k++)
+            out[k][col] = static_cast<T>(in[src[k]] * params.multiplier[k] + params.offset[k]);
+}
+
+// Interleaves count pixels of three planes into RGB pixels
+SIMD_TARGET_SSE42 void interleave_rgb(const uint8_t *const (&planes)[3], uint8_t *out, size_t count) {
+    __m128i masks[3][3];
+    load_masks(rgb_shuffle_masks().interleave, masks);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16, out += 48) {
+        const __m128i pix0 = _mm_loadu_si128((const __m128i *)(planes[0] + i));
+        const __m128i pix1 = _mm_loadu_si128((const __m128i *)(planes[1] + i));
+        const __m128i pix2 = _mm_loadu_si128((const __m128i *)(planes[2] + i));
+        for (int vec = 0; vec < 3; vec++)
+            _mm_storeu_si128((__m128i *)(out + 16 * vec), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(pix0, masks[vec][0]), _mm_shuffle_epi8(pix1, masks[vec][1])),
+                                                                       _mm_shuffle_epi8(pix2, masks[vec][2])));
+    }
+    for (; i < count; i++, out += 3) {
+        out[0] = planes[0][i];
+        out[1] = planes[1][i];
+        out[2] = planes[2][i];
+    }
+}
+
+template <typename T>
+void convert_interleaved_simd(CpuIsaLevel isa, const uint8_t *in, size_t row_stride, size_t height, size_t width, size_t channels,
+                              T *out, const TensorConversionParams &params) {
+    if (params.layout == RocalTensorlayout::NCHW && channels == 3) {
+        const size_t plane_size = height * width;
+        for (size_t row = 0; row < height; row++) {
+            T *const out_rows[3] = {out + row * width, out + plane_size + row * width, out + 2 * plane_size + row * width};
+            if (isa == CpuIsaLevel::AVX512) {
+                convert_rgb_row_to_planes_avx512(in + row * row_stride, out_rows, width, params);
+            } else if (isa == CpuIsaLevel::AVX2) {
+                convert_rgb_row_to_planes_avx2(in + row * row_stride, out_rows, width, params);
+            } else {
+                if constexpr (std::is_same<T, float>::value)
+                    convert_rgb_row_to_planes_sse42(in + row * row_stride, out_rows, width, params);
+            }
+        }
+        return;
+    }
+    // Packed output, a single channel image is the same in both layouts
+    const ValuePattern pattern(params.multiplier, params.offset, channels);
+    const bool reverse = params.reverse_channels && channels == 3;
+    thread_local std::vector<uint8_t> reversed_row;
+    if (reverse && reversed_row.size() < width * 3 + 16)
+        reversed_row.resize(width * 3 + 16);
+    for (size_t row = 0; row < height; row++) {
+        const uint8_t *in_row = in + row * row_stride;
+        if (reverse) {
+            reverse_rgb_row(in_row, reversed_row.data(), width);
+            in_row = reversed_row.data();
+        }
+        convert_values(isa, in_row, out + row * width * channels, width * channels, pattern);
+    }
+}
+
+template <typename T>
+void convert_planar_simd(CpuIsaLevel isa, const uint8_t *in, size_t height, size_t width, size_t channels, T *out,
+                         const TensorConversionParams &params) {
+    const size_t plane_size = height * width;
+    if (params.layout == RocalTensorlayout::NCHW || channels == 1) {
+        for (size_t k = 0; k < channels; k++) {
+            const ValuePattern pattern(&params.multiplier[k], &params.offset[k], 1);
+            convert_values(isa, in + source_channel(k, channels, params.reverse_channels) * plane_size, out + k * plane_size, plane_size, pattern);
+        }
+        return;
+    }
+    // NHWC 3 channels, the planes are interleaved in chunks small enough to stay in L1
+    constexpr size_t CHUNK_PIXELS = 1024;
+    uint8_t chunk[CHUNK_PIXELS * 3];
+    const ValuePattern pattern(params.multiplier, params.offset, 3);
+    const uint8_t *planes[3];
+    for (size_t k = 0; k < 3; k++)
+        planes[k] = in + source_channel(k, 3, params.reverse_channels) * plane_size;
+    for (size_t start = 0; start < plane_size; start += CHUNK_PIXELS) {
+        const size_t count = std::min(CHUNK_PIXELS, plane_size - start);
+        const uint8_t *const chunk_planes[3] = {planes[0] + start, planes[1] + start, planes[2] + start};
+        interleave_rgb(chunk_planes, chunk, count);
+        convert_values(isa, chunk, out + start * 3, count * 3, pattern);
+    }
+}
+
+// SSE4.2 has no half conversion, the FP16 kernels start with the AVX2 level
+template <typename T>
+constexpr CpuIsaLevel simd_min_level() { return std::is_same<T, half>::value ? CpuIsaLevel::AVX2 : CpuIsaLevel::SSE42; }
+#endif
+
+template <typename T>
+void convert_interleaved(const uint8_t *in, size_t row_stride, size_t height, size_t width, size_t channels, T *out,
+                         const TensorConversionParams &params) {
+#if SIMD_X86
+    const CpuIsaLevel isa = cpu_isa_level();
+    if (isa >= simd_min_level<T>() && (channels == 1 || channels == 3))
+        return convert_interleaved_simd(isa, in, row_stride, height, width, channels, out, params);
+#endif
+    convert_scalar(in, row_stride, channels, 1, height, width, channels, out, params);
+}
+
+template <typename T>
+void convert_planar(const uint8_t *in, size_t height, size_t width, size_t channels, T *out, const TensorConversionParams &params) {
+#if SIMD_X86
+    const CpuIsaLevel isa = cpu_isa_level();
+    if (isa >= simd_min_level<T>() && (channels == 1 || channels == 3))
+        return convert_planar_simd(isa, in, height, width, channels, out, params);
+#endif
+    convert_scalar(in, width, 1, height * width, height, width, channels, out, params);
+}
+
+}  // namespace
+
+void convert_interleaved_image(const uint8_t *in, size_t row_stride, size_t height, size_t width, size_t channels,
+                               void *out, const TensorConversionParams &params) {
+    if (params.data_type == RocalTensorDataType::FP32)
+        convert_interleaved(in, row_stride, height, width, channels, static_cast<float *>(out), params);
+    else if (params.data_type == RocalTensorDataType::FP16)
+        convert_interleaved(in, row_stride, height, width, channels, static_cast<half *>(out), params);
+    else
+        THROW("Tensor conversion only supports FP32 and FP16 outputs")
+}
+
+void convert_planar_image(const uint8_t *in, size_t height, size_t width, size_t channels, void *out,
+                          const TensorConversionParams &params) {
+    if (params.data_type == RocalTensorDataType::FP32)
+        convert_planar(in, height, width, channels, static_cast<float *>(out), params);
+    else if (params.data_type == RocalTensorDataType::FP16)
+        convert_planar(in, height, width, channels, static_cast<half *>(out), params);
+    else
+        THROW("Tensor conversion only supports FP32 and FP16 outputs")
+}
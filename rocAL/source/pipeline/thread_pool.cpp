@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/thread_pool.h"
+
+#include <algorithm>
+#if !defined(WIN32) && !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "pipeline/log.h"
+
+ThreadPool::ThreadPool(size_t num_threads, const std::vector<unsigned> &cpu_ids) {
+    if (num_threads == 0)
+        num_threads = 1;
+    _workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        _workers.emplace_back(&ThreadPool::run, this);
+        if (!cpu_ids.empty())
+            set_thread_affinity(_workers.back(), {cpu_ids[i % cpu_ids.size()]});
+    }
+}
+
+void ThreadPool::set_thread_affinity(std::thread &thread, const std::vector<unsigned> &cpu_ids) {
+    if (cpu_ids.empty())
+        return;
+#if !defined(WIN32) && !defined(_WIN32)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu_id : cpu_ids)
+        if (cpu_id < CPU_SETSIZE)
+            CPU_SET(cpu_id, &cpu_set);
+    auto ret = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0)
+        WRN("Unable to set the CPU affinity of the thread, error " + TOSTR(ret))
+#endif
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t, size_t)> &body, size_t max_parallelism) {
+    if (count == 0)
+        return;
+    // The state is shared with the helper jobs, those still queued when the loop completes find no index left and return without touching body
+    struct LoopState {
+        std::atomic<size_t> next_idx{0};
+        std::atomic<size_t> next_slot{1};
+        size_t remaining;
+        std::mutex lock;
+        std::condition_variable completed;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<LoopState>();
+    state->remaining = count;
+    auto execute = [state, count, &body](size_t slot) {
+        size_t done = 0;
+        for (size_t idx = state->next_idx++; idx < count; idx = state->next_idx++) {
+            try {
+                body(idx, slot);
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(state->lock);
+                if (!state->error)
+                    state->error = std::current_exception();
+            }
+            done++;
+        }
+        if (done) {
+            std::unique_lock<std::mutex> lock(state->lock);
+            state->remaining -= done;
+            if (state->remaining == 0)
+                state->completed.notify_all();
+        }
+    };
+    size_t helpers = std::min(count, max_parallelism ? std::min(max_parallelism, max_slots()) : max_slots()) - 1;
+    for (size_t i = 0; i < helpers; i++) {
+        // body is only dereferenced by a helper holding an index, and the caller waits for all of them to complete below
+        submit([state, execute] { execute(state->next_slot++); });
+    }
+    execute(0);
+    std::unique_lock<std::mutex> lock(state->lock);
+    state->completed.wait(lock, [&state] { return state->remaining == 0; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _job_available.notify_all();
+    for (auto &worker : _workers)
+        if (worker.joinable())
+            worker.join();
+}
+
+std::shared_future<void> ThreadPool::submit(std::function<void()> job) {
+    std::packaged_task<void()> task(std::move(job));
+    std::shared_future<void> done = task.get_future().share();
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _jobs.push(std::move(task));
+        _jobs_in_flight++;
+    }
+    _job_available.notify_one();
+    return done;
+}
+
+void ThreadPool::wait_all() {
+    std::unique_lock<std::mutex> lock(_lock);
+    _all_done.wait(lock, [this] { return _jobs_in_flight == 0; });
+}
+
+void ThreadPool::run() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _job_available.wait(lock, [this] { return _stop || !_jobs.empty(); });
+            if (_stop && _jobs.empty())
+                return;
+            task = std::move(_jobs.front());
+            _jobs.pop();
+        }
+        task();  // Exceptions thrown by the job are stored in the future
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            if (--_jobs_in_flight == 0)
+                _all_done.notify_all();
+        }
+    }
+}
@@ -69,7 +69,7 @@ void FileSourceReader::incremenet_read_ptr() {
     increment_curr_file_idx(_file_names.size());
 }
 
-size_t FileSourceReader::open() {
+std::string FileSourceReader::next_file_path() {
     auto file_path = _file_names[_curr_file_idx];  // Get next file name
     incremenet_read_ptr();
     _last_file_path = _last_id = file_path;
@@ -77,6 +77,11 @@ size_t FileSourceReader::open() {
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
+    return file_path;
+}
+
+size_t FileSourceReader::open() {
+    auto file_path = next_file_path();
 
     _current_fPtr = fopen(file_path.c_str(), "rb");  // Open the file,
 
@@ -106,7 +106,7 @@ void COCOFileSourceReader::incremenet_read_ptr() {
     increment_curr_file_idx(_file_names.size());
 }
 
-size_t COCOFileSourceReader::open() {
+std::string COCOFileSourceReader::next_file_path() {
     auto file_path = _file_names[_curr_file_idx];  // Get next file name
     incremenet_read_ptr();
     _last_id = file_path;
@@ -114,6 +114,11 @@ size_t COCOFileSourceReader::open() {
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
+    return file_path;
+}
+
+size_t COCOFileSourceReader::open() {
+    auto file_path = next_file_path();
 
 #if USE_STDIO_FILE
     _current_fPtr = fopen(file_path.c_str(), "rb");  // Open the file,
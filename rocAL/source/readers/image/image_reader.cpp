@@ -23,15 +23,19 @@ THE SOFTWARE.
 #include "readers/image/image_reader.h"
 
 void Reader::increment_curr_file_idx(size_t dataset_size) {
+    _curr_file_idx = next_file_idx(_curr_file_idx, dataset_size);
+}
+
+unsigned Reader::next_file_idx(unsigned file_idx, size_t dataset_size) const {
     // The condition satisfies for both pad_last_batch = True (or) False
     if (_stick_to_shard == false) {  // The elements of each shard rotate in a round-robin fashion once the elements in particular shard is exhausted
-        _curr_file_idx = (_curr_file_idx + 1) % dataset_size;
+        return (file_idx + 1) % dataset_size;
     } else {
-        if (_curr_file_idx >= _shard_start_idx_vector[_shard_id] &&
-            _curr_file_idx < _shard_end_idx_vector[_shard_id]) // checking if current-element lies within the shard size [begin_idx, last_idx -1]
-            _curr_file_idx = (_curr_file_idx + 1);
+        if (file_idx >= _shard_start_idx_vector[_shard_id] &&
+            file_idx < _shard_end_idx_vector[_shard_id]) // checking if current-element lies within the shard size [begin_idx, last_idx -1]
+            return file_idx + 1;
         else
-            _curr_file_idx = _shard_start_idx_vector[_shard_id];
+            return _shard_start_idx_vector[_shard_id];
     }
 }
 
@@ -81,7 +85,8 @@ size_t Reader::get_max_size_of_shard(size_t batch_size, bool loop) {
     return size;
 }
 
-void Reader::update_filenames_with_padding(std::vector<std::string> &file_names, size_t batch_size) {
+template <typename T>
+void Reader::update_filenames_with_padding(std::vector<T> &file_names, size_t batch_size) {
     // pad the last sample when the dataset_size is not divisible by
     // the number of shard's (or) when the shard's size is not
     // divisible by the batch size making each shard having equal
@@ -103,3 +108,6 @@ void Reader::update_filenames_with_padding(std::vector<std::string> &file_names,
         }
     }
 }
+
+template void Reader::update_filenames_with_padding<std::string>(std::vector<std::string> &file_names, size_t batch_size);
+template void Reader::update_filenames_with_padding<unsigned>(std::vector<unsigned> &file_names, size_t batch_size);
@@ -23,9 +23,11 @@ THE SOFTWARE.
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <fcntl.h>
 #include <numeric>
 #include <random>
 #include <math.h>
+#include <unistd.h>
 #include "pipeline/commons.h"
 #include "pipeline/filesystem.h"
 #include "readers/image/numpy_data_reader.h"
@@ -110,14 +112,8 @@ size_t NumpyDataReader::open() {
             return 0;
         }
         update_header_cache(file_path, _curr_file_header);
-    } else {
-        _current_file_ptr = std::fopen(file_path.c_str(), "rb");
-        if (_current_file_ptr == nullptr) {
-            ERR("Could not open file " + file_path + ": " + std::strerror(errno));
-            return 0;
-        }
     }
-    fseek(_current_file_ptr, 0, SEEK_SET);  // Take the file pointer back to the start
+    // The data is read through the file path, the file itself is only opened if read_data() is called
     return _curr_file_header.numpy_data_nbytes();  // Returns the numpy array data size (in bytes)
 }
 
@@ -239,11 +235,11 @@ void NumpyDataReader::parse_header_data(NumpyHeaderData& target, const std::stri
 
 void NumpyDataReader::parse_header(NumpyHeaderData& parsed_header, std::string file_path) {
     std::vector<char> token(HEADER_OFFSET + 1);  // Need to store 10 bytes of numpy header info and null termination character
-    _current_file_ptr = std::fopen(file_path.c_str(), "rb");
-    CHECK_CONDITION_AND_SET_FLAG(_current_file_ptr == nullptr, "Could not open file " + file_path + ": " + std::strerror(errno), void())
+    std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(file_path.c_str(), "rb"), std::fclose);
+    CHECK_CONDITION_AND_SET_FLAG(file == nullptr, "Could not open file " + file_path + ": " + std::strerror(errno), void())
 
     int64_t offset = HEADER_OFFSET;
-    int64_t n_read = std::fread(token.data(), 1, offset, _current_file_ptr);
+    int64_t n_read = std::fread(token.data(), 1, offset, file.get());
     // check if header is too short
     CHECK_CONDITION_AND_SET_FLAG(n_read != offset, "Can not read numpy header file contents", void())
     token[n_read] = '\0';
@@ -262,14 +258,14 @@ void NumpyDataReader::parse_header(NumpyHeaderData& parsed_header, std::string f
     CHECK_CONDITION_AND_SET_FLAG((header_len + 10) % 16 != 0, "Error extracting numpy header length", void())
 
     token.resize(header_len + 1);
-    CHECK_CONDITION_AND_SET_FLAG(std::fseek(_current_file_ptr, offset, SEEK_SET), "Seek operation failed in " + file_path + ": " + std::strerror(errno), void())
-    n_read = std::fread(token.data(), 1, header_len, _current_file_ptr);
+    CHECK_CONDITION_AND_SET_FLAG(std::fseek(file.get(), offset, SEEK_SET), "Seek operation failed in " + file_path + ": " + std::strerror(errno), void())
+    n_read = std::fread(token.data(), 1, header_len, file.get());
     CHECK_CONDITION_AND_SET_FLAG(n_read != header_len, "Can not read numpy header upto header_len", void())    
     token[header_len] = '\0';
     header = std::string(token.data());
     CHECK_CONDITION_AND_SET_FLAG(header.find('{') == std::string::npos, "Header is corrupted", void())
     offset += header_len;
-    CHECK_CONDITION_AND_SET_FLAG(std::fseek(_current_file_ptr, offset, SEEK_SET), "Seek operation failed in " + file_path + ": " + std::strerror(errno), void())
+    CHECK_CONDITION_AND_SET_FLAG(std::fseek(file.get(), offset, SEEK_SET), "Seek operation failed in " + file_path + ": " + std::strerror(errno), void())
 
     parse_header_data(parsed_header, header);
     if (_header_parsing_failed) return;
@@ -277,36 +273,111 @@ void NumpyDataReader::parse_header(NumpyHeaderData& parsed_header, std::string f
 }
 
 size_t NumpyDataReader::read_numpy_data(void* buf, size_t read_size, std::vector<unsigned>& strides_in_dims) {
-    if (!_current_file_ptr) {
-        ERR("Null file pointer");
-        return 0;
+    std::vector<unsigned> start, extent;
+    _curr_file_header.clamp_region({}, {}, start, extent);
+    return read_numpy_region(_last_file_path, _curr_file_header, buf, strides_in_dims, start, extent);
+}
+
+bool NumpyDataReader::pread_fully(int fd, unsigned char* buf, size_t size, size_t offset, const std::string& file_path) {
+    while (size > 0) {
+        auto ret = pread(fd, buf, size, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0) {
+            ERR("Could not read " + file_path + ": " + (ret < 0 ? std::strerror(errno) : "unexpected end of file"));
+            return false;
+        }
+        buf += ret;
+        size -= ret;
+        offset += ret;
     }
-    
-    auto shape = _curr_file_header.shape();
-    auto data_type_size = tensor_data_size(_curr_file_header.type());
-    if (std::fseek(_current_file_ptr, _curr_file_header.data_offset, SEEK_SET)) {
-        ERR("Seek operation failed for " + _last_file_path + ": " + std::strerror(errno));
+    return true;
+}
+
+size_t NumpyDataReader::read_numpy_region(const std::string& file_path, const NumpyHeaderData& header, void* buf, const std::vector<unsigned>& strides_in_dims,
+                                          const std::vector<unsigned>& start, const std::vector<unsigned>& extent) {
+    const auto& shape = header.array_shape;
+    const size_t num_dims = shape.size();
+    const size_t dtype_size = tensor_data_size(header.type());
+    if (start.size() != num_dims || extent.size() != num_dims || strides_in_dims.size() < num_dims + 1) {
+        ERR("Region of " + file_path + " does not match the " + TOSTR(num_dims) + " dimensions of the array");
         return 0;
     }
+    size_t region_size = 1;
+    for (size_t d = 0; d < num_dims; d++) {
+        if (start[d] + extent[d] > shape[d]) {
+            ERR("Region exceeds the array bounds in dimension " + TOSTR(d) + " of " + file_path);
+            return 0;
+        }
+        region_size *= extent[d];
+    }
+    if (region_size == 0)
+        return 0;
 
-    if (strides_in_dims[0] == _curr_file_header.size())
-        return std::fread((unsigned char*)buf, sizeof(unsigned char), _curr_file_header.numpy_data_nbytes(), _current_file_ptr);
-    else
-        return parse_numpy_data((unsigned char*)buf, strides_in_dims, shape, data_type_size);
-}
-
-size_t NumpyDataReader::parse_numpy_data(unsigned char* buf, std::vector<unsigned>& strides_in_dims, std::vector<unsigned>& shapes, size_t dtype_size, unsigned dim) {
-    if (dim == (shapes.size() - 1)) {
-        auto actual_read_size = std::fread(buf, sizeof(unsigned char), shapes[dim] * dtype_size, _current_file_ptr);
-        return actual_read_size;
+    // Element strides of each dimension in the file, strides_in_dims[d + 1] is the one of the destination
+    std::vector<size_t> file_strides(num_dims + 1, 1);
+    for (int d = static_cast<int>(num_dims) - 1; d >= 0; d--)
+        file_strides[d] = file_strides[d + 1] * shape[d];
+
+    // Dimensions from copy_dim on are contiguous both in the file and in buf, they are copied as one run
+    size_t copy_dim = num_dims ? num_dims - 1 : 0;
+    while (copy_dim > 0 && extent[copy_dim] == shape[copy_dim] && strides_in_dims[copy_dim] == extent[copy_dim] * strides_in_dims[copy_dim + 1])
+        copy_dim--;
+    const size_t run_bytes = (num_dims ? extent[copy_dim] * file_strides[copy_dim + 1] : 1) * dtype_size;
+    const size_t run_count = region_size * dtype_size / run_bytes;
+
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ERR("Could not open file " + file_path + ": " + std::strerror(errno));
+        return 0;
     }
-    unsigned char* startPtr = buf;
+    // Runs which follow each other in the file are fetched by a single read into a staging buffer and scattered from there,
+    // this happens when only the destination is padded, e.g. arrays smaller than the output tensor
+    std::vector<unsigned char> staging;
+    std::vector<unsigned char*> pending_dst;
+    size_t pending_offset = 0;
+    auto flush = [&]() {
+        if (pending_dst.empty())
+            return true;
+        bool ok;
+        if (pending_dst.size() == 1) {
+            ok = pread_fully(fd, pending_dst[0], run_bytes, pending_offset, file_path);
+        } else {
+            staging.resize(pending_dst.size() * run_bytes);
+            ok = pread_fully(fd, staging.data(), staging.size(), pending_offset, file_path);
+            for (size_t i = 0; ok && i < pending_dst.size(); i++)
+                memcpy(pending_dst[i], staging.data() + i * run_bytes, run_bytes);
+        }
+        pending_dst.clear();
+        return ok;
+    };
+
+    const size_t max_pending = std::max<size_t>(1, STAGING_BUFFER_SIZE / run_bytes);
+    std::vector<unsigned> idx(num_dims, 0);  // Position of the current run inside the region, only the dimensions before copy_dim advance
     size_t read_size = 0;
-    for (unsigned d = 0; d < shapes[dim]; d++) {
-        read_size += parse_numpy_data(startPtr, strides_in_dims, shapes, dtype_size, dim + 1);
-        startPtr += (strides_in_dims[dim + 1] * dtype_size);
+    bool ok = true;
+    for (size_t run = 0; ok && run < run_count; run++) {
+        size_t file_offset = 0, dst_offset = 0;
+        for (size_t d = 0; d < num_dims; d++) {
+            file_offset += (start[d] + idx[d]) * file_strides[d + 1];
+            dst_offset += idx[d] * strides_in_dims[d + 1];
+        }
+        file_offset = header.data_offset + file_offset * dtype_size;
+        if (!pending_dst.empty() && (file_offset != pending_offset + pending_dst.size() * run_bytes || pending_dst.size() == max_pending))
+            ok = flush();
+        if (pending_dst.empty())
+            pending_offset = file_offset;
+        pending_dst.push_back(static_cast<unsigned char*>(buf) + dst_offset * dtype_size);
+        read_size += run_bytes;
+        for (int d = static_cast<int>(copy_dim) - 1; d >= 0; d--) {
+            if (++idx[d] < extent[d])
+                break;
+            idx[d] = 0;
+        }
     }
-    return read_size;
+    ok = ok && flush();
+    ::close(fd);
+    return ok ? read_size : 0;
 }
 
 const NumpyHeaderData NumpyDataReader::get_numpy_header_data() {
@@ -314,8 +385,10 @@ const NumpyHeaderData NumpyDataReader::get_numpy_header_data() {
 }
 
 size_t NumpyDataReader::read_data(unsigned char* buf, size_t read_size) {
-    if (!_current_file_ptr)
+    if (!_current_file_ptr && !(_current_file_ptr = std::fopen(_last_file_path.c_str(), "rb"))) {
+        ERR("Could not open file " + _last_file_path + ": " + std::strerror(errno));
         return 0;
+    }
 
     size_t actual_read_size = fread(buf, sizeof(unsigned char), read_size, _current_file_ptr);
     return actual_read_size;
@@ -0,0 +1,326 @@
+/*
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "readers/image/tf_record_index.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "pipeline/commons.h"
+#include "pipeline/cpu_features.h"
+#if SIMD_X86
+#include <nmmintrin.h>
+#endif
+
+constexpr char TFRecordIndex::INDEX_MAGIC[8];
+
+namespace {
+// Protobuf wire format walker, only the length delimited fields are returned, the other fields are skipped
+enum WireType { VARINT = 0, FIXED64 = 1, LENGTH_DELIMITED = 2, FIXED32 = 5 };
+
+bool read_varint(const unsigned char *&ptr, const unsigned char *end, uint64_t &value) {
+    value = 0;
+    for (unsigned shift = 0; ptr < end && shift < 64; shift += 7) {
+        unsigned char byte = *ptr++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+//! Advances ptr to the next length delimited field, returns false at the end of the message or if it is malformed
+bool next_length_delimited_field(const unsigned char *&ptr, const unsigned char *end, uint64_t &field_number,
+                                 const unsigned char *&value, uint64_t &value_size) {
+    while (ptr < end) {
+        uint64_t tag, skipped;
+        if (!read_varint(ptr, end, tag))
+            return false;
+        switch (tag & 0x7) {
+            case VARINT:
+                if (!read_varint(ptr, end, skipped)) return false;
+                break;
+            case FIXED64:
+                ptr += 8;
+                break;
+            case FIXED32:
+                ptr += 4;
+                break;
+            case LENGTH_DELIMITED:
+                if (!read_varint(ptr, end, value_size) || value_size > static_cast<uint64_t>(end - ptr))
+                    return false;
+                field_number = tag >> 3;
+                value = ptr;
+                ptr += value_size;
+                return true;
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+uint32_t crc32c_table_entry(uint32_t index) {
+    uint32_t crc = index;
+    for (int bit = 0; bit < 8; bit++)
+        crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    return crc;
+}
+
+#if SIMD_X86
+SIMD_TARGET_SSE42 uint32_t crc32c_sse42(uint32_t crc, const unsigned char *data, size_t size) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    for (; size; size--, data++)
+        crc = _mm_crc32_u8(crc, *data);
+    return crc;
+}
+#endif
+
+uint32_t crc32c(const unsigned char *data, size_t size) {
+    uint32_t crc = 0xFFFFFFFF;
+#if SIMD_X86
+    if (cpu_isa_level() >= CpuIsaLevel::SSE42)
+        return crc32c_sse42(crc, data, size) ^ 0xFFFFFFFF;
+#endif
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; i++)
+            entries[i] = crc32c_table_entry(i);
+        return entries;
+    }();
+    for (; size; size--, data++)
+        crc = table[(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+}
+}  // namespace
+
+bool tf_example_find_bytes_feature(const unsigned char *example, size_t example_size, const std::string &key,
+                                   const unsigned char *&value, size_t &value_size) {
+    // Example { Features features = 1; }  Features { map<string, Feature> feature = 1; }  map entry { key = 1; value = 2; }
+    // Feature { oneof { BytesList bytes_list = 1; ... } }  BytesList { repeated bytes value = 1; }
+    const unsigned char *example_ptr = example, *example_end = example + example_size;
+    const unsigned char *features;
+    uint64_t field, features_size;
+    while (next_length_delimited_field(example_ptr, example_end, field, features, features_size)) {
+        if (field != 1) continue;
+        const unsigned char *features_ptr = features, *features_end = features + features_size, *map_entry;
+        uint64_t map_entry_size;
+        while (next_length_delimited_field(features_ptr, features_end, field, map_entry, map_entry_size)) {
+            if (field != 1) continue;
+            const unsigned char *entry_ptr = map_entry, *entry_end = map_entry + map_entry_size, *entry_value;
+            const unsigned char *feature = nullptr;
+            uint64_t entry_value_size, feature_size = 0;
+            bool key_matches = false;
+            while (next_length_delimited_field(entry_ptr, entry_end, field, entry_value, entry_value_size)) {
+                if (field == 1) {
+                    key_matches = entry_value_size == key.size() && memcmp(entry_value, key.data(), key.size()) == 0;
+                } else if (field == 2) {
+                    feature = entry_value;
+                    feature_size = entry_value_size;
+                }
+            }
+            if (!key_matches || !feature) continue;
+            const unsigned char *feature_ptr = feature, *feature_end = feature + feature_size, *bytes_list;
+            uint64_t bytes_list_size;
+            while (next_length_delimited_field(feature_ptr, feature_end, field, bytes_list, bytes_list_size)) {
+                if (field != 1) continue;
+                const unsigned char *list_ptr = bytes_list, *list_end = bytes_list + bytes_list_size, *bytes;
+                uint64_t bytes_size;
+                while (next_length_delimited_field(list_ptr, list_end, field, bytes, bytes_size)) {
+                    if (field != 1) continue;
+                    value = bytes;
+                    value_size = bytes_size;
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+uint32_t tf_record_masked_crc(const unsigned char *data, size_t size) {
+    uint32_t crc = crc32c(data, size);
+    return ((crc >> 15) | (crc << 17)) + 0xa282ead8ul;
+}
+
+TFRecordIndex::TFRecordIndex(const std::string &index_path, const std::string &feature_keys) : _index_path(index_path), _feature_keys(feature_keys) {
+    load();
+}
+
+bool TFRecordIndex::stamp(const std::string &file_path, FileStamp &file_stamp) {
+    struct stat file_stat;
+    if (stat(file_path.c_str(), &file_stat) != 0)
+        return false;
+    file_stamp.mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+    file_stamp.size = file_stat.st_size;
+    return true;
+}
+
+const std::vector<TFRecordEntry> *TFRecordIndex::lookup(const std::string &file_path, const FileStamp &file_stamp) const {
+    auto it = _files.find(file_path);
+    if (it == _files.end() || !(it->second.file_stamp == file_stamp))
+        return nullptr;
+    return &it->second.records;
+}
+
+void TFRecordIndex::insert(const std::string &file_path, const FileStamp &file_stamp, std::vector<TFRecordEntry> records) {
+    auto &file = _files[file_path];
+    file.file_stamp = file_stamp;
+    file.records = std::move(records);
+    _modified = true;
+}
+
+namespace {
+template <typename T>
+void read_value(std::ifstream &file, T &value) { file.read(reinterpret_cast<char *>(&value), sizeof(value)); }
+template <typename T>
+void write_value(std::ofstream &file, const T &value) { file.write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+// The counts and lengths read from the index are checked against the bytes left in the file before anything is allocated for them,
+// a corrupted index fails the stream instead of requesting a huge allocation
+bool check_remaining(std::ifstream &file, uint64_t file_size, uint64_t count, uint64_t min_item_size) {
+    auto position = file.tellg();
+    if (!file || position < 0 || count > (file_size - static_cast<uint64_t>(position)) / min_item_size) {
+        file.setstate(std::ios::failbit);
+        return false;
+    }
+    return true;
+}
+void read_string(std::ifstream &file, uint64_t file_size, std::string &value) {
+    uint32_t length = 0;
+    read_value(file, length);
+    if (!check_remaining(file, file_size, length, 1)) return;
+    value.resize(length);
+    file.read(&value[0], length);
+}
+void write_string(std::ofstream &file, const std::string &value) {
+    write_value(file, static_cast<uint32_t>(value.size()));
+    file.write(value.data(), value.size());
+}
+}  // namespace
+
+void TFRecordIndex::load() {
+    if (_index_path.empty())
+        return;
+    std::ifstream index_file(_index_path, std::ios::binary | std::ios::ate);
+    if (!index_file)
+        return;
+    const uint64_t file_size = index_file.tellg();
+    index_file.seekg(0);
+    char magic[sizeof(INDEX_MAGIC)];
+    uint32_t version = 0;
+    uint64_t file_count = 0;
+    std::string feature_keys;
+    index_file.read(magic, sizeof(magic));
+    read_value(index_file, version);
+    if (!index_file || memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || version != INDEX_VERSION) {
+        WRN("TFRecordIndex: Ignoring invalid index file " + _index_path)
+        return;
+    }
+    read_string(index_file, file_size, feature_keys);
+    read_value(index_file, file_count);
+    if (!index_file || feature_keys != _feature_keys)
+        return;  // Indexed with other feature keys, every file is rescanned
+    // Smallest sizes of a file entry (path length, stamp and record count) and of a record entry (offsets, sizes and name length)
+    constexpr uint64_t MIN_FILE_ENTRY_SIZE = sizeof(uint32_t) + sizeof(FileStamp::mtime_ns) + sizeof(FileStamp::size) + sizeof(uint64_t);
+    constexpr uint64_t MIN_RECORD_ENTRY_SIZE = 4 * sizeof(uint64_t) + sizeof(uint32_t);
+    check_remaining(index_file, file_size, file_count, MIN_FILE_ENTRY_SIZE);
+    std::string file_path;
+    for (uint64_t i = 0; i < file_count; i++) {
+        FileRecords file;
+        uint64_t record_count = 0;
+        read_string(index_file, file_size, file_path);
+        read_value(index_file, file.file_stamp.mtime_ns);
+        read_value(index_file, file.file_stamp.size);
+        read_value(index_file, record_count);
+        if (!check_remaining(index_file, file_size, record_count, MIN_RECORD_ENTRY_SIZE)) break;
+        file.records.resize(record_count);
+        for (auto &record : file.records) {
+            read_value(index_file, record.record_offset);
+            read_value(index_file, record.data_length);
+            read_value(index_file, record.encoded_offset);
+            read_value(index_file, record.encoded_size);
+            read_string(index_file, file_size, record.name);
+        }
+        if (!index_file) break;
+        _files.emplace(file_path, std::move(file));
+    }
+    if (!index_file) {
+        WRN("TFRecordIndex: Index file " + _index_path + " is truncated or corrupted, rebuilding it")
+        _files.clear();
+    }
+}
+
+void TFRecordIndex::save() {
+    if (_index_path.empty() || !_modified)
+        return;
+    // Write to a temporary file first so concurrent jobs never read a partially written index
+    std::string tmp_path = _index_path + ".tmp" + TOSTR(getpid());
+    {
+        std::ofstream index_file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!index_file) {
+            WRN("TFRecordIndex: Cannot write the index file " + _index_path)
+            return;
+        }
+        index_file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        write_value(index_file, INDEX_VERSION);
+        write_string(index_file, _feature_keys);
+        write_value(index_file, static_cast<uint64_t>(_files.size()));
+        for (auto &it : _files) {
+            write_string(index_file, it.first);
+            write_value(index_file, it.second.file_stamp.mtime_ns);
+            write_value(index_file, it.second.file_stamp.size);
+            write_value(index_file, static_cast<uint64_t>(it.second.records.size()));
+            for (auto &record : it.second.records) {
+                write_value(index_file, record.record_offset);
+                write_value(index_file, record.data_length);
+                write_value(index_file, record.encoded_offset);
+                write_value(index_file, record.encoded_size);
+                write_string(index_file, record.name);
+            }
+        }
+        if (!index_file) {
+            WRN("TFRecordIndex: Failed writing the index file " + _index_path)
+            index_file.close();
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), _index_path.c_str()) != 0) {
+        WRN("TFRecordIndex: Cannot replace the index file " + _index_path)
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    _modified = false;
+}
@@ -20,22 +20,41 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+
 #include "readers/image/tf_record_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "pipeline/thread_pool.h"
+
+// Name of the record index kept next to the record folder, the folder itself only holds record files
+static const char *TF_RECORD_INDEX_SUFFIX = ".rocal_tfrecord.idx";
+
+static std::string record_index_path(std::string folder_path) {
+    while (folder_path.size() > 1 && folder_path.back() == '/')
+        folder_path.pop_back();
+    auto separator = folder_path.find_last_of('/');
+    if (separator == std::string::npos)
+        return "." + folder_path + TF_RECORD_INDEX_SUFFIX;
+    return folder_path.substr(0, separator + 1) + "." + folder_path.substr(separator + 1) + TF_RECORD_INDEX_SUFFIX;
+}
+
 TFRecordReader::TFRecordReader() {
-    _src_dir = nullptr;
     _sub_dir = nullptr;
     _entity = nullptr;
     _curr_file_idx = 0;
-    _current_file_size = 0;
     _loop = false;
     _shuffle = false;
     _file_id = 0;
-    _last_rec = false;
     _record_name_prefix = "";
     _file_count_all_shards = 0;
 }
@@ -58,6 +77,7 @@ Reader::Status TFRecordReader::initialize(ReaderConfig desc) {
     _pad_last_batch_repeated = _sharding_info.pad_last_batch_repeated;
     _stick_to_shard = _sharding_info.stick_to_shard;
     _shard_size = _sharding_info.shard_size;
+    _num_threads = std::max<size_t>(desc.get_cpu_num_threads(), 1);
     ret = folder_reading();
     // shuffle dataset if set
     if (ret == Reader::Status::OK && _shuffle)
@@ -70,6 +90,14 @@ void TFRecordReader::incremenet_read_ptr() {
     _read_counter++;
     increment_curr_file_idx(_file_names.size());
 }
+
+TFRecordReader::Record &TFRecordReader::current_record() {
+    auto it = _record_idx.find(_file_names[_curr_file_idx]);
+    if (it == _record_idx.end())
+        THROW("ERROR: Given name not present in the map" + _file_names[_curr_file_idx])
+    return _records[it->second];
+}
+
 size_t TFRecordReader::open() {
     auto file_path = _file_names[_curr_file_idx];  // Get next file name
     _last_id = file_path;
@@ -77,16 +105,35 @@ size_t TFRecordReader::open() {
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
-    _current_file_size = _file_size[_file_names[_curr_file_idx]];
-    return _current_file_size;
+    return current_record().entry.encoded_size;
 }
 
-size_t TFRecordReader::read_data(unsigned char *buf, size_t read_size) {
-    auto ret = read_image(buf, _file_names[_curr_file_idx], _file_size[_file_names[_curr_file_idx]]);
-    if (ret != Reader::Status::OK)
-        THROW("TFRecordReader: Error in reading TF records");
+unsigned char *TFRecordReader::mapped_data(size_t &size) {
+    auto &record = current_record();
+    check_record_crc(record);
+    size = record.entry.encoded_size;
     incremenet_read_ptr();
-    return read_size;
+    return _record_files[record.file_idx].data + record.entry.encoded_offset;
+}
+
+size_t TFRecordReader::read_data(unsigned char *buf, size_t read_size) {
+    size_t size;
+    auto data = mapped_data(size);
+    size = std::min(size, read_size);
+    memcpy(buf, data, size);
+    return size;
+}
+
+void TFRecordReader::check_record_crc(Record &record) {
+    if (record.crc_checked)
+        return;
+    auto &record_file = _record_files[record.file_idx];
+    const unsigned char *example = record_file.data + record.entry.record_offset + sizeof(uint64_t) + sizeof(uint32_t);
+    uint32_t data_crc;
+    memcpy(&data_crc, example + record.entry.data_length, sizeof(data_crc));
+    if (tf_record_masked_crc(example, record.entry.data_length) != data_crc)
+        THROW("TFRecordReader: Corrupted record at offset " + std::to_string(record.entry.record_offset) + " of " + record_file.path)
+    record.crc_checked = true;
 }
 
 int TFRecordReader::close() {
@@ -94,7 +141,9 @@ int TFRecordReader::close() {
 }
 
 TFRecordReader::~TFRecordReader() {
-    release();
+    for (auto &record_file : _record_files)
+        munmap(record_file.data, record_file.size);
+    _record_files.clear();
 }
 
 int TFRecordReader::release() {
@@ -114,6 +163,66 @@ void TFRecordReader::reset() {
     }
 }
 
+bool TFRecordReader::map_record_file(const std::string &file_path) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    // Private writable mapping: the decoders get non const pointers, a write would only touch a private copy of the page
+    MappedRecordFile record_file;
+    record_file.path = file_path;
+    record_file.size = file_stat.st_size;
+    void *address = mmap(nullptr, record_file.size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED)
+        return false;
+    record_file.data = static_cast<unsigned char *>(address);
+    if (_shuffle)
+        madvise(address, record_file.size, MADV_RANDOM);
+    _record_files.push_back(record_file);
+    return true;
+}
+
+std::vector<TFRecordEntry> TFRecordReader::scan_record_file(const MappedRecordFile &record_file) {
+    // Record layout: uint64 length, uint32 masked crc of length, data[length], uint32 masked crc of data
+    std::vector<TFRecordEntry> records;
+    size_t offset = 0;
+    while (offset < record_file.size) {
+        uint64_t data_length;
+        uint32_t length_crc;
+        if (record_file.size - offset < sizeof(data_length) + sizeof(length_crc))
+            THROW("TFRecordReader: Error in reading TF records, truncated record header in " + record_file.path)
+        memcpy(&data_length, record_file.data + offset, sizeof(data_length));
+        memcpy(&length_crc, record_file.data + offset + sizeof(data_length), sizeof(length_crc));
+        if (tf_record_masked_crc(record_file.data + offset, sizeof(data_length)) != length_crc)
+            THROW("TFRecordReader: Corrupted record length at offset " + std::to_string(offset) + " of " + record_file.path)
+        if (data_length > record_file.size - offset - 2 * sizeof(uint32_t) - sizeof(data_length))
+            THROW("TFRecordReader: Error in reading TF records, truncated record in " + record_file.path)
+        const unsigned char *example = record_file.data + offset + sizeof(data_length) + sizeof(length_crc);
+        const unsigned char *value;
+        size_t value_size;
+        TFRecordEntry entry;
+        entry.record_offset = offset;
+        entry.data_length = data_length;
+        if (!tf_example_find_bytes_feature(example, data_length, _encoded_key, value, value_size))
+            THROW("TFRecordReader: Feature " + _encoded_key + " not found in record at offset " + std::to_string(offset) + " of " + record_file.path)
+        entry.encoded_offset = value - record_file.data;
+        entry.encoded_size = value_size;
+        if (!_filename_key.empty()) {
+            if (!tf_example_find_bytes_feature(example, data_length, _filename_key, value, value_size))
+                THROW("TFRecordReader: Feature " + _filename_key + " not found in record at offset " + std::to_string(offset) + " of " + record_file.path)
+            entry.name.assign(reinterpret_cast<const char *>(value), value_size);
+        }
+        records.push_back(std::move(entry));
+        offset += sizeof(data_length) + sizeof(length_crc) + data_length + sizeof(uint32_t);
+    }
+    return records;
+}
+
 Reader::Status TFRecordReader::folder_reading() {
     if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
         THROW("FileReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _folder_path);
@@ -126,19 +235,59 @@ Reader::Status TFRecordReader::folder_reading() {
         if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
             continue;
         entry_name_list.push_back(entry_name);
-        // std::cerr<<"\n entry_name::"<<entry_name;
     }
+    closedir(_sub_dir);
     std::sort(entry_name_list.begin(), entry_name_list.end());
     for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
-        std::string subfolder_path = _full_path + "/" + entry_name_list[dir_count];
-        _folder_path = subfolder_path;
-        if (tf_record_reader() != Reader::Status::OK)
-            WRN("FileReader ShardID [" + TOSTR(_shard_id) + "] File reader cannot access the storage at " + _folder_path);
+        std::string record_path = _full_path + "/" + entry_name_list[dir_count];
+        // if _record_name_prefix is specified, read only the records with prefix
+        if (!_record_name_prefix.empty() && record_path.find(_record_name_prefix) == std::string::npos)
+            continue;
+        if (!map_record_file(record_path))
+            WRN("FileReader ShardID [" + TOSTR(_shard_id) + "] File reader cannot access the storage at " + record_path);
     }
 
+    // The record files are scanned in parallel, the ones which did not change since the last run are taken from the index
+    TFRecordIndex index(record_index_path(_full_path), _encoded_key + "\n" + _filename_key);
+    std::vector<std::vector<TFRecordEntry>> file_records(_record_files.size());
+    std::vector<TFRecordIndex::FileStamp> file_stamps(_record_files.size());
+    std::vector<char> scanned(_record_files.size(), 0);
+    if (!_record_files.empty()) {
+        ThreadPool scan_pool(std::min(_num_threads, _record_files.size()));
+        std::vector<std::shared_future<void>> scans;
+        for (size_t i = 0; i < _record_files.size(); i++) {
+            scans.push_back(scan_pool.submit([&, i]() {
+                auto &record_file = _record_files[i];
+                auto indexed = TFRecordIndex::stamp(record_file.path, file_stamps[i]) ? index.lookup(record_file.path, file_stamps[i]) : nullptr;
+                if (indexed) {
+                    file_records[i] = *indexed;
+                } else {
+                    file_records[i] = scan_record_file(record_file);
+                    scanned[i] = 1;
+                }
+            }));
+        }
+        for (auto &scan : scans)
+            scan.get();  // Rethrows the errors of the scans
+    }
+    for (size_t i = 0; i < _record_files.size(); i++) {
+        if (scanned[i])
+            index.insert(_record_files[i].path, file_stamps[i], file_records[i]);
+        for (auto &entry : file_records[i]) {
+            // generate filename based on file_id when the records have no file name
+            std::string file_path = _record_files[i].path + "/" + (_filename_key.empty() ? std::to_string(_file_id++) : entry.name);
+            _record_idx.emplace(file_path, _records.size());
+            _records.push_back({static_cast<unsigned>(i), std::move(entry)});
+            _file_names.push_back(file_path);
+            _file_count_all_shards++;
+        }
+    }
+    index.save();
+
     if (!_file_names.empty())
         LOG("FileReader ShardID [" + TOSTR(_shard_id) + "] Total of " + TOSTR(_file_names.size()) + " images loaded from " + _full_path)
-    closedir(_sub_dir);
+    else
+        THROW("TFRecordReader: No records found in " + _full_path)
 
     size_t padded_samples = ((_shard_size > 0) ? _shard_size : largest_shard_size_without_padding()) % _batch_size;
     _last_batch_padded_size = ((_batch_size > 1) && (padded_samples > 0)) ? (_batch_size - padded_samples) : 0;
@@ -147,131 +296,6 @@ Reader::Status TFRecordReader::folder_reading() {
     if (_pad_last_batch_repeated == true) {
         update_filenames_with_padding(_file_names, _batch_size);
     }
-    _last_file_name = _file_names[_file_names.size() - 1];
-    _last_file_size = _file_size[_last_file_name];
     compute_start_and_end_idx_of_all_shards();
     return ret;
 }
-
-Reader::Status TFRecordReader::tf_record_reader() {
-    std::string fname = _folder_path;
-    // if _record_name_prefix is specified, read only the records with prefix
-    if (_record_name_prefix.empty() || fname.find(_record_name_prefix) != std::string::npos) {
-        uint file_size;
-        std::ifstream file_contents(fname.c_str(), std::ios::binary);
-        if (!file_contents)
-            THROW("TFRecordReader: Failed to open file " + fname);
-        file_contents.seekg(0, std::ifstream::end);
-        file_size = file_contents.tellg();
-        // std::cerr<<"\n length of the file:: "<<length<<std::endl;
-        file_contents.seekg(0, std::ifstream::beg);
-        auto ret = read_image_names(file_contents, file_size);
-        if (ret != Reader::Status::OK)
-            THROW("TFRecordReader: Error in reading TF records");
-        _last_rec = false;
-        if (_file_names.size() != _file_size.size())
-            std::cerr << "\n Size of vectors are not same";
-        file_contents.close();
-    }
-    return Reader::Status::OK;
-}
-
-
-Reader::Status TFRecordReader::read_image_names(std::ifstream &file_contents, uint file_size) {
-    auto ret = Reader::Status::OK;
-    while (!_last_rec) {
-        uint length;
-        uint64_t data_length;
-        uint32_t length_crc, data_crc;
-
-        length = file_contents.tellg();
-        file_contents.read((char *)&data_length, sizeof(data_length));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        file_contents.read((char *)&length_crc, sizeof(length_crc));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        if (uint(length + data_length + 16) == file_size) {
-            _last_rec = true;
-        }
-        std::unique_ptr<char[]> data(new char[data_length]);
-        file_contents.read(data.get(), data_length);
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        _single_example.ParseFromArray(data.get(), data_length);
-        _features = _single_example.features();
-        auto feature = _features.feature();
-        std::string file_path = _folder_path;
-        std::string fname;
-        if (!_filename_key.empty()) {
-            _single_feature = feature.at(_filename_key);
-            fname = _single_feature.bytes_list().value()[0];
-            file_path.append("/");
-            file_path.append(fname);
-        } else {
-            // generate filename based on file_id
-            fname = std::to_string(_file_id);
-            file_path.append("/");
-            file_path.append(fname);
-        }
-        _image_record_starting.insert(std::pair<std::string, uint>(fname, length));
-        _last_file_name = file_path;
-        _file_names.push_back(file_path);
-        _file_count_all_shards++;
-        _single_feature = feature.at(_encoded_key);
-        _last_file_size = _single_feature.bytes_list().value()[0].size();
-        _file_size.insert(std::pair<std::string, unsigned int>(_last_file_name, _last_file_size));
-        file_contents.read((char *)&data_crc, sizeof(data_crc));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-    }
-    return ret;
-}
-
-Reader::Status TFRecordReader::read_image(unsigned char *buff, std::string file_name, uint file_size) {
-    auto ret = Reader::Status::OK;
-    std::string temp = file_name.substr(0, file_name.find_last_of("\\/"));
-    const size_t last_slash_idx = file_name.find_last_of("\\/");
-    if (std::string::npos != last_slash_idx) {
-        file_name.erase(0, last_slash_idx + 1);
-    }
-    std::ifstream file_contents(temp.c_str(), std::ios::binary);
-    if (!file_contents)
-        THROW("TFRecordReader: Failed to open file " + file_name);
-    auto it = _image_record_starting.find(file_name);
-    if (_image_record_starting.end() == it) {
-        THROW("ERROR: Given name not present in the map" + file_name)
-    }
-    // std::cerr<<"\n image present at loc:: "<<it->second;
-    file_contents.seekg(it->second, std::ifstream::beg);
-    uint64_t data_length;
-    uint32_t length_crc, data_crc;
-    file_contents.read((char *)&data_length, sizeof(data_length));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.read((char *)&length_crc, sizeof(length_crc));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    std::unique_ptr<char[]> data(new char[data_length]);
-    file_contents.read(data.get(), data_length);
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    _single_example.ParseFromArray(data.get(), data_length);
-    _features = _single_example.features();
-    auto feature = _features.feature();
-    std::string fname;
-    if (!_filename_key.empty()) {
-        _single_feature = feature.at(_filename_key);
-        fname = _single_feature.bytes_list().value()[0];
-    }
-    // if _filename key is empty, just read the encoded/raw feature
-    if (_filename_key.empty() || (fname == file_name)) {
-        _single_feature = feature.at(_encoded_key);
-        memcpy(buff, _single_feature.bytes_list().value()[0].c_str(), _single_feature.bytes_list().value()[0].size());
-    }
-    file_contents.read((char *)&data_crc, sizeof(data_crc));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.close();
-    return ret;
-}
@@ -23,23 +23,14 @@ THE SOFTWARE.
 
 #ifdef ENABLE_WDS
 #include "readers/webdataset_source_reader.h"
-#include <cassert>
+#include "pipeline/thread_pool.h"
+#include <fcntl.h>
+#include <unistd.h>
 
-using namespace std;
-
-#define BLOCKSIZE 10240
+#include <cerrno>
+#include <cstring>
 
-constexpr int create_version_number(int major, int minor, int patch = 0) {
-  if (major < 0 || minor < 0 || patch < 0) {
-    return -1;
-  }
-    return major * 1000 + minor * 10 + patch;
-}
-
-inline std::tuple<std::string, std::string> split_name(const std::string& file_path) {
-  size_t dot_pos = file_path.find('.', file_path.rfind('/') + 1);
-  return {file_path.substr(0, dot_pos), file_path.substr(dot_pos + 1)};
-}
+using namespace std;
 
 WebDatasetSourceReader::WebDatasetSourceReader() {
     _curr_file_idx = 0;
@@ -54,7 +45,6 @@ Reader::Status WebDatasetSourceReader::initialize(ReaderConfig desc) {
     _folder_path = desc.path();
     _path = desc.path();
     _index_paths = desc.index_path();
-    _wds_shards.reserve(_path.size());
     _shard_id = desc.get_shard_id();
     _shard_count = desc.get_shard_count();
     _batch_size = desc.get_batch_size();
@@ -65,55 +55,187 @@ Reader::Status WebDatasetSourceReader::initialize(ReaderConfig desc) {
     _stick_to_shard = _sharding_info.stick_to_shard;
     _shard_size = _sharding_info.shard_size;
     _shuffle = desc.shuffle();
+    _shuffle_buffer_size = desc.get_shuffle_buffer_size();
+    _num_threads = std::max<size_t>(desc.get_cpu_num_threads(), 1);
+    _max_open_files = desc.get_max_open_files() ? desc.get_max_open_files() : DEFAULT_MAX_OPEN_FILES;
+    _stream_rng.seed(desc.seed());
     ret = folder_reading();
     _curr_file_idx = _shard_start_idx_vector[_shard_id]; // shard's start_idx would vary for every shard in the vector
-    // shuffle dataset if set
-    if (ret == Reader::Status::OK && _shuffle)
-        std::random_shuffle(_file_names.begin() + _shard_start_idx_vector[_shard_id],
-                            _file_names.begin() + _shard_end_idx_vector[_shard_id]);
+    // shuffle dataset if set, the streaming mode keeps the tar order and shuffles within its window instead
+    if (ret == Reader::Status::OK && _shuffle && !_shuffle_buffer_size)
+        std::random_shuffle(_sample_ids.begin() + _shard_start_idx_vector[_shard_id],
+                            _sample_ids.begin() + _shard_end_idx_vector[_shard_id]);
+    if (ret == Reader::Status::OK && _shuffle_buffer_size) {
+        _stream_capacity = (_shuffle ? _shuffle_buffer_size : 1) + STREAM_READ_AHEAD;
+        start_streaming();
+    }
     return ret;
 }
 
 void WebDatasetSourceReader::incremenet_read_ptr() {
     _read_counter++;
-    increment_curr_file_idx(_file_names.size());
+    increment_curr_file_idx(_sample_ids.size());
 }
 
 size_t WebDatasetSourceReader::open() {
-    auto file_path = _file_names[_curr_file_idx];  // Get next file name
-    _last_id = file_path;
+    const SampleEntry &sample = _shuffle_buffer_size ? next_streamed_sample() : _samples[_sample_ids[_curr_file_idx]];
+    _last_id = sample.file_path;
     auto last_slash_idx = _last_id.find_last_of("\\/");
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
-    _current_file_size = _file_size[_file_names[_curr_file_idx]];
+    _current_file_size = sample.size;
     return _current_file_size;
 }
 
 size_t WebDatasetSourceReader::read_data(unsigned char* buf, size_t read_size) {
-    auto ret = read_web_dataset_at_offset(buf, _file_names[_curr_file_idx], _file_size[_file_names[_curr_file_idx]], _file_offset[_file_names[_curr_file_idx]], _file_wds_shard_idx_mapping[_file_names[_curr_file_idx]]);
-    if (ret != Reader::Status::OK)
-        THROW("WebDatasetSourceReader: Error in reading tar records of the web  dataset reader");
+    if (_shuffle_buffer_size) {
+        read_size = std::min(read_size, _samples[_current_sample.sample_id].size);
+        memcpy(buf, _current_sample.chunk.get() + _current_sample.chunk_offset, read_size);
+        _current_sample.chunk.reset();  // The chunk is freed once its last sample has been read
+    } else {
+        auto ret = read_web_dataset_at_offset(buf, _samples[_sample_ids[_curr_file_idx]]);
+        if (ret != Reader::Status::OK)
+            THROW("WebDatasetSourceReader: Error in reading tar records of the web  dataset reader");
+    }
     incremenet_read_ptr();
     return read_size;
 }
 
+const WebDatasetSourceReader::SampleEntry &WebDatasetSourceReader::next_streamed_sample() {
+    // The window shrinks at the end of an epoch, so an epoch serves the same samples as the sequential order
+    size_t window = _shuffle ? _shuffle_buffer_size : 1;
+    if (!_loop)
+        window = std::min<size_t>(window, std::max(count_items(), 1u));
+    std::unique_lock<std::mutex> lock(_stream_mutex);
+    _stream_filled.wait(lock, [this, window] { return _stream_queue.size() >= window || _stream_error; });
+    if (_stream_queue.size() < window)
+        std::rethrow_exception(_stream_error);
+    size_t pick = std::uniform_int_distribution<size_t>(0, window - 1)(_stream_rng);
+    std::swap(_stream_queue[pick], _stream_queue.front());
+    _current_sample = std::move(_stream_queue.front());
+    _stream_queue.pop_front();
+    lock.unlock();
+    _stream_drained.notify_one();
+    return _samples[_current_sample.sample_id];
+}
+
+void WebDatasetSourceReader::start_streaming() {
+    if (!_shuffle_buffer_size)
+        return;
+    _stop_stream = false;
+    _stream_error = nullptr;
+    _stream_thread = std::thread(&WebDatasetSourceReader::stream_tar_files, this, _curr_file_idx);
+}
+
+void WebDatasetSourceReader::stop_streaming() {
+    if (!_stream_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(_stream_mutex);
+        _stop_stream = true;
+    }
+    _stream_drained.notify_all();
+    _stream_thread.join();
+    _stream_queue.clear();
+    _current_sample = StreamedSample();
+}
+
+void WebDatasetSourceReader::stream_tar_files(unsigned file_idx) {
+    try {
+        std::vector<unsigned> run;
+        while (true) {
+            size_t free_slots;
+            {
+                std::unique_lock<std::mutex> lock(_stream_mutex);
+                _stream_drained.wait(lock, [this] { return _stop_stream || _stream_queue.size() < _stream_capacity; });
+                if (_stop_stream)
+                    return;
+                free_slots = _stream_capacity - _stream_queue.size();
+            }
+            // Samples following each other in the same tar file are fetched with a single read, including the other components in between
+            const SampleEntry &first = _samples[_sample_ids[file_idx]];
+            size_t chunk_end = first.offset + first.size;
+            run.assign(1, file_idx);
+            file_idx = next_file_idx(file_idx, _sample_ids.size());
+            while (run.size() < free_slots) {
+                const SampleEntry &next = _samples[_sample_ids[file_idx]];
+                if (next.wds_shard_index != first.wds_shard_index || next.offset < chunk_end || next.offset + next.size - first.offset > STREAM_CHUNK_SIZE)
+                    break;
+                chunk_end = next.offset + next.size;
+                run.push_back(file_idx);
+                file_idx = next_file_idx(file_idx, _sample_ids.size());
+            }
+            size_t chunk_size = chunk_end - first.offset;
+            std::shared_ptr<unsigned char[]> chunk(new unsigned char[chunk_size]);
+            read_tar_file(first.wds_shard_index, chunk.get(), chunk_size, first.offset);
+            {
+                std::lock_guard<std::mutex> lock(_stream_mutex);
+                for (auto idx : run) {
+                    auto sample_id = _sample_ids[idx];
+                    _stream_queue.push_back({sample_id, chunk, _samples[sample_id].offset - first.offset});
+                }
+            }
+            _stream_filled.notify_one();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(_stream_mutex);
+        _stream_error = std::current_exception();
+        _stream_filled.notify_one();
+    }
+}
+
 int WebDatasetSourceReader::close() {
     return release();
 }
 
 WebDatasetSourceReader::~WebDatasetSourceReader() {
+    stop_streaming();
+    for (auto fd : _tar_fds)
+        if (fd >= 0)
+            ::close(fd);
     release();
 }
 
+int WebDatasetSourceReader::tar_file_descriptor(unsigned wds_shard_index) {
+    int &fd = _tar_fds[wds_shard_index];
+    if (fd >= 0) {
+        _open_tar_files.splice(_open_tar_files.begin(), _open_tar_files, _open_tar_position[wds_shard_index]);
+        return fd;
+    }
+    if (_open_tar_files.size() >= _max_open_files) {
+        auto evicted = _open_tar_files.back();
+        ::close(_tar_fds[evicted]);
+        _tar_fds[evicted] = -1;
+        _open_tar_files.pop_back();
+    }
+    if ((fd = ::open(_tar_file_paths[wds_shard_index].c_str(), O_RDONLY)) < 0)
+        THROW("WebDatasetSourceReader: Failed opening the tar file " + _tar_file_paths[wds_shard_index] + " " + strerror(errno));
+    if (_shuffle_buffer_size)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    _open_tar_position[wds_shard_index] = _open_tar_files.insert(_open_tar_files.begin(), wds_shard_index);
+    return fd;
+}
+
+void WebDatasetSourceReader::read_tar_file(unsigned wds_shard_index, unsigned char *buff, size_t size, size_t offset) {
+    int fd = tar_file_descriptor(wds_shard_index);
+    for (size_t done = 0; done < size;) {
+        ssize_t n = pread(fd, buff + done, size - done, offset + done);
+        if (n <= 0)
+            THROW("WebDatasetSourceReader: Error in reading the tar file " + _tar_file_paths[wds_shard_index]);
+        done += n;
+    }
+}
+
 int WebDatasetSourceReader::release() {
     return 0;
 }
 
 void WebDatasetSourceReader::reset() {
-    if (_shuffle)
-        std::random_shuffle(_file_names.begin() + _shard_start_idx_vector[_shard_id],
-                            _file_names.begin() + _shard_start_idx_vector[_shard_id] + actual_shard_size_without_padding());
+    stop_streaming();
+    if (_shuffle && !_shuffle_buffer_size)
+        std::random_shuffle(_sample_ids.begin() + _shard_start_idx_vector[_shard_id],
+                            _sample_ids.begin() + _shard_start_idx_vector[_shard_id] + actual_shard_size_without_padding());
 
     if (_stick_to_shard == false)  // Pick elements from the next shard - hence increment shard_id
         increment_shard_id();      // Should work for both single and multiple shards
@@ -122,231 +244,64 @@ void WebDatasetSourceReader::reset() {
 
     if (_sharding_info.last_batch_policy == RocalBatchPolicy::DROP) {  // Skipping the dropped batch in next epoch
         for (uint i = 0; i < _batch_size; i++)
-            increment_curr_file_idx(_file_names.size());
+            increment_curr_file_idx(_sample_ids.size());
     }
+    start_streaming();
 }
 
 void WebDatasetSourceReader::increment_shard_id() {
     _shard_id = (_shard_id + 1) % _shard_count;
 }
 
-void WebDatasetSourceReader::parse_sample_description(
-    std::vector<SampleDescription>& samples_container,
-    std::vector<ComponentDescription>& components_container,
-    std::ifstream& index_file, const std::string& index_path, int64_t line,
-    int index_version) {
-    samples_container.emplace_back();
-    samples_container.back().components = VectorView<ComponentDescription>(
-        components_container, components_container.size());
-    samples_container.back().line_number = line;
-
-    // Getting the components data
-    std::string components_metadata;
-    std::getline(index_file, components_metadata);
-    std::stringstream components_stream(components_metadata);
-
-    // Reading consecutive components
-    ComponentDescription component;
-    while (components_stream >> component.ext) {
-        if (index_version == create_version_number(1, 0)) {
-            if (!(components_stream >> component.offset >> component.size >>
-                  component.filename)) {
-                THROW( "Could not find all necessary component parameters "
-                      "(offset, size or filename). Every record in the index "
-                      "file should look like: `<ext> <offset> <size> "
-                      "<filename>`." );
-            }
-        } else {
-            if (!(components_stream >> component.offset >> component.size))
-                THROW( "Could not find all necessary component parameters "
-                      "(offset or size). Every record in the index file should "
-                      "look like: `<ext> <offset> <size>`" );
-        }
-
-        if (component.filename.empty())  // Use line number as file number
-            component.filename = std::to_string(line);
-        else {
-            // Find the position of the last period
-            auto last_period_pos = component.filename.find_last_of('.');
-            // If a period is found, truncate everything after it
-            if (last_period_pos != std::string::npos) {
-                component.filename.erase(last_period_pos);
-            }
-        }
-
-        if (!(component.offset % kBlockSize == 0))
-            THROW( "tar offset is not a multiple of tar block size kBlockSize, "
-                  "perhaps the size value is exported before offset?" );
-
-        components_container.emplace_back(std::move(component));
-        samples_container.back().components.num++;
-    }
-
-    if ((!samples_container.back().components.num))
-        THROW("No extensions provided for the sample");
-}
-
-inline int parse_index_version(const string& idx_version_in_str) {
-  const char* c_string_ptr = idx_version_in_str.c_str();
-  assert(*c_string_ptr == 'v');
-  c_string_ptr++;
-  auto major = atoi(c_string_ptr);
-  c_string_ptr = strchr(c_string_ptr, '.');
-  assert(c_string_ptr);
-  c_string_ptr++;
-  auto minor = atoi(c_string_ptr);
-  return create_version_number(major, minor);
-}
-
-void WebDatasetSourceReader::parse_index_files(
-    std::vector<SampleDescription>& samples_container,
-    std::vector<ComponentDescription>& components_container,
-    const std::string& index_path) {
-    std::ifstream index_file(index_path);
-    std::string global_meta;
-    getline(index_file, global_meta);
-    std::stringstream global_meta_stream(global_meta);
-    std::string index_version_str;
-    if (!(global_meta_stream >> index_version_str))
-        THROW("Unsupported version of the index file")
-
-    int index_version = parse_index_version(index_version_str);
-
-    int64_t sample_desc_num_signed;
-    if (!(global_meta_stream >> sample_desc_num_signed))
-        THROW("no sample count found")
-    if (!(sample_desc_num_signed > 0))
-        THROW("sample count must be positive")
-
-    const size_t sample_desc_num = sample_desc_num_signed;
-    samples_container.reserve(samples_container.size() + sample_desc_num);
-    for (size_t sample_index = 0; sample_index < sample_desc_num;
-         sample_index++) {
-        parse_sample_description(samples_container, components_container, index_file,
-                        index_path, sample_index + 1, index_version);
-    }
-}
-
-void WebDatasetSourceReader::parse_tar_files(std::vector<SampleDescription>& samples_vector,
-                                              std::vector<ComponentDescription>& components_vector,
-                                              std::unique_ptr<std::ifstream>& tar_file) {
-    TarArchive tar_archive(std::move(tar_file));
-
-    std::string last_filename;
-    for (; !tar_archive.at_end_of_archive(); tar_archive.advance_to_next_file_in_tar()) {
-        if (tar_archive.get_current_file_type() == TarArchive::ENTRY_FILE) {
-            std::tie(last_filename, std::ignore) = split_name(tar_archive.get_current_file_name());
-            break;
-        }
-    }
-    size_t last_components_size = components_vector.size();
-    for (; !tar_archive.at_end_of_archive(); tar_archive.advance_to_next_file_in_tar()) {
-        if (tar_archive.get_current_file_type() != TarArchive::ENTRY_FILE) {
-            continue;
-        }
-
-        std::string basename, ext;
-        std::tie(basename, ext) = split_name(tar_archive.get_current_file_name());
-        if (basename.empty()) {
-            continue;
-        }
-
-        if (basename != last_filename) {
-            samples_vector.emplace_back();
-            samples_vector.back().components = VectorView<ComponentDescription>(components_vector, last_components_size, components_vector.size() - last_components_size);
-            last_filename = basename;
-            last_components_size = components_vector.size();
-        }
-        components_vector.emplace_back();
-        components_vector.back().size = tar_archive.get_current_file_size();
-        components_vector.back().offset = tar_archive.get_current_archive_offset() + tar_archive.get_current_header_size();
-        components_vector.back().ext = std::move(ext);
-        auto _last_id = basename;
-        auto last_slash_idx = _last_id.find_last_of("\\/");
-        if (std::string::npos != last_slash_idx) {
-            _last_id.erase(0, last_slash_idx + 1);
-        }
-        components_vector.back().filename = _last_id;
-    }
-    samples_vector.emplace_back();
-    samples_vector.back().components = VectorView<ComponentDescription>(components_vector, last_components_size, components_vector.size() - last_components_size);
-
-    tar_file = tar_archive.release_file_stream();
-}
-
 Reader::Status WebDatasetSourceReader::folder_reading() {
     auto ret = Reader::Status::OK;
-    std::string _full_path;
     std::vector<std::string> entry_name_list;
-    if (_index_paths.empty()) { 
-        _folder_path = _path;
-        if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
-            THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _folder_path);
-        _full_path = _folder_path;  
-        while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
-            if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
-                continue;
-            entry_name_list.push_back(entry_name);
-        }
-        std::sort(entry_name_list.begin(), entry_name_list.end());
-        _wds_shards.reserve(entry_name_list.size());
-        // Create n such std-streams for n paths
-        for (auto& path : entry_name_list)
-         {
-            auto file = std::make_unique<std::ifstream>(_path + path, std::ios::binary);
-            if (!file->is_open()) {
-                std::cerr << "Failed to open file: " << _path + path << std::endl;
-            } else {
-                _wds_shards.emplace_back(std::move(file));
-            }
-        }
-    } else {
-        _folder_path = _index_paths;
-        if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
-            THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _folder_path);
-        _full_path = _folder_path;
+    auto list_folder = [this](const std::string &folder_path, std::vector<std::string> &names) {
+        if ((_sub_dir = opendir(folder_path.c_str())) == nullptr)
+            THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + folder_path);
         while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
             if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
                 continue;
-            _index_name_list.push_back(entry_name);
+            names.push_back(_entity->d_name);
         }
-        std::sort(_index_name_list.begin(), _index_name_list.end());
-        // Tar file path
-        if ((_sub_dir = opendir(_path.c_str())) == nullptr)
-            THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _path);
-        std::string _full_path = _path;
-        while ((_entity = readdir(_sub_dir)) != nullptr) {
-            std::string entry_name(_entity->d_name);
-            if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
-                continue;
-            entry_name_list.push_back(entry_name);
-        }
-        std::sort(entry_name_list.begin(), entry_name_list.end());
-        _wds_shards.reserve(entry_name_list.size());
-        // Create n such std-streams for n paths
-        for (auto& path : entry_name_list) {
-            auto file = std::make_unique<std::ifstream>(_path + path, std::ios::binary);
-            if (!file->is_open()) {
-                std::cerr << "Failed to open file: " << _path + path << std::endl;
-            } else {
-                _wds_shards.emplace_back(std::move(file));
-            }
+        closedir(_sub_dir);
+        _sub_dir = nullptr;
+        std::sort(names.begin(), names.end());
+    };
+    _folder_path = _index_paths.empty() ? _path : _index_paths;
+    if (!_index_paths.empty())
+        list_folder(_index_paths, _index_name_list);
+    list_folder(_path, entry_name_list);
+    if (!_index_paths.empty() && _index_name_list.size() < entry_name_list.size())
+        THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Found " + TOSTR(_index_name_list.size()) + " index files for " + TOSTR(entry_name_list.size()) + " tar files");
+    for (auto& path : entry_name_list)
+        _tar_file_paths.push_back(_path + path);
+
+    // The tar headers or index files are parsed concurrently, every tar file is only open while its headers are read
+    struct ParsedTarFile {
+        std::vector<SampleDescription> samples;
+        std::vector<ComponentDescription> components;
+    };
+    std::vector<ParsedTarFile> parsed(entry_name_list.size());
+    {
+        ThreadPool parse_pool(std::min(_num_threads, std::max<size_t>(parsed.size(), 1)));
+        std::vector<std::shared_future<void>> parse_jobs;
+        parse_jobs.reserve(parsed.size());
+        for (unsigned wds_shard_index = 0; wds_shard_index < parsed.size(); ++wds_shard_index) {
+            parse_jobs.push_back(parse_pool.submit([&, wds_shard_index]() {
+                auto& tar_file = parsed[wds_shard_index];
+                if (_index_paths.empty())
+                    parse_tar_file(_tar_file_paths[wds_shard_index], tar_file.samples, tar_file.components);
+                else
+                    parse_index_file(_folder_path + _index_name_list[wds_shard_index], tar_file.samples, tar_file.components);
+            }));
         }
+        for (auto& job : parse_jobs)
+            job.get();
     }
-    std::vector<SampleDescription> unfiltered_samples;
-    std::vector<ComponentDescription> unfiltered_components;
-    
-    for (unsigned wds_shard_index = 0; wds_shard_index < entry_name_list.size(); ++wds_shard_index) {
-            unfiltered_samples.resize(0);
-            unfiltered_components.resize(0);
-            if (_index_paths.size() == 0)
-            parse_tar_files(unfiltered_samples, unfiltered_components, _wds_shards[wds_shard_index]);
-            else
-            parse_index_files(unfiltered_samples, unfiltered_components, _folder_path + _index_name_list[wds_shard_index]);
-            // After parsing add the contents to the map
-        for (auto& sample : unfiltered_samples) {
+    // After parsing add the contents to the sample table, in the order of the tar files
+    for (unsigned wds_shard_index = 0; wds_shard_index < parsed.size(); ++wds_shard_index) {
+        for (auto& sample : parsed[wds_shard_index].samples) {
             for (auto& component : sample.components) {
                 if (!_meta_data_reader || _meta_data_reader->exists(component.filename)) {
                     if (webdataset_record_reader_from_components(component, wds_shard_index) != Reader::Status::OK)
@@ -355,17 +310,20 @@ Reader::Status WebDatasetSourceReader::folder_reading() {
             }
         }
     }
+    if (_samples.empty())
+        THROW("WebDatasetSourceReader ShardID [" + TOSTR(_shard_id) + "] ERROR: No images found in the tar files at " + _path);
 
     size_t padded_samples = ((_shard_size > 0) ? _shard_size : largest_shard_size_without_padding()) % _batch_size;
     _last_batch_padded_size = ((_batch_size > 1) && (padded_samples > 0)) ? (_batch_size - padded_samples) : 0;
 
-    // Pad the _file_names with last element of the shard in the vector when _pad_last_batch_repeated is True
+    // Pad the _sample_ids with last element of the shard in the vector when _pad_last_batch_repeated is True
     if (_pad_last_batch_repeated == true) {
-        update_filenames_with_padding(_file_names, _batch_size);
+        update_filenames_with_padding(_sample_ids, _batch_size);
     }
-    _last_file_name = _file_names[_file_names.size() - 1];
-     compute_start_and_end_idx_of_all_shards();
-    
+    compute_start_and_end_idx_of_all_shards();
+
+    _tar_fds.assign(_tar_file_paths.size(), -1);
+    _open_tar_position.resize(_tar_file_paths.size());
     return ret;
 }
 
@@ -382,21 +340,16 @@ Reader::Status WebDatasetSourceReader::webdataset_record_reader_from_components(
         std::string file_path = _folder_path;
         file_path.append("/");
         file_path.append(component.filename);
-        _file_names.push_back(file_path);
-        _last_file_name = file_path;
-        _file_size.insert(std::pair<std::string, unsigned int>(file_path, component.size));
-        _file_wds_shard_idx_mapping.insert(std::pair<std::string, unsigned int>(file_path, wds_shard_index));
-        _file_offset.insert(std::pair<std::string, off_t>(file_path, component.offset));
+        _sample_ids.push_back(_samples.size());
+        _samples.push_back({std::move(file_path), wds_shard_index, static_cast<size_t>(component.offset), static_cast<size_t>(component.size)});
         _file_count_all_shards++;
     }  // Case for jpg's. - add for more extensions when encoutered
     return ret;
 }
 
-Reader::Status WebDatasetSourceReader::read_web_dataset_at_offset(unsigned char* buff, std::string file_name, uint file_size, uint offset, uint wds_shard_index) {
+Reader::Status WebDatasetSourceReader::read_web_dataset_at_offset(unsigned char* buff, const SampleEntry& sample) {
     auto ret = Reader::Status::OK;
-    auto& current_tar_file_stream = _wds_shards[wds_shard_index];
-    current_tar_file_stream->seekg(offset, std::ios::beg);
-    current_tar_file_stream->read(reinterpret_cast<char*>(buff), file_size);
+    read_tar_file(sample.wds_shard_index, buff, sample.size, sample.offset);
     return ret;
 }
 #endif
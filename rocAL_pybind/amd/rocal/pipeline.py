@@ -52,6 +52,9 @@ class Pipeline(object):
     @param mean (int, optional, default = 0)                                                              Mean value used for the image normalization
     @param std (int, optional, default = 0)                                                               Standard deviation value used for the image normalization
     @param tensor_dtype (int, optional, default = 0)                                                      Tensor datatype used for the pipeline
+    @param deterministic_loader_order (bool, optional, default = False)                                   Whether the batches of the internal shards of a reader are returned in a fixed round robin order instead of the order they complete in
+    @param cpu_affinity (list of int, optional, default = None)                                           CPUs the CPU stages of the pipeline run on, pipelines with the same CPUs share their worker threads
+    @param numa_node (int, optional, default = -1)                                                        Restricts the pipeline to the CPUs of this NUMA node when cpu_affinity is not set
     @param output_memory_type (int, optional, default = 0)                                                Output memory type used for the output tensors
     """
     '''.
@@ -66,13 +69,13 @@ class Pipeline(object):
     def __init__(self, batch_size=-1, num_threads=0, device_id=0, seed=1,
                  exec_pipelined=True, prefetch_queue_depth=2,
                  exec_async=True, bytes_per_sample=0,
-                 rocal_cpu=False, max_streams=-1, default_cuda_stream_priority=0, tensor_layout=types.NCHW, reverse_channels=False, mean=None, std=None, tensor_dtype=types.FLOAT, output_memory_type=None): 
+                 rocal_cpu=False, max_streams=-1, default_cuda_stream_priority=0, tensor_layout=types.NCHW, reverse_channels=False, mean=None, std=None, tensor_dtype=types.FLOAT, output_memory_type=None, deterministic_loader_order=False, cpu_affinity=None, numa_node=-1): 
         if (rocal_cpu):
             self._handle = b.rocalCreate(
-                batch_size, types.CPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype)
+                batch_size, types.CPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype, deterministic_loader_order, cpu_affinity or [], numa_node)
         else:
             self._handle = b.rocalCreate(
-                batch_size, types.GPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype)
+                batch_size, types.GPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype, deterministic_loader_order, cpu_affinity or [], numa_node)
 
         if (b.getStatus(self._handle) == types.OK):
             print("Pipeline has been created succesfully")
@@ -123,6 +126,7 @@ class Pipeline(object):
         self._external_source = None
         self._external_source_mode = None
         self._last_batch_policy = None
+        self._output_buffers = {}
 
     def build(self):
         """!Build the pipeline using rocalVerify call
@@ -159,6 +163,21 @@ class Pipeline(object):
     def set_outputs(self, *output_list):
         b.setOutputs(self._handle, len(output_list), output_list)
 
+    def set_output_buffers(self, output_index, buffers):
+        """!Makes the pipeline write the output at output_index straight into the given tensors, e.g. pinned torch tensors, instead of copying it out after every run
+        One tensor per prefetch queue slot is needed, in host memory for CPU pipelines and device memory for GPU pipelines. Has to be called after set_outputs and before build
+        """
+        buffer_size = min(buffer.element_size() * buffer.nelement() for buffer in buffers)
+        status = b.setOutputBuffers(self._handle, output_index, [ctypes.c_void_p(buffer.data_ptr()) for buffer in buffers], buffer_size)
+        if status != types.OK:
+            raise RuntimeError(b.rocalGetErrorMessage(self._handle))
+        self._output_buffers[output_index] = buffers  # The pipeline writes into them until it is released
+
+    def get_output_buffer_index(self):
+        """!Index of the tensor given to set_output_buffers that holds the batch of the last run, -1 if no batch is ready
+        """
+        return b.getOutputBufferIndex(self._handle)
+
     def __enter__(self):
         Pipeline._current_pipeline = self
         return self
@@ -211,6 +230,22 @@ class Pipeline(object):
     def get_ascii_datas(self):
         return b.getAsciiDatas(self._handle)
 
+    def get_collated_bounding_boxes(self):
+        """!Labels (N) and boxes (N, 4) of all the objects of the batch, and the offsets (batch size + 1) of the objects of each sample in them
+        The arrays share the pipeline memory, the pipeline does not overwrite the batch while they are alive
+        """
+        return b.getCollatedBoundingBoxes(self._handle)
+
+    def get_collated_mask_coordinates(self):
+        """!Polygon coordinates of all the masks of the batch in one array, and the offsets of the coordinates of each sample in it
+        """
+        return b.getCollatedMaskCoordinates(self._handle)
+
+    def get_collated_ascii_datas(self):
+        """!For each component, the bytes of all the samples of the batch in one array and the offsets of each sample in it
+        """
+        return b.getCollatedAsciiDatas(self._handle)
+
     def get_mask_count(self, array):
         return b.getMaskCount(self._handle, array)
 
@@ -259,6 +294,13 @@ class Pipeline(object):
     def get_last_batch_padded_size(self):
         return b.getLastBatchPaddedSize(self._handle)
 
+    def cpu_isa(self):
+        return b.getCpuIsa(self._handle)
+
+    def set_io_depth(self, io_depth):
+        # Has to be called before the readers of the pipeline are defined
+        b.rocalSetIoDepth(self._handle, io_depth)
+
     def run(self):
         """
         It raises StopIteration if data set reached its end.
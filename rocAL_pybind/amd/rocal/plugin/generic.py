@@ -28,6 +28,15 @@ import rocal_pybind as b
 import amd.rocal.types as types
 import ctypes
 
+def pad_collated(values, offsets, max_rows, dtype):
+    """!Scatters the collated per object values of a batch into a (batch size, max_rows, values per object) array padded with zeros
+    """
+    counts = np.diff(offsets)
+    padded = np.zeros((len(counts), max_rows) + values.shape[1:], dtype=dtype)
+    padded[np.arange(max_rows) < counts[:, None]] = values
+    return padded
+
+
 class ROCALGenericIterator(object):
     """!Iterator for processing data
 
@@ -23,9 +23,11 @@
 # @brief File containing iterators to be used with pytorch trainings
 
 import torch
+import torch.utils.dlpack
 import numpy as np
 import rocal_pybind as b
 import amd.rocal.types as types
+from amd.rocal.plugin.generic import pad_collated
 import ctypes
 
 
@@ -41,9 +43,13 @@ class ROCALGenericIterator(object):
         @param display             Whether to display images during processing
         @param device              The device to use for processing
         @param device_id           The ID of the device to use
+        @param zero_copy           Return tensors sharing the rocAL output buffers of a CPU pipeline instead of copies. The pipeline does not overwrite a batch
+                                   until its tensors are released, so only a few batches, less than the prefetch queue depth, can be held at once
     """
 
-    def __init__(self, pipeline, tensor_layout=types.NCHW, reverse_channels=False, multiplier=[1.0, 1.0, 1.0], offset=[0.0, 0.0, 0.0], tensor_dtype=types.FLOAT, device="cpu", device_id=0, display=False):
+    def __init__(self, pipeline, tensor_layout=types.NCHW, reverse_channels=False, multiplier=[1.0, 1.0, 1.0], offset=[0.0, 0.0, 0.0], tensor_dtype=types.FLOAT, device="cpu", device_id=0, display=False, zero_copy=False):
+        if zero_copy and (device != "cpu" or not pipeline._rocal_cpu):
+            raise ValueError("zero_copy is only supported with CPU pipelines and device='cpu'")
         self.loader = pipeline
         self.tensor_format = tensor_layout
         self.multiplier = multiplier
@@ -56,6 +62,7 @@ class ROCALGenericIterator(object):
         self.labels_size = ((self.batch_size * self.loader._num_classes)
                             if self.loader._one_hot_encoding else self.batch_size)
         self.output_list = None
+        self.zero_copy = zero_copy
         self.output_memory_type = self.loader._output_memory_type
         self.iterator_length = b.getRemainingImages(self.loader._handle)
         self.display = display
@@ -115,7 +122,12 @@ class ROCALGenericIterator(object):
         else:
             self.output_tensor_list = self.loader.get_output_tensors()
 
-        if self.output_list is None:
+        if self.zero_copy:
+            # The tensors hold a lease on the rocAL output buffers, which are written again once the tensors are released
+            self.output_list = [torch.utils.dlpack.from_dlpack(output.__dlpack__(self.device_id)) for output in self.output_tensor_list]
+            if not hasattr(self, "labels_tensor"):
+                self.labels_tensor = torch.empty(self.labels_size, dtype=getattr(torch, "int32"))
+        elif self.output_list is None:
             # Output list used to store pipeline outputs - can support multiple augmentation outputs
             self.output_list = []
             for i in range(len(self.output_tensor_list)):
@@ -143,48 +155,23 @@ class ROCALGenericIterator(object):
                     self.output_list[i].data_ptr()), self.output_memory_type)
 
         if ((self.loader._name == "Caffe2ReaderDetection") or (self.loader._name == "CaffeReaderDetection")):
-            self.bbox_list = []  # Empty list for bboxes
-            self.labels_list = []  # Empty list of labels
-
-            # 1D labels array in a batch
-            self.labels = self.loader.get_bounding_box_labels()
-            # 1D bboxes array in a batch
-            self.bboxes = self.loader.get_bounding_box_cords()
+            # Labels and bboxes of all the objects in the batch, with the offsets of the objects of each image
+            # They share the pipeline memory, only the padded copies are kept past this call so the pipeline can reuse it
+            labels, bboxes, offsets = self.loader.get_collated_bounding_boxes()
             # Image sizes of a batch
             self.img_size = np.zeros((self.batch_size * 2), dtype="int32")
             self.loader.get_img_sizes(self.img_size)
 
-            for i in range(self.batch_size):
-                self.label_2d_numpy = np.reshape(
-                    self.labels[i], (-1, 1)).tolist()
-                self.bb_2d_numpy = np.reshape(self.bboxes[i], (-1, 4)).tolist()
-
-                self.labels_list.append(self.label_2d_numpy)
-                self.bbox_list.append(self.bb_2d_numpy)
-
-                if self.display:
+            if self.display:
+                for i in range(self.batch_size):
+                    self.bb_2d_numpy = bboxes[offsets[i]:offsets[i + 1]].tolist()
                     for output in self.output_list:
                         img = output
                         draw_patches(img[i], i, self.bb_2d_numpy)
 
-            max_cols = max([len(row)
-                           for batch in self.bbox_list for row in batch])
-            max_rows = max([len(batch) for batch in self.bbox_list])
-            self.bb_padded = [
-                batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.bbox_list]
-            self.bb_padded = torch.FloatTensor(
-                [row + [0] * (max_cols - len(row)) for batch in self.bb_padded for row in batch])
-            self.bb_padded = self.bb_padded.view(-1, max_rows, max_cols)
-
-            max_cols1 = max([len(row)
-                            for batch in self.labels_list for row in batch])
-            max_rows1 = max([len(batch) for batch in self.labels_list])
-            self.labels_padded = [
-                batch + [[0] * (max_cols1)] * (max_rows1 - len(batch)) for batch in self.labels_list]
-            self.labels_padded = torch.LongTensor(
-                [row + [0] * (max_cols1 - len(row)) for batch in self.labels_padded for row in batch])
-            self.labels_padded = self.labels_padded.view(
-                -1, max_rows1, max_cols1)
+            max_rows = int(np.diff(offsets).max())
+            self.bb_padded = torch.from_numpy(pad_collated(bboxes, offsets, max_rows, np.float32))
+            self.labels_padded = torch.from_numpy(pad_collated(labels.reshape(-1, 1), offsets, max_rows, np.int64))
 
             # Check if last batch policy is partial and only return the valid images in last batch
             if (self.last_batch_policy is (types.LAST_BATCH_PARTIAL)) and b.getRemainingImages(self.loader._handle) <= 0:
@@ -288,10 +275,12 @@ class ROCALClassificationIterator(ROCALGenericIterator):
                  last_batch_padded=False,
                  display=False,
                  device="cpu",
-                 device_id=0):
+                 device_id=0,
+                 zero_copy=False):
         pipe = pipelines
         super(ROCALClassificationIterator, self).__init__(pipe, tensor_layout=pipe._tensor_layout, tensor_dtype=pipe._tensor_dtype,
-                                                          multiplier=pipe._multiplier, offset=pipe._offset, display=display, device=device, device_id=device_id)
+                                                          multiplier=pipe._multiplier, offset=pipe._offset, display=display, device=device, device_id=device_id,
+                                                          zero_copy=zero_copy)
 
 
 class ROCALAudioIterator(object):
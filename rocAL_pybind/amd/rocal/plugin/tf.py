@@ -26,6 +26,7 @@ import numpy as np
 import ctypes
 import rocal_pybind as b
 import amd.rocal.types as types
+from amd.rocal.plugin.generic import pad_collated
 import tensorflow as tf
 
 class ROCALGenericImageIterator(object):
@@ -115,47 +116,17 @@ class ROCALGenericIteratorDetection(object):
             self.output_list.append(self.output)
 
         if self.loader._name == "TFRecordReaderDetection":
-            self.bbox_list = []
-            self.label_list = []
-            # 1D labels array in a batch
-            self.labels = self.loader.get_bounding_box_labels()
-            # 1D bboxes array in a batch
-            self.bboxes = self.loader.get_bounding_box_cords()
+            # Labels and bboxes of all the objects in the batch, with the offsets of the objects of each image
+            # They share the pipeline memory, only the padded copies are kept past this call so the pipeline can reuse it
+            labels, bboxes, offsets = self.loader.get_collated_bounding_boxes()
             # 1D Image sizes array of image in a batch
             self.img_size = np.zeros((self.bs * 2), dtype="int32")
-            self.num_bboxes_list = []
             self.loader.get_img_sizes(self.img_size)
-            for i in range(self.bs):
-                self.label_2d_numpy = np.reshape(
-                    self.labels[i], (-1, 1)).tolist()
-                self.bb_2d_numpy = np.reshape(self.bboxes[i], (-1, 4)).tolist()
-                self.num_bboxes_list.append(len(self.bboxes[i]))
-                self.label_list.append(self.label_2d_numpy)
-                self.bbox_list.append(self.bb_2d_numpy)
-
-            self.target = self.bbox_list
-            self.target1 = self.label_list
-            max_cols = max([len(row)
-                           for batch in self.target for row in batch])
-            # max_rows = max([len(batch) for batch in self.target])
             max_rows = 100
-            bb_padded = [
-                batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.target]
-            bb_padded_1 = [row + [0] * (max_cols - len(row))
-                           for batch in bb_padded for row in batch]
-            arr = np.asarray(bb_padded_1)
-            self.res = np.reshape(arr, (-1, max_rows, max_cols))
-            max_cols = max([len(row)
-                           for batch in self.target1 for row in batch])
-            # max_rows = max([len(batch) for batch in self.target1])
-            max_rows = 100
-            lab_padded = [
-                batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.target1]
-            lab_padded_1 = [row + [0] * (max_cols - len(row))
-                            for batch in lab_padded for row in batch]
-            labarr = np.asarray(lab_padded_1)
-            self.l = np.reshape(labarr, (-1, max_rows, max_cols))
-            self.num_bboxes_arr = np.array(self.num_bboxes_list)
+            self.res = pad_collated(bboxes, offsets, max_rows, np.float64)
+            self.l = pad_collated(labels.reshape(-1, 1), offsets, max_rows, np.int64)
+            # Number of bbox coordinates of each image
+            self.num_bboxes_arr = np.diff(offsets) * 4
 
             return self.output_list, self.res, self.l, self.num_bboxes_arr
         elif (self.loader._name == "TFRecordReaderClassification"):
@@ -82,6 +82,17 @@ from rocal_pybind.types import DECODER_AUDIO_GENERIC
 from rocal_pybind.types import DECODER_VIDEO_ROCDECODE
 from rocal_pybind.types import DECODER_ROCJPEG
 
+#     RocalDecodeQuality
+from rocal_pybind.types import DECODE_QUALITY_ACCURATE
+from rocal_pybind.types import DECODE_QUALITY_FAST
+from rocal_pybind.types import DECODE_QUALITY_FAST_SCALED
+
+#     RocalCpuIsa
+from rocal_pybind.types import CPU_ISA_SCALAR
+from rocal_pybind.types import CPU_ISA_SSE42
+from rocal_pybind.types import CPU_ISA_AVX2
+from rocal_pybind.types import CPU_ISA_AVX512
+
 #     RocalResizeScalingMode
 from rocal_pybind.types import SCALING_MODE_DEFAULT
 from rocal_pybind.types import SCALING_MODE_STRETCH
@@ -173,6 +184,15 @@ _known_types = {
     DECODER_VIDEO_ROCDECODE: ("DECODER_VIDEO_ROCDECODE", DECODER_VIDEO_ROCDECODE),
     DECODER_ROCJPEG: ("DECODER_ROCJPEG", DECODER_ROCJPEG),
 
+    DECODE_QUALITY_ACCURATE: ("DECODE_QUALITY_ACCURATE", DECODE_QUALITY_ACCURATE),
+    DECODE_QUALITY_FAST: ("DECODE_QUALITY_FAST", DECODE_QUALITY_FAST),
+    DECODE_QUALITY_FAST_SCALED: ("DECODE_QUALITY_FAST_SCALED", DECODE_QUALITY_FAST_SCALED),
+
+    CPU_ISA_SCALAR: ("CPU_ISA_SCALAR", CPU_ISA_SCALAR),
+    CPU_ISA_SSE42: ("CPU_ISA_SSE42", CPU_ISA_SSE42),
+    CPU_ISA_AVX2: ("CPU_ISA_AVX2", CPU_ISA_AVX2),
+    CPU_ISA_AVX512: ("CPU_ISA_AVX512", CPU_ISA_AVX512),
+
     NEAREST_NEIGHBOR_INTERPOLATION: ("NEAREST_NEIGHBOR_INTERPOLATION", NEAREST_NEIGHBOR_INTERPOLATION),
     LINEAR_INTERPOLATION: ("LINEAR_INTERPOLATION", LINEAR_INTERPOLATION),
     CUBIC_INTERPOLATION: ("CUBIC_INTERPOLATION", CUBIC_INTERPOLATION),
@@ -101,6 +101,23 @@ py::object wrapper_copy_to_tensor(RocalContext context, py::object p,
     return py::cast<py::none>(Py_None);
 }
 
+// Wraps a collated metadata buffer in a numpy array of entries of entry_length values, and copies the sample offsets next to it
+// The array shares the pipeline memory, it holds a lease on the batch so the pipeline does not overwrite it while the array is alive
+template <typename T>
+py::tuple collated_meta_data(RocalContext context, unsigned meta_data_buffer, size_t entry_length) {
+    RocalCollatedMetaData collated;
+    if (rocalGetCollatedMetaData(context, meta_data_buffer, &collated) != ROCAL_OK)
+        throw std::runtime_error(rocalGetErrorMessage(context));
+    auto lease = new std::shared_ptr<void>(rocalGetOutputTensors(context)->at(0)->lease());
+    py::capsule owner(lease, [](void *ptr) { delete static_cast<std::shared_ptr<void> *>(ptr); });
+    std::vector<py::ssize_t> shape = {static_cast<py::ssize_t>(collated.offsets[collated.batch_size])};
+    if (entry_length > 1)
+        shape.push_back(static_cast<py::ssize_t>(entry_length));
+    py::array_t<T> data(shape, static_cast<T *>(collated.data), owner);
+    py::array_t<size_t> offsets(collated.batch_size + 1, collated.offsets);
+    return py::make_tuple(data, offsets);
+}
+
 py::object wrapperRocalExternalSourceFeedInput(
     RocalContext context, std::vector<std::string> input_images_names,
     py::array &labels, py::list arrays,
@@ -294,19 +311,38 @@ PYBIND11_MODULE(rocal_pybind, m) {
     m.def("rocalVerify", &rocalVerify);
     m.def("rocalRun", &rocalRun, py::return_value_policy::reference);
     m.def("rocalRelease", &rocalRelease, py::return_value_policy::reference);
+    m.def("rocalSetCpuCoreBudget", &rocalSetCpuCoreBudget, "Sets the number of CPU worker threads shared by the pipelines running on the same CPUs");
+    m.def("rocalSetIoDepth", &rocalSetIoDepth, "Sets the number of file reads the image loaders created afterwards keep in flight");
     // rocal_api_types.h
     py::class_<TimingInfo>(m, "TimingInfo")
         .def_readwrite("load_time", &TimingInfo::load_time)
         .def_readwrite("decode_time", &TimingInfo::decode_time)
         .def_readwrite("process_time", &TimingInfo::process_time)
-        .def_readwrite("transfer_time", &TimingInfo::transfer_time);
+        .def_readwrite("transfer_time", &TimingInfo::transfer_time)
+        .def_readwrite("compressed_buffer_size", &TimingInfo::compressed_buffer_size)
+        .def_readwrite("peak_rss", &TimingInfo::peak_rss)
+        .def_readwrite("file_read_time", &TimingInfo::file_read_time)
+        .def_readwrite("read_wait_time", &TimingInfo::read_wait_time)
+        .def_readwrite("box_encode_stall_time", &TimingInfo::box_encode_stall_time)
+        .def_readwrite("box_encode_idle_time", &TimingInfo::box_encode_idle_time)
+        .def_readwrite("box_encode_max_occupancy", &TimingInfo::box_encode_max_occupancy)
+        .def_readwrite("box_encode_occupancy_sum", &TimingInfo::box_encode_occupancy_sum)
+        .def_readwrite("box_encode_batches", &TimingInfo::box_encode_batches);
     py::class_<rocalTensor>(m, "rocalTensor")
 #if ENABLE_DLPACK
             .def(
                 "__dlpack__",
                 [](rocalTensor *rocal_tensor, int device_id) {
+                    // The export is a view of the pipeline buffer, which keeps every sample in a max shape slot
+                    if (rocal_tensor->is_packed())
+                        throw std::runtime_error("A packed tensor cannot be exported through DLPack, use copy_data with sample_offsets instead");
                     DLManagedTensor *dmtensor = new DLManagedTensor;
+                    // Holds the lease on the pipeline buffer, the pipeline does not overwrite it until the consumer deletes the tensor
+                    dmtensor->manager_ctx = nullptr;
+                    dmtensor->dl_tensor.shape = nullptr;
+                    dmtensor->dl_tensor.strides = nullptr;
                     dmtensor->deleter = [](DLManagedTensor *self) {
+                        delete static_cast<std::shared_ptr<void> *>(self->manager_ctx);
                         delete[] self->dl_tensor.shape;
                         delete[] self->dl_tensor.strides;
                         delete self;
@@ -323,6 +359,8 @@ PYBIND11_MODULE(rocal_pybind, m) {
                         // Set up data
                         dtensor.data = rocal_tensor->buffer();
                         dtensor.byte_offset = 0;
+                        if (auto lease = rocal_tensor->lease())
+                            dmtensor->manager_ctx = new std::shared_ptr<void>(std::move(lease));
 
                         // Set up shape
                         dtensor.shape = new int64_t[dtensor.ndim];
@@ -341,9 +379,11 @@ PYBIND11_MODULE(rocal_pybind, m) {
                             dtensor.strides[i] = static_cast<int64_t>(rocal_strides[i]) / rocal_tensor->data_type_size();
                         }
                     } catch (...) {
+                        delete static_cast<std::shared_ptr<void> *>(dmtensor->manager_ctx);
                         delete[] dmtensor->dl_tensor.shape;
                         delete[] dmtensor->dl_tensor.strides;
                         delete dmtensor;
+                        throw;
                     }
 
                     py::capsule cap(dmtensor, "dltensor", [](PyObject *ptr) {
@@ -528,6 +568,29 @@ PYBIND11_MODULE(rocal_pybind, m) {
             R"code(
                 Copies the ROI data to numpy arrays.
                 )code")
+        .def(
+            "set_packed", [](rocalTensor &output_tensor, bool packed) {
+                output_tensor.set_packed(packed);
+            },
+            R"code(
+                Copies the samples back to back using their ROI size instead of the max shape.
+                Only the copy_data destination is packed, the buffers of the pipeline keep the max shape.
+                __dlpack__ raises an error on a packed tensor.
+                )code")
+        .def(
+            "is_packed", [](rocalTensor &output_tensor) {
+                return output_tensor.is_packed();
+            },
+            R"code(
+                Returns true if the samples are copied out packed.
+                )code")
+        .def(
+            "sample_offsets", [](rocalTensor &output_tensor) {
+                return output_tensor.sample_offsets();
+            },
+            R"code(
+                Returns the byte offset of each sample in the copied data, followed by the size of the batch.
+                )code")
         .def(
             "copy_data", [](rocalTensor &output_tensor, py::object p, RocalOutputMemType external_mem_type) {
                 auto ptr = ctypes_void_ptr(p);
@@ -729,6 +792,17 @@ py::class_<rocalListOfTensorList>(m, "rocalListOfTensorList")
         .value("DECODER_VIDEO_ROCDECODE", ROCAL_DECODER_VIDEO_ROCDECODE)
         .value("DECODER_ROCJPEG", ROCAL_DECODER_ROCJPEG)
         .export_values();
+    py::enum_<RocalDecodeQuality>(types_m, "RocalDecodeQuality", "Rocal Decode Quality")
+        .value("DECODE_QUALITY_ACCURATE", ROCAL_DECODE_QUALITY_ACCURATE)
+        .value("DECODE_QUALITY_FAST", ROCAL_DECODE_QUALITY_FAST)
+        .value("DECODE_QUALITY_FAST_SCALED", ROCAL_DECODE_QUALITY_FAST_SCALED)
+        .export_values();
+    py::enum_<RocalCpuIsa>(types_m, "RocalCpuIsa", "Rocal CPU Instruction Set Level")
+        .value("CPU_ISA_SCALAR", ROCAL_CPU_ISA_SCALAR)
+        .value("CPU_ISA_SSE42", ROCAL_CPU_ISA_SSE42)
+        .value("CPU_ISA_AVX2", ROCAL_CPU_ISA_AVX2)
+        .value("CPU_ISA_AVX512", ROCAL_CPU_ISA_AVX512)
+        .export_values();
     py::enum_<RocalExternalSourceMode>(types_m, "RocalExternalSourceMode", "Rocal Extrernal Source Mode")
         .value("EXTSOURCE_FNAME", ROCAL_EXTSOURCE_FNAME)
         .value("EXTSOURCE_RAW_COMPRESSED", ROCAL_EXTSOURCE_RAW_COMPRESSED)
@@ -814,6 +888,7 @@ py::class_<rocalListOfTensorList>(m, "rocalListOfTensorList")
     m.def("labelReader", &rocalCreateLabelReader, py::return_value_policy::reference);
     m.def("cocoReader", &rocalCreateCOCOReader, py::return_value_policy::reference);
     m.def("getLastBatchPaddedSize", &rocalGetLastBatchPaddedSize, py::return_value_policy::reference);
+    m.def("getCpuIsa", &rocalGetCpuIsa);
     // rocal_api_meta_data.h
     m.def("randomBBoxCrop", &rocalRandomBBoxCrop);
     m.def("boxEncoder", &rocalBoxEncoder);
@@ -858,6 +933,13 @@ py::class_<rocalListOfTensorList>(m, "rocalListOfTensorList")
             list.append(output_tensor_list->at(i));
         return list;
     });
+    m.def("setOutputBuffers", [](RocalContext context, unsigned int output_index, py::list buffers, size_t buffer_size) {
+        std::vector<void *> buffer_ptrs;
+        for (auto buffer : buffers)
+            buffer_ptrs.push_back(ctypes_void_ptr(py::reinterpret_borrow<py::object>(buffer)));
+        return rocalSetOutputBuffers(context, output_index, buffer_ptrs, buffer_size);
+    });
+    m.def("getOutputBufferIndex", &rocalGetOutputBufferIndex);
     m.def("getBoundingBoxCount", &rocalGetBoundingBoxCount);
     m.def("getImageLabels", [](RocalContext context) {
         rocalTensorList *labels = rocalGetImageLabels(context);
@@ -903,6 +985,21 @@ py::class_<rocalListOfTensorList>(m, "rocalListOfTensorList")
         }
         return boxes_list;
     });
+    m.def("getCollatedBoundingBoxes", [](RocalContext context) {
+        auto labels = collated_meta_data<int>(context, ROCAL_META_DATA_LABELS, 1);
+        auto boxes = collated_meta_data<float>(context, ROCAL_META_DATA_BOUNDING_BOXES, 4);
+        return py::make_tuple(labels[0], boxes[0], labels[1]);
+    });
+    m.def("getCollatedMaskCoordinates", [](RocalContext context) {
+        return collated_meta_data<float>(context, ROCAL_META_DATA_MASKS, 1);
+    });
+    m.def("getCollatedAsciiDatas", [](RocalContext context) {
+        py::list component_list;
+        rocalListOfTensorList *ascii_sample_contents = rocalGetAsciiDatas(context);
+        for (uint ext = 0; ext < ascii_sample_contents->size(); ext++)
+            component_list.append(collated_meta_data<uint8_t>(context, ext, 1));
+        return component_list;
+    });
     m.def("getAsciiDatas", [](RocalContext context) {
         rocalListOfTensorList *ascii_sample_contents = rocalGetAsciiDatas(context);
         py::list ext_componenet_list;
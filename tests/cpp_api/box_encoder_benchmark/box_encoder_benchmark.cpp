@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "rocal_api.h"
+
+using namespace std::chrono;
+
+// Generates ltrb anchors in pixels of a square image of side image_size, one square per location per scale and aspect ratio
+static void add_anchors(std::vector<float> &anchors, float image_size, int feature_size, const std::vector<float> &scales, const std::vector<float> &aspect_ratios) {
+    float step = image_size / feature_size;
+    for (int y = 0; y < feature_size; y++) {
+        for (int x = 0; x < feature_size; x++) {
+            float xc = (x + 0.5f) * step, yc = (y + 0.5f) * step;
+            for (auto scale : scales) {
+                for (auto ratio : aspect_ratios) {
+                    float w = scale * std::sqrt(ratio), h = scale / std::sqrt(ratio);
+                    anchors.insert(anchors.end(), {xc - w * 0.5f, yc - h * 0.5f, xc + w * 0.5f, yc + h * 0.5f});
+                }
+            }
+        }
+    }
+}
+
+// 8732 anchors of SSD300
+static std::vector<float> ssd_anchors() {
+    std::vector<float> anchors;
+    const int feature_sizes[] = {38, 19, 10, 5, 3, 1};
+    const float sizes[] = {21, 45, 99, 153, 207, 261, 315};
+    for (int level = 0; level < 6; level++) {
+        float size = sizes[level], next_size = std::sqrt(sizes[level] * sizes[level + 1]);
+        std::vector<float> ratios = (level == 0 || level >= 4) ? std::vector<float>{2.f, 0.5f} : std::vector<float>{2.f, 0.5f, 3.f, 1.f / 3.f};
+        add_anchors(anchors, 300, feature_sizes[level], {size, next_size}, {1.f});
+        add_anchors(anchors, 300, feature_sizes[level], {size}, ratios);
+    }
+    return anchors;
+}
+
+// 120087 anchors of RetinaNet at 800x800
+static std::vector<float> retinanet_anchors() {
+    std::vector<float> anchors;
+    const int feature_sizes[] = {100, 50, 25, 13, 7};
+    for (int level = 0; level < 5; level++) {
+        float size = 32.f * (1 << level);
+        add_anchors(anchors, 800, feature_sizes[level], {size, size * std::pow(2.f, 1.f / 3), size * std::pow(2.f, 2.f / 3)}, {0.5f, 1.f, 2.f});
+    }
+    return anchors;
+}
+
+// Runs the COCO pipeline for the given number of batches and returns the average time per batch in us
+static double run_pipeline(const char *path, const char *json_path, int batch_size, int iterations, int image_size, int encode_mode, std::vector<float> &anchors) {
+    bool is_box_encoder = (encode_mode == 1), is_box_iou_matcher = (encode_mode == 2);
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not create the Rocal context\n";
+        return -1;
+    }
+    rocalCreateCOCOReader(handle, json_path, true, false, true, is_box_encoder, false, false, is_box_iou_matcher);
+    RocalTensor input = rocalJpegCOCOFileSource(handle, path, json_path, ROCAL_COLOR_RGB24, 1, false, false, true);
+    rocalResize(handle, input, image_size, image_size, true);
+    if (is_box_encoder) {
+        std::vector<float> means = {0.0, 0.0, 0.0, 0.0};
+        std::vector<float> stds = {1.0, 1.0, 1.0, 1.0};
+        rocalBoxEncoder(handle, anchors, 0.5, means, stds);
+    } else if (is_box_iou_matcher) {
+        rocalBoxIouMatcher(handle, anchors, 0.5, 0.4, true);
+    }
+    rocalVerify(handle);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not verify the augmentation graph " << rocalGetErrorMessage(handle) << std::endl;
+        rocalRelease(handle);
+        return -1;
+    }
+    // The first batch pays for the pipeline warm up
+    if (rocalRun(handle) != 0) {
+        rocalRelease(handle);
+        return -1;
+    }
+    high_resolution_clock::time_point t_start = high_resolution_clock::now();
+    int batches = 0;
+    for (; batches < iterations; batches++) {
+        if (rocalRun(handle) != 0)
+            break;
+        if (is_box_encoder)
+            rocalGetEncodedBoxesAndLables(handle, anchors.size() / 4);
+        else if (is_box_iou_matcher)
+            rocalGetMatchedIndices(handle);
+    }
+    auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - t_start).count();
+    rocalRelease(handle);
+    return batches ? static_cast<double>(elapsed) / batches : -1;
+}
+
+// Measures the cost of the CPU box encoder / IoU matcher by running the same COCO pipeline with and without it
+int main(int argc, const char **argv) {
+    // check command-line usage
+    const int MIN_ARG_COUNT = 3;
+    if (argc < MIN_ARG_COUNT) {
+        printf("Usage: box_encoder_benchmark <image_dataset_folder [required]> <coco_json_file [required]> <anchors ssd=0/retinanet=1> <box_encoder=0/iou_matcher=1> <batch_size> <iterations>\n");
+        return -1;
+    }
+    int argIdx = 1;
+    const char *path = argv[argIdx++];
+    const char *json_path = argv[argIdx++];
+    bool retinanet = false;
+    bool iou_matcher = false;
+    int batch_size = 32;
+    int iterations = 100;
+
+    if (argc > argIdx)
+        retinanet = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        iou_matcher = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        batch_size = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        iterations = atoi(argv[argIdx++]);
+
+    std::vector<float> anchors = retinanet ? retinanet_anchors() : ssd_anchors();
+    int image_size = retinanet ? 800 : 300;
+    std::cout << (retinanet ? "RetinaNet " : "SSD ") << anchors.size() / 4 << " anchors, " << (iou_matcher ? "IoU matcher" : "box encoder")
+              << ", batch size " << batch_size << ", " << iterations << " batches" << std::endl;
+
+    double baseline_time = run_pipeline(path, json_path, batch_size, iterations, image_size, 0, anchors);
+    double encode_time = run_pipeline(path, json_path, batch_size, iterations, image_size, iou_matcher ? 2 : 1, anchors);
+    if (baseline_time < 0 || encode_time < 0) {
+        std::cout << "Benchmark failed" << std::endl;
+        return -1;
+    }
+    std::cout << "Batch time without encoding (us) " << baseline_time << std::endl;
+    std::cout << "Batch time with encoding    (us) " << encode_time << std::endl;
+    std::cout << "Encoding overhead per batch (us) " << encode_time - baseline_time << " (" << 100.0 * (encode_time - baseline_time) / baseline_time << "%)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+MIT License
+
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "rocal_api.h"
+
+using namespace std::chrono;
+
+struct BenchmarkResult {
+    int images = 0;
+    double elapsed_us = 0;
+    unsigned long long decode_us = 0;
+    std::vector<unsigned char> last_batch;  // Resized output of the last batch, used to compare the decode modes
+};
+
+// Runs one epoch of a JPEG decode + resize pipeline with the given decode quality
+static int run_pipeline(const char *path, int width, int height, int batch_size, int shards, RocalDecodeQuality decode_quality, BenchmarkResult &result) {
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not create the Rocal context\n";
+        return -1;
+    }
+
+    RocalTensor input = rocalJpegFileSource(handle, path, ROCAL_COLOR_RGB24, shards, false, false, false, ROCAL_USE_MOST_FREQUENT_SIZE, 0, 0,
+                                            ROCAL_DECODER_TJPEG, RocalShardingInfo(), decode_quality);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "JPEG source could not initialize : " << rocalGetErrorMessage(handle) << std::endl;
+        rocalRelease(handle);
+        return -1;
+    }
+    rocalResize(handle, input, width, height, true);
+    rocalVerify(handle);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not verify the augmentation graph " << rocalGetErrorMessage(handle);
+        rocalRelease(handle);
+        return -1;
+    }
+
+    while (!rocalIsEmpty(handle)) {
+        high_resolution_clock::time_point t_start = high_resolution_clock::now();
+        if (rocalRun(handle) != 0)
+            break;
+        result.elapsed_us += duration_cast<microseconds>(high_resolution_clock::now() - t_start).count();
+        result.images += batch_size;
+        // The batches prefetched while the graph is built are decoded before the resize size is known, keep the last one
+        auto output = rocalGetOutputTensors(handle)->at(0);
+        result.last_batch.resize(output->data_size());
+        output->copy_data(result.last_batch.data());
+    }
+    result.decode_us = rocalGetTimingInfo(handle).decode_time;
+    rocalRelease(handle);
+    return 0;
+}
+
+static double psnr(const std::vector<unsigned char> &reference, const std::vector<unsigned char> &image) {
+    if (reference.size() != image.size() || reference.empty())
+        return 0;
+    double squared_error = 0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        double diff = static_cast<double>(reference[i]) - image[i];
+        squared_error += diff * diff;
+    }
+    if (squared_error == 0)
+        return INFINITY;
+    return 10 * std::log10(255.0 * 255.0 * reference.size() / squared_error);
+}
+
+// Compares the decode throughput of the TurboJPEG decode quality modes on a decode + resize pipeline,
+// and the PSNR of the resized images of the fast modes against the accurate one
+int main(int argc, const char **argv) {
+    // check command-line usage
+    const int MIN_ARG_COUNT = 2;
+    if (argc < MIN_ARG_COUNT) {
+        printf("Usage: decode_benchmark <image_dataset_folder [required]> <resize_width> <resize_height> <batch_size> <shard_count>\n");
+        return -1;
+    }
+    int argIdx = 1;
+    const char *path = argv[argIdx++];
+    int width = 224;
+    int height = 224;
+    int batch_size = 16;
+    int shards = 1;
+
+    if (argc > argIdx)
+        width = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        height = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        batch_size = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        shards = atoi(argv[argIdx++]);
+
+    const std::vector<std::pair<const char *, RocalDecodeQuality>> modes = {
+        {"ACCURATE   ", ROCAL_DECODE_QUALITY_ACCURATE},
+        {"FAST       ", ROCAL_DECODE_QUALITY_FAST},
+        {"FAST_SCALED", ROCAL_DECODE_QUALITY_FAST_SCALED}};
+    std::vector<BenchmarkResult> results(modes.size());
+    for (size_t i = 0; i < modes.size(); i++) {
+        if (run_pipeline(path, width, height, batch_size, shards, modes[i].second, results[i]) != 0)
+            return -1;
+        if (results[i].images == 0) {
+            std::cout << "No images were loaded from " << path << std::endl;
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < modes.size(); i++) {
+        auto &result = results[i];
+        std::cout << modes[i].first << " " << result.images << " images " << result.images * 1000000.0 / result.elapsed_us << " images/s"
+                  << " decode time " << result.decode_us << " us";
+        // The batches come from the first shard done with its decode, their order is only fixed with a single shard
+        if (i > 0 && shards == 1)
+            std::cout << " PSNR " << psnr(results[0].last_batch, result.last_batch) << " dB";
+        std::cout << std::endl;
+    }
+    return 0;
+}
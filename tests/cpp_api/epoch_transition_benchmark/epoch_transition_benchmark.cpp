@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "rocal_api.h"
+
+using namespace std::chrono;
+
+// Measures the latency of the epoch boundary: the time from the end of an epoch, through rocalResetLoaders,
+// until the first batch of the next epoch is returned by rocalRun
+int main(int argc, const char **argv) {
+    // check command-line usage
+    const int MIN_ARG_COUNT = 2;
+    if (argc < MIN_ARG_COUNT) {
+        printf("Usage: epoch_transition_benchmark <image_dataset_folder [required]> <batch_size> <epochs> <processing_device=1/cpu=0> <shard_count>\n");
+        return -1;
+    }
+    int argIdx = 1;
+    const char *path = argv[argIdx++];
+    int batch_size = 4;
+    int epochs = 10;
+    bool processing_device = 0;
+    int shards = 1;
+
+    if (argc > argIdx)
+        batch_size = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        epochs = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        processing_device = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        shards = atoi(argv[argIdx++]);
+
+    auto handle = rocalCreate(batch_size, processing_device ? RocalProcessMode::ROCAL_PROCESS_GPU : RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not create the Rocal context\n";
+        return -1;
+    }
+
+    RocalTensor input = rocalJpegFileSource(handle, path, ROCAL_COLOR_RGB24, shards, false, false, false, ROCAL_USE_USER_GIVEN_SIZE_RESTRICTED, 224, 224);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "JPEG source could not initialize : " << rocalGetErrorMessage(handle) << std::endl;
+        return -1;
+    }
+    rocalResize(handle, input, 224, 224, true);
+    rocalVerify(handle);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not verify the augmentation graph " << rocalGetErrorMessage(handle);
+        return -1;
+    }
+
+    std::vector<double> drain_latency, reset_latency, first_batch_latency;
+    high_resolution_clock::time_point t_start = high_resolution_clock::now();
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        int batches = 0;
+        high_resolution_clock::time_point t_last_batch;
+        high_resolution_clock::time_point t_epoch = high_resolution_clock::now();
+        while (!rocalIsEmpty(handle)) {
+            if (rocalRun(handle) != 0)
+                break;
+            t_last_batch = high_resolution_clock::now();
+            if (batches++ == 0 && epoch > 0)
+                first_batch_latency.push_back(duration_cast<microseconds>(t_last_batch - t_epoch).count());
+        }
+        // Time from the last batch of the epoch until the pipeline reports it is empty
+        high_resolution_clock::time_point t_empty = high_resolution_clock::now();
+        if (batches)
+            drain_latency.push_back(duration_cast<microseconds>(t_empty - t_last_batch).count());
+        rocalResetLoaders(handle);
+        reset_latency.push_back(duration_cast<microseconds>(high_resolution_clock::now() - t_empty).count());
+        std::cout << "Epoch " << epoch << ": " << batches << " batches" << std::endl;
+    }
+    auto total = duration_cast<microseconds>(high_resolution_clock::now() - t_start).count();
+
+    auto report = [](const char *name, std::vector<double> &samples) {
+        if (samples.empty())
+            return;
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (auto sample : samples)
+            sum += sample;
+        std::cout << name << " (us) min " << samples.front() << " avg " << sum / samples.size()
+                  << " p50 " << samples[samples.size() / 2] << " max " << samples.back() << std::endl;
+    };
+    report("End of epoch drain  ", drain_latency);
+    report("rocalResetLoaders   ", reset_latency);
+    report("First batch of epoch", first_batch_latency);
+    std::cout << "Total Elapsed Time " << total / 1000000 << " sec " << total % 1000000 << " us " << std::endl;
+
+    rocalRelease(handle);
+    return 0;
+}
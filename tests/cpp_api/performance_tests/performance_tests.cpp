@@ -294,6 +294,8 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
     std::cout << "Decode   time " << rocal_timing.decode_time << std::endl;
     std::cout << "Process  time " << rocal_timing.process_time << std::endl;
     std::cout << "Transfer time " << rocal_timing.transfer_time << std::endl;
+    std::cout << "Compressed buffers " << rocal_timing.compressed_buffer_size / (1024 * 1024) << " MB" << std::endl;
+    std::cout << "Peak RSS " << rocal_timing.peak_rss / (1024 * 1024) << " MB" << std::endl;
     std::cout << "Total Elapsed Time " << dur / 1000000 << " sec " << dur % 1000000 << " us " << std::endl;
 
     rocalRelease(handle);
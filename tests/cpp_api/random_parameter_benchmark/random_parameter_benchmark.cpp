@@ -0,0 +1,167 @@
+/*
+MIT License
+
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "rocal_api.h"
+
+using namespace std::chrono;
+
+// The images are resized to a small size so that the processing cost does not hide the cost of the parameter renewals
+#define IMAGE_SIZE 32
+
+// Builds a pipeline chaining param_count brightness augmentations, with random or fixed alpha and beta
+static RocalContext build_pipeline(const char *path, int batch_size, unsigned param_count, bool random_params, unsigned seed) {
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not create the Rocal context\n";
+        return nullptr;
+    }
+    rocalSetSeed(seed);
+    RocalTensor image = rocalJpegFileSource(handle, path, ROCAL_COLOR_RGB24, 1, false, false, true, ROCAL_USE_USER_GIVEN_SIZE_RESTRICTED, 224, 224);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "JPEG source could not initialize : " << rocalGetErrorMessage(handle) << std::endl;
+        rocalRelease(handle);
+        return nullptr;
+    }
+    image = rocalResize(handle, image, IMAGE_SIZE, IMAGE_SIZE, false);
+    for (unsigned p = 0; p < param_count; p++) {
+        RocalFloatParam alpha = random_params ? rocalCreateFloatUniformRand(0.9f, 1.1f) : rocalCreateFloatParameter(1.f);
+        RocalFloatParam beta = random_params ? rocalCreateFloatUniformRand(-2.f, 2.f) : rocalCreateFloatParameter(0.f);
+        image = rocalBrightness(handle, image, p == param_count - 1, alpha, beta);
+    }
+    rocalVerify(handle);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not verify the augmentation graph " << rocalGetErrorMessage(handle);
+        rocalRelease(handle);
+        return nullptr;
+    }
+    return handle;
+}
+
+// Runs the first batch of a pipeline and returns its output images
+static bool first_batch(const char *path, int batch_size, unsigned param_count, unsigned seed, std::vector<unsigned char> &images) {
+    auto handle = build_pipeline(path, batch_size, param_count, true, seed);
+    if (!handle)
+        return false;
+    bool ok = rocalRun(handle) == 0;
+    if (ok) {
+        auto output = rocalGetOutputTensors(handle)->at(0);
+        images.resize(output->data_size());
+        output->copy_data(images.data());
+    }
+    rocalRelease(handle);
+    return ok;
+}
+
+// Checks that a seed gives the same images on every pipeline, and that the values of a sample do not depend on the batch size
+static bool check_reproducibility(const char *path, int batch_size, unsigned param_count, unsigned seed) {
+    std::vector<unsigned char> images, same_seed, other_seed, half_batch;
+    if (!first_batch(path, batch_size, param_count, seed, images) ||
+        !first_batch(path, batch_size, param_count, seed, same_seed) ||
+        !first_batch(path, batch_size, param_count, seed + 1, other_seed) ||
+        !first_batch(path, batch_size / 2, param_count, seed, half_batch)) {
+        std::cerr << "Could not run the reproducibility pipelines\n";
+        return false;
+    }
+    if (images != same_seed) {
+        std::cerr << "Same seed gives different images\n";
+        return false;
+    }
+    if (images == other_seed) {
+        std::cerr << "Different seeds give the same images\n";
+        return false;
+    }
+    if (std::memcmp(images.data(), half_batch.data(), half_batch.size()) != 0) {
+        std::cerr << "The images depend on the batch size\n";
+        return false;
+    }
+    return true;
+}
+
+// Average time of a batch, the loader loops over the images
+static double time_batches(RocalContext handle, unsigned iterations) {
+    auto start_time = high_resolution_clock::now();
+    for (unsigned it = 0; it < iterations; it++) {
+        if (rocalRun(handle) != 0)
+            break;
+    }
+    return static_cast<double>(duration_cast<microseconds>(high_resolution_clock::now() - start_time).count()) / iterations;
+}
+
+// Measures the cost of renewing the random augmentation parameters of every batch, by timing the same pipeline with random and with fixed parameters
+int main(int argc, const char **argv) {
+    // check command-line usage
+    const int MIN_ARG_COUNT = 2;
+    if (argc < MIN_ARG_COUNT) {
+        printf("Usage: random_parameter_benchmark <image_dataset_folder [required]> <batch_size> <parameter_count> <iterations>\n");
+        return -1;
+    }
+    int argIdx = 1;
+    const char *path = argv[argIdx++];
+    int batch_size = 8;
+    unsigned param_count = 24;
+    unsigned iterations = 100;
+
+    if (argc > argIdx)
+        batch_size = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        param_count = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        iterations = atoi(argv[argIdx++]);
+
+    if (batch_size < 2 || param_count == 0 || iterations == 0) {
+        std::cout << "The batch size has to be at least 2, the parameter count and iterations at least 1\n";
+        return -1;
+    }
+
+    if (!check_reproducibility(path, batch_size, param_count, 42)) {
+        std::cerr << "Reproducibility check failed\n";
+        return -1;
+    }
+    std::cout << "Reproducibility check passed\n";
+
+    auto random_handle = build_pipeline(path, batch_size, param_count, true, 42);
+    auto fixed_handle = build_pipeline(path, batch_size, param_count, false, 42);
+    if (!random_handle || !fixed_handle)
+        return -1;
+    double random_time = time_batches(random_handle, iterations);
+    double fixed_time = time_batches(fixed_handle, iterations);
+    rocalRelease(random_handle);
+    rocalRelease(fixed_handle);
+
+    std::cout << "Batch size " << batch_size << ", " << 2 * param_count << " parameters, " << iterations << " iterations\n";
+    std::cout << "Random parameters : " << random_time << " us per batch\n";
+    std::cout << "Fixed parameters  : " << fixed_time << " us per batch\n";
+    std::cout << "Renewal cost      : " << random_time - fixed_time << " us per batch\n";
+    return 0;
+}
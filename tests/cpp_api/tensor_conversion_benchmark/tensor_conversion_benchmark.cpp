@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "rocal_api.h"
+
+using namespace std::chrono;
+
+struct Conversion {
+    const char *name;
+    RocalTensorLayout layout;
+    RocalTensorOutputType data_type;
+    bool reverse_channels;
+    size_t elem_size;
+    double elapsed_us = 0;
+    int images = 0;
+};
+
+// Runs one epoch of a JPEG decode + resize pipeline and converts every batch with each of the conversions
+static int run_pipeline(const char *path, int width, int height, int batch_size, std::vector<Conversion> &conversions) {
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not create the Rocal context\n";
+        return -1;
+    }
+
+    RocalTensor input = rocalJpegFileSource(handle, path, ROCAL_COLOR_RGB24, 1, false, false);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "JPEG source could not initialize : " << rocalGetErrorMessage(handle) << std::endl;
+        rocalRelease(handle);
+        return -1;
+    }
+    rocalResize(handle, input, width, height, true);
+    rocalVerify(handle);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cout << "Could not verify the augmentation graph " << rocalGetErrorMessage(handle);
+        rocalRelease(handle);
+        return -1;
+    }
+
+    // Sized for the largest output, FP32 values of 3 channel images
+    std::vector<unsigned char> output(static_cast<size_t>(batch_size) * width * height * 3 * sizeof(float));
+    while (!rocalIsEmpty(handle)) {
+        if (rocalRun(handle) != 0)
+            break;
+        for (auto &conversion : conversions) {
+            high_resolution_clock::time_point t_start = high_resolution_clock::now();
+            if (rocalToTensor(handle, output.data(), conversion.layout, conversion.data_type, 1 / 255.0f, 1 / 255.0f, 1 / 255.0f, -0.5f, -0.5f, -0.5f,
+                              conversion.reverse_channels, ROCAL_MEMCPY_HOST) != ROCAL_OK) {
+                std::cout << "rocalToTensor failed for " << conversion.name << " : " << rocalGetErrorMessage(handle) << std::endl;
+                rocalRelease(handle);
+                return -1;
+            }
+            conversion.elapsed_us += duration_cast<nanoseconds>(high_resolution_clock::now() - t_start).count() / 1000.0;
+            conversion.images += batch_size;
+        }
+    }
+    rocalRelease(handle);
+    return 0;
+}
+
+// Measures the host conversion of the output images to FP32/FP16 tensors for each layout, data type and batch size
+int main(int argc, const char **argv) {
+    // check command-line usage
+    const int MIN_ARG_COUNT = 2;
+    if (argc < MIN_ARG_COUNT) {
+        printf("Usage: tensor_conversion_benchmark <image_dataset_folder [required]> <resize_width> <resize_height> <max_batch_size>\n");
+        return -1;
+    }
+    int argIdx = 1;
+    const char *path = argv[argIdx++];
+    int width = 224;
+    int height = 224;
+    int max_batch_size = 64;
+
+    if (argc > argIdx)
+        width = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        height = atoi(argv[argIdx++]);
+
+    if (argc > argIdx)
+        max_batch_size = atoi(argv[argIdx++]);
+
+    const char *isa_names[] = {"scalar", "sse4.2", "avx2", "avx512"};
+    std::cout << "CPU kernels: " << isa_names[rocalGetCpuIsa(nullptr)] << std::endl;
+    for (int batch_size = 1; batch_size <= max_batch_size; batch_size *= 2) {
+        std::vector<Conversion> conversions = {
+            {"NHWC FP32        ", ROCAL_NHWC, ROCAL_FP32, false, sizeof(float)},
+            {"NHWC FP32 reverse", ROCAL_NHWC, ROCAL_FP32, true, sizeof(float)},
+            {"NHWC FP16        ", ROCAL_NHWC, ROCAL_FP16, false, sizeof(uint16_t)},
+            {"NHWC FP16 reverse", ROCAL_NHWC, ROCAL_FP16, true, sizeof(uint16_t)},
+            {"NCHW FP32        ", ROCAL_NCHW, ROCAL_FP32, false, sizeof(float)},
+            {"NCHW FP32 reverse", ROCAL_NCHW, ROCAL_FP32, true, sizeof(float)},
+            {"NCHW FP16        ", ROCAL_NCHW, ROCAL_FP16, false, sizeof(uint16_t)},
+            {"NCHW FP16 reverse", ROCAL_NCHW, ROCAL_FP16, true, sizeof(uint16_t)}};
+        if (run_pipeline(path, width, height, batch_size, conversions) != 0)
+            return -1;
+        if (conversions[0].images == 0) {
+            std::cout << "No images were loaded from " << path << std::endl;
+            return -1;
+        }
+        for (auto &conversion : conversions) {
+            double output_bytes = static_cast<double>(conversion.images) * width * height * 3 * conversion.elem_size;
+            std::cout << "batch " << batch_size << " " << conversion.name << " " << conversion.elapsed_us / conversion.images << " us/image "
+                      << output_bytes / (conversion.elapsed_us * 1000) << " GB/s" << std::endl;
+        }
+    }
+    return 0;
+}